@@ -0,0 +1,402 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include <jmespath/jmespath.h>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace jp = jmespath;
+
+namespace {
+
+/**
+ * @brief Describes a single benchmark case.
+ */
+struct Benchmark
+{
+    /**
+     * @brief The name of the benchmark which is displayed in the results.
+     */
+    std::string name;
+    /**
+     * @brief The JMESPath expression which gets evaluated.
+     */
+    std::string expression;
+    /**
+     * @brief Creates the document on which the @ref expression is evaluated.
+     */
+    std::function<jp::Json()> document;
+    /**
+     * @brief Whether the logic operators of the expression are ordered
+     * adaptively.
+     */
+    bool adaptiveLogicOrder = false;
+    /**
+     * @brief Whether the expression is optimized.
+     */
+    bool optimized = true;
+    /**
+     * @brief The expression which selects the array that gets indexed before
+     * the evaluation, or an empty string if nothing is indexed.
+     */
+    std::string indexedArray;
+    /**
+     * @brief The key expression of the index of the @ref indexedArray.
+     */
+    std::string indexKey;
+};
+
+/**
+ * @brief Creates an array of @a count objects with an increasing id and
+ * price field.
+ * @param[in] count The number of items in the array.
+ * @return Returns an object with the array stored under the items key.
+ */
+jp::Json makeItems(size_t count)
+{
+    jp::Json items(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        items.push_back({{"id", i},
+                         {"name", "item" + std::to_string(i)},
+                         {"price", i % 100}});
+    }
+    return {{"items", std::move(items)}};
+}
+
+/**
+ * @brief Creates an array of @a count increasing numbers.
+ * @param[in] count The number of items in the array.
+ * @return Returns an object with the array stored under the numbers key.
+ */
+jp::Json makeNumbers(size_t count)
+{
+    jp::Json numbers(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        numbers.push_back(i);
+    }
+    return {{"numbers", std::move(numbers)}};
+}
+
+/**
+ * @brief Creates an array of @a count floating point numbers and an array of
+ * their string representations.
+ * @param[in] count The number of items in the arrays.
+ * @return Returns an object with the arrays stored under the numbers and
+ * strings keys.
+ */
+jp::Json makeMeasurements(size_t count)
+{
+    jp::Json numbers(jp::Json::value_t::array);
+    jp::Json strings(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        const double value = i * 0.731 + 0.1;
+        numbers.push_back(value);
+        strings.push_back(std::to_string(value));
+    }
+    return {{"numbers", std::move(numbers)}, {"strings", std::move(strings)}};
+}
+
+/**
+ * @brief Creates @a count configuration objects with @a width keys each,
+ * where every object overrides half of the keys of the previous one.
+ * @param[in] count The number of configuration objects.
+ * @param[in] width The number of keys in each object.
+ * @return Returns an object with the objects stored under the configs key.
+ */
+jp::Json makeConfigs(size_t count, size_t width)
+{
+    jp::Json configs(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        jp::Json config(jp::Json::value_t::object);
+        for (size_t j = 0; j < width; ++j)
+        {
+            config["key" + std::to_string(i * width / 2 + j)] = i;
+        }
+        configs.push_back(std::move(config));
+    }
+    return {{"configs", std::move(configs)}};
+}
+
+/**
+ * @brief Creates a nested settings object with @a count keys.
+ * @param[in] count The number of keys.
+ * @return Returns an object with the keys stored under the
+ * config.settings.values path.
+ */
+jp::Json makeSettings(size_t count)
+{
+    jp::Json values(jp::Json::value_t::object);
+    for (size_t i = 0; i < count; ++i)
+    {
+        values["key" + std::to_string(i)] = i;
+    }
+    return {{"config", {{"settings", {{"values", std::move(values)}}}}}};
+}
+
+/**
+ * @brief Creates a multiselect hash expression with @a count keys, like the
+ * ones generated by tools, where every key selects a value from the same
+ * nested object.
+ * @param[in] count The number of keys.
+ * @return Returns the text of the expression.
+ */
+std::string makeSettingsSelection(size_t count)
+{
+    std::string expression{"{"};
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (i > 0)
+        {
+            expression += ", ";
+        }
+        expression += "k" + std::to_string(i)
+            + ": config.settings.values.key" + std::to_string(i);
+    }
+    return expression + "}";
+}
+
+/**
+ * @brief Creates an array of @a count deployment manifests, where the image of
+ * the first container is nested seven levels deep.
+ * @param[in] count The number of items in the array.
+ * @return Returns an object with the array stored under the items key.
+ */
+jp::Json makeManifests(size_t count)
+{
+    jp::Json items(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        jp::Json containers {
+            {{"name", "app"}, {"image", "app:" + std::to_string(i)}},
+            {{"name", "sidecar"}, {"image", "proxy:1.0"}}};
+        jp::Json podSpec {{"containers", std::move(containers)},
+                          {"restartPolicy", "Always"}};
+        jp::Json podTemplate {{"metadata", {{"labels", {{"app", "app"}}}}},
+                              {"spec", std::move(podSpec)}};
+        items.push_back({{"kind", "Deployment"},
+                         {"spec", {{"replicas", i % 5},
+                                   {"template", std::move(podTemplate)}}}});
+    }
+    return {{"items", std::move(items)}};
+}
+
+/**
+ * @brief Creates an array of @a count log records with a message field, where
+ * every tenth message contains non ASCII characters.
+ * @param[in] count The number of items in the array.
+ * @return Returns an object with the array stored under the records key.
+ */
+jp::Json makeRecords(size_t count)
+{
+    jp::Json records(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        std::string message = (i % 2 ? "GET /api/items/" : "POST /api/users/")
+            + std::to_string(i)
+            + (i % 10 ? " completed in 12ms"
+                      : " \xc3\xa9" "chec \xe2\x80\x94" " error");
+        records.push_back({{"message", std::move(message)}});
+    }
+    return {{"records", std::move(records)}};
+}
+
+/**
+ * @brief Evaluates the @a benchmark for at least the given @a duration and
+ * prints the average time of a single evaluation.
+ * @param[in] benchmark The benchmark that should be evaluated.
+ * @param[in] duration The minimal duration of the measurement.
+ */
+void run(const Benchmark& benchmark,
+         std::chrono::milliseconds duration = std::chrono::milliseconds{500})
+{
+    using Clock = std::chrono::steady_clock;
+    const jp::Json document = benchmark.document();
+    std::unique_ptr<jp::DocumentIndex> index;
+    if (!benchmark.indexedArray.empty())
+    {
+        index = std::make_unique<jp::DocumentIndex>(
+                    document, benchmark.indexedArray, benchmark.indexKey);
+    }
+    jp::setAdaptiveLogicOrderEnabled(benchmark.adaptiveLogicOrder);
+    jp::setOptimizerEnabled(benchmark.optimized);
+    const jp::Expression expression{benchmark.expression};
+    jp::setOptimizerEnabled(true);
+    jp::setAdaptiveLogicOrderEnabled(false);
+    jp::Json result;
+    size_t iterations = 0;
+    auto begin = Clock::now();
+    auto end = begin;
+    // evaluate the expression repeatedly until the requested duration elapses
+    while (end - begin < duration)
+    {
+        result = jp::search(expression, document);
+        ++iterations;
+        end = Clock::now();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                end - begin);
+    // shorten the long generated expressions
+    std::string text = benchmark.expression;
+    if (text.size() > 80)
+    {
+        text = text.substr(0, 77) + "...";
+    }
+    std::cout << std::left << std::setw(40) << benchmark.name
+              << std::right << std::setw(14)
+              << elapsed.count() / iterations << " ns/op  "
+              << text << std::endl;
+}
+} // anonymous namespace
+
+int main()
+{
+    const std::vector<Benchmark> benchmarks {
+        {"filter (materialized)", "items[?price == `5`]",
+         std::bind(makeItems, 100000)},
+        {"filter first match", "items[?price == `5`] | [0]",
+         std::bind(makeItems, 100000)},
+        {"projection first item", "items[*].name | [0]",
+         std::bind(makeItems, 100000)},
+        {"projection item in parens", "(items[*].name)[10]",
+         std::bind(makeItems, 100000)},
+        {"contains on projection", "contains(items[*].id, `5`)",
+         std::bind(makeItems, 100000)},
+        {"contains an object", "contains(items, items[-1])",
+         std::bind(makeItems, 100000)},
+        {"filter by object equality",
+         "items[?@ == `{\"id\": 5, \"name\": \"item5\", \"price\": 5}`]",
+         std::bind(makeItems, 100000)},
+        {"length of filter", "length(items[?price > `50`])",
+         std::bind(makeItems, 100000)},
+        {"not_null fallback chain",
+         "not_null(items[0].name, items[*].name, items[?price > `50`])",
+         std::bind(makeItems, 100000)},
+        {"existence check with any", "any(items, &price == `5`)",
+         std::bind(makeItems, 100000)},
+        {"unique", "unique(items[*].price)",
+         std::bind(makeItems, 100000)},
+        {"group_by", "group_by(items, &name)",
+         std::bind(makeItems, 100000)},
+        {"top_k_by", "top_k_by(items, &price, `10`)",
+         std::bind(makeItems, 100000)},
+        {"sort_by and slice", "sort_by(items, &price)[-10:]",
+         std::bind(makeItems, 100000)},
+        {"string length", "map(&length(message), records)",
+         std::bind(makeRecords, 100000)},
+        {"string contains", "records[?contains(message, 'error')]",
+         std::bind(makeRecords, 100000)},
+        {"string starts_with", "records[?starts_with(message, 'GET')]",
+         std::bind(makeRecords, 100000)},
+        {"string ends_with", "records[?ends_with(message, 'ms')]",
+         std::bind(makeRecords, 100000)},
+        {"string join", "join(', ', records[*].message)",
+         std::bind(makeRecords, 100000)},
+        {"regex in filter", "records[?matches(message, '^GET .* error$')]",
+         std::bind(makeRecords, 100000)},
+        {"regex extract", "records[*].regex_extract(message, '/([0-9]+) ')",
+         std::bind(makeRecords, 100000)},
+        {"to_string of numbers", "map(&to_string(@), numbers)",
+         std::bind(makeMeasurements, 100000)},
+        {"to_number of strings", "map(&to_number(@), strings)",
+         std::bind(makeMeasurements, 100000)},
+        {"let binding reused twice",
+         "let $v = items[?price > `50`] in {items: $v, count: length($v)}",
+         std::bind(makeItems, 100000)},
+        {"generated selection of 100 keys", makeSettingsSelection(100),
+         std::bind(makeSettings, 100)},
+        {"deep path in projection",
+         "items[*].spec.template.spec.containers[0].image",
+         std::bind(makeManifests, 100000)},
+        {"function call in filter", "items[?starts_with(name, 'x')]",
+         std::bind(makeItems, 100000)},
+        {"expensive first operand",
+         "items[?[name, id] != [id, name] && price == `5`]",
+         std::bind(makeItems, 100000)},
+        {"expensive first operand (adaptive)",
+         "items[?[name, id] != [id, name] && price == `5`]",
+         std::bind(makeItems, 100000), true},
+        {"columnar filter", "items[?price > `50`]",
+         std::bind(makeItems, 1000000)},
+        {"columnar filter (unoptimized)", "items[?price > `50`]",
+         std::bind(makeItems, 1000000), false, false},
+        {"columnar filter of strings", "items[?name == 'item5']",
+         std::bind(makeItems, 1000000)},
+        {"columnar filter of strings (unoptimized)", "items[?name == 'item5']",
+         std::bind(makeItems, 1000000), false, false},
+        {"columnar conjunction",
+         "items[?price > `10` && price < `20` && id != `7`]",
+         std::bind(makeItems, 1000000)},
+        {"columnar conjunction (unoptimized)",
+         "items[?price > `10` && price < `20` && id != `7`]",
+         std::bind(makeItems, 1000000), false, false},
+        {"equality filter", "items[?id == `500000`]",
+         std::bind(makeItems, 1000000)},
+        {"equality filter (indexed)", "items[?id == `500000`]",
+         std::bind(makeItems, 1000000), false, true, "items", "id"},
+        {"equality filter of strings (indexed)", "items[?name == 'item5']",
+         std::bind(makeItems, 1000000), false, true, "items", "name"},
+        {"multiselect hash projection",
+         "items[*].{id: id, name: name, price: price}",
+         std::bind(makeItems, 100000)},
+        {"multiselect list projection", "items[*].[id, name, price]",
+         std::bind(makeItems, 100000)},
+        {"merge wide objects",
+         "merge(configs[0], configs[1], configs[2], configs[3])",
+         std::bind(makeConfigs, 4, 5000)},
+        {"slice with step", "numbers[::2]",
+         std::bind(makeNumbers, 10000000)},
+        {"negative index", "numbers[-1]",
+         std::bind(makeNumbers, 10000000)},
+        {"equality of shared arrays", "numbers == numbers",
+         std::bind(makeNumbers, 10000000)},
+        {"slice of the last items", "numbers[-100:]",
+         std::bind(makeNumbers, 10000000)},
+        {"sum of integers", "sum(numbers)",
+         std::bind(makeNumbers, 10000000)},
+        {"average of integers", "avg(numbers)",
+         std::bind(makeNumbers, 10000000)},
+        {"max of integers", "max(numbers)",
+         std::bind(makeNumbers, 10000000)},
+        {"sort of integers", "sort(reverse(numbers))",
+         std::bind(makeNumbers, 1000000)},
+        {"reverse", "reverse(numbers)",
+         std::bind(makeNumbers, 10000000)}
+    };
+    for (const auto& benchmark: benchmarks)
+    {
+        run(benchmark);
+    }
+    return 0;
+}
@@ -0,0 +1,214 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/stringkernels.h"
+#include <jmespath/jmespath.h>
+#include <boost/algorithm/string.hpp>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <vector>
+
+namespace jp = jmespath;
+namespace alg = boost::algorithm;
+
+namespace {
+
+/**
+ * @brief Describes a single string function benchmark case, which compares a
+ * string kernel with the generic algorithm used before.
+ */
+struct Benchmark
+{
+    /**
+     * @brief The name of the benchmark which is displayed in the results.
+     */
+    std::string name;
+    /**
+     * @brief Evaluates the string kernel on all the strings.
+     */
+    std::function<size_t(const jp::Json&)> kernel;
+    /**
+     * @brief Evaluates the generic algorithm on all the strings.
+     */
+    std::function<size_t(const jp::Json&)> generic;
+};
+
+/**
+ * @brief Creates an array of @a count log messages, where every tenth
+ * message contains non ASCII characters.
+ * @param[in] count The number of items in the array.
+ * @return Returns the array of messages.
+ */
+jp::Json makeMessages(size_t count)
+{
+    jp::Json messages(jp::Json::value_t::array);
+    for (size_t i = 0; i < count; ++i)
+    {
+        messages.push_back((i % 2 ? "GET /api/items/" : "POST /api/users/")
+            + std::to_string(i)
+            + (i % 10 ? " completed in 12ms"
+                      : " \xc3\xa9" "chec \xe2\x80\x94" " error"));
+    }
+    return messages;
+}
+
+/**
+ * @brief Measures the average time of evaluating the @a function on the
+ * @a messages.
+ * @param[in] function The function that should be evaluated.
+ * @param[in] messages The array of messages.
+ * @return Returns the average time of a single evaluation in nanoseconds.
+ */
+long long measure(const std::function<size_t(const jp::Json&)>& function,
+                  const jp::Json& messages)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto duration = std::chrono::milliseconds{500};
+    size_t iterations = 0;
+    // accumulate the results so that the evaluation can't be optimized away
+    volatile size_t checksum = 0;
+    auto begin = Clock::now();
+    auto end = begin;
+    // evaluate the function repeatedly until the requested duration elapses
+    while (end - begin < duration)
+    {
+        checksum = checksum + function(messages);
+        ++iterations;
+        end = Clock::now();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                end - begin);
+    return elapsed.count() / static_cast<long long>(iterations);
+}
+
+/**
+ * @brief Returns the number of @a messages for which the @a predicate is
+ * true.
+ */
+template <typename Predicate>
+size_t countIf(const jp::Json& messages, Predicate predicate)
+{
+    size_t count = 0;
+    for (const auto& message: messages)
+    {
+        if (predicate(message.get_ref<const jp::String&>()))
+        {
+            ++count;
+        }
+    }
+    return count;
+}
+} // anonymous namespace
+
+int main()
+{
+    using namespace jp::interpreter;
+    const jp::String needle = "error";
+    const jp::String prefix = "GET";
+    const jp::String suffix = "ms";
+    const std::vector<Benchmark> benchmarks {
+        {"length",
+         [](const jp::Json& messages) {
+            size_t result = 0;
+            for (const auto& message: messages)
+            {
+                result += codePointCount(message.get_ref<const jp::String&>());
+            }
+            return result;
+         },
+         [](const jp::Json& messages) {
+            size_t result = 0;
+            for (const auto& message: messages)
+            {
+                const auto& string = message.get_ref<const jp::String&>();
+                result += static_cast<size_t>(std::distance(
+                    jp::UnicodeIteratorAdaptor(std::begin(string)),
+                    jp::UnicodeIteratorAdaptor(std::end(string))));
+            }
+            return result;
+         }},
+        {"contains",
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return containsString(message, needle);
+            });
+         },
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return alg::contains(message, needle);
+            });
+         }},
+        {"starts_with",
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return startsWithString(message, prefix);
+            });
+         },
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return alg::starts_with(message, prefix);
+            });
+         }},
+        {"ends_with",
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return endsWithString(message, suffix);
+            });
+         },
+         [&](const jp::Json& messages) {
+            return countIf(messages, [&](const jp::String& message) {
+                return alg::ends_with(message, suffix);
+            });
+         }},
+        {"join",
+         [](const jp::Json& messages) {
+            return joinStrings(messages, ", ").size();
+         },
+         [](const jp::Json& messages) {
+            std::vector<jp::String> strings;
+            for (const auto& message: messages)
+            {
+                strings.push_back(message.get<jp::String>());
+            }
+            return alg::join(strings, ", ").size();
+         }}
+    };
+    const jp::Json messages = makeMessages(1000000);
+    for (const auto& benchmark: benchmarks)
+    {
+        auto kernelTime = measure(benchmark.kernel, messages);
+        auto genericTime = measure(benchmark.generic, messages);
+        std::cout << std::left << std::setw(16) << benchmark.name
+                  << std::right << std::setw(14) << kernelTime
+                  << " ns/op kernel" << std::setw(14) << genericTime
+                  << " ns/op generic" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef DOCUMENTINDEX_H
+#define DOCUMENTINDEX_H
+#include <cstddef>
+#include <memory>
+#include <jmespath/types.h>
+#include <jmespath/exceptions.h>
+
+namespace jmespath { namespace interpreter {
+
+class HashIndex;
+}}
+
+namespace jmespath {
+
+/**
+ * @ingroup public
+ * @brief The DocumentIndex class is a hash index over the items of an array
+ * of a document, which lets the filters comparing a key of the items with a
+ * constant, like `users[?id == 'u123']`, select the matching items without
+ * evaluating the condition on every item.
+ *
+ * The index maps the results of the key expression evaluated on the items to
+ * the positions of the items. While the object exists, the filters which are
+ * evaluated on the indexed array and whose condition is `key == constant` or
+ * `constant == key`, where `key` is the same expression as the index's key
+ * expression and `constant` is a literal or a raw string, look up the items
+ * in the index. The results are the same as without the index.
+ *
+ * The index is tied to the container of the indexed array, so it's also used
+ * for the copies of the document, but it's no longer used once items get
+ * inserted into or erased from the array, or the array gets resized or
+ * reassigned. Modifying the items in place, through references to them,
+ * isn't detected, so build a new index after modifying the items.
+ * @note The index keeps the indexed array alive until it's destroyed. The
+ * index is only used for the expressions parsed with the same optimizer
+ * setting as its key expression.
+ */
+class DocumentIndex
+{
+public:
+    /**
+     * @brief Constructs a DocumentIndex object by evaluating the
+     * @a keyExpression on the items of the array selected by the
+     * @a arrayPath in the @a document.
+     * @param[in] document The indexed JSON document.
+     * @param[in] arrayPath The JMESPath expression which selects the indexed
+     * array, which has to be part of the @a document, like `users`.
+     * @param[in] keyExpression The JMESPath expression which is evaluated on
+     * the items, like `id`.
+     * @throws SyntaxError When the syntax of the expressions is invalid.
+     * @throws InvalidAgrument If the @a arrayPath doesn't select an array of
+     * the @a document, or if the @a keyExpression calls custom functions.
+     * @note The exceptions thrown while evaluating the expressions are
+     * propagated as well.
+     */
+    DocumentIndex(const Json& document,
+                  const String& arrayPath,
+                  const String& keyExpression);
+    /**
+     * @brief Move-constructs a DocumentIndex object by taking over the index
+     * of @a other.
+     * @param[in] other The object whose index should be moved.
+     */
+    DocumentIndex(DocumentIndex&& other);
+    /**
+     * @brief Move-assigns @a other to this object, removing the index of
+     * this object.
+     * @param[in] other The object whose index should be moved.
+     * @return Reference to this object.
+     */
+    DocumentIndex& operator=(DocumentIndex&& other);
+    DocumentIndex(const DocumentIndex&) = delete;
+    DocumentIndex& operator=(const DocumentIndex&) = delete;
+    /**
+     * @brief Destroys the DocumentIndex object, after which the searches no
+     * longer use its index.
+     */
+    ~DocumentIndex();
+    /**
+     * @brief Returns the expression which selected the indexed array.
+     * @return The expression of the array.
+     */
+    const String& arrayPath() const;
+    /**
+     * @brief Returns the expression which is evaluated on the items.
+     * @return The key expression.
+     */
+    const String& keyExpression() const;
+    /**
+     * @brief Checks whether the indexed array wasn't modified since the
+     * index was built.
+     * @return Returns true if the index is still used by the searches,
+     * otherwise false.
+     */
+    bool isValid() const;
+    /**
+     * @brief Returns the number of distinct keys of the items.
+     * @return The number of distinct keys.
+     */
+    std::size_t keyCount() const;
+
+private:
+    /**
+     * @brief The expression which selected the indexed array.
+     */
+    String m_arrayPath;
+    /**
+     * @brief The expression which is evaluated on the items.
+     */
+    String m_keyExpression;
+    /**
+     * @brief The registered index, or nullptr if it was moved to another
+     * object.
+     */
+    std::shared_ptr<const interpreter::HashIndex> m_index;
+};
+} // namespace jmespath
+#endif // DOCUMENTINDEX_H
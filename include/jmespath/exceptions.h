@@ -54,6 +54,13 @@ using InfoSyntaxErrorLocation
  */
 using InfoFunctionName
     = boost::error_info<struct tag_function_name, std::string>;
+/**
+ * @ingroup error_info
+ * @brief InfoVariableName contains the name of a variable referenced in the
+ * JMESPath expression.
+ */
+using InfoVariableName
+    = boost::error_info<struct tag_variable_name, std::string>;
 
 /**
  * @defgroup exceptions Exception classes
@@ -150,5 +157,18 @@ private:
      */
     virtual void anchor();
 };
+/**
+ * @ingroup exceptions
+ * @brief The UndefinedVariable struct represents a reference to a variable
+ * which isn't bound by any of the enclosing let expressions.
+ */
+struct UndefinedVariable : virtual Exception
+{
+private:
+    /**
+     * @brief A virtual function used to pin vtable to a transaltion unit
+     */
+    virtual void anchor();
+};
 } // namespace jmespath
 #endif // EXCEPTIONS_H
@@ -27,7 +27,10 @@
 ****************************************************************************/
 #ifndef EXPRESSION_H
 #define EXPRESSION_H
+#include <cstddef>
 #include <memory>
+#include <utility>
+#include <vector>
 #include <jmespath/types.h>
 #include <jmespath/exceptions.h>
 
@@ -36,6 +39,72 @@ namespace jmespath {
 namespace ast {
 class ExpressionNode;
 }
+namespace interpreter {
+class LogicOperatorProfile;
+}
+/**
+ * @ingroup public
+ * @brief The SharedSubexpression struct describes a subexpression which
+ * occurs more than once on the same context, and which is evaluated only once
+ * per context instead of at every occurrence.
+ */
+struct SharedSubexpression
+{
+    /**
+     * @brief The text of the subexpression.
+     */
+    String expression;
+    /**
+     * @brief The number of occurrences which share the result of a single
+     * evaluation.
+     */
+    std::size_t occurrences;
+    /**
+     * @brief Equality compares this object to the @a other.
+     * @param[in] other The object that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const SharedSubexpression& other) const
+    {
+        return (expression == other.expression)
+                && (occurrences == other.occurrences);
+    }
+};
+
+/**
+ * @ingroup public
+ * @brief The LogicOperatorOrder struct describes the order in which the
+ * operands of an adaptively ordered `&&` or `||` operator are evaluated.
+ */
+struct LogicOperatorOrder
+{
+    /**
+     * @brief The text of the operator's expression.
+     */
+    String expression;
+    /**
+     * @brief Whether the right operand is evaluated before the left one.
+     */
+    bool swapped;
+    /**
+     * @brief The number of evaluations sampled for choosing the order.
+     */
+    std::size_t samples;
+    /**
+     * @brief Equality compares this object to the @a other.
+     * @param[in] other The object that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const LogicOperatorOrder& other) const
+    {
+        return (expression == other.expression)
+                && (swapped == other.swapped)
+                && (samples == other.samples);
+    }
+};
+
 /**
  * @ingroup public
  * @brief The Expression class represents a JMESPath expression.
@@ -122,6 +191,29 @@ public:
      * empty.
      */
     const ast::ExpressionNode* astRoot() const;
+    /**
+     * @brief Returns the subexpressions which occur more than once on the
+     * same context and which are evaluated only once per context.
+     *
+     * Structurally equal subexpressions are shared if they don't depend on
+     * variables and don't call custom functions. The subexpressions are
+     * listed in the order they were found, and they are evaluated only when
+     * the first of their occurrences is reached.
+     * @return The report of the shared subexpressions.
+     */
+    const std::vector<SharedSubexpression>& sharedSubexpressions() const;
+    /**
+     * @brief Returns the current evaluation order of the adaptively ordered
+     * logic operators.
+     *
+     * The operators are only ordered adaptively if the expression was
+     * parsed while the adaptive ordering was enabled with
+     * @ref setAdaptiveLogicOrderEnabled. The orders are shared by the copies
+     * of the expression and they're updated by every search, including the
+     * concurrent ones.
+     * @return The orders of the operators in the order they were found.
+     */
+    std::vector<LogicOperatorOrder> logicOperatorOrders() const;
 
 private:
     /**
@@ -148,7 +240,19 @@ private:
      */
     std::unique_ptr<ast::ExpressionNode, ExpressionDeleter> m_astRoot;
     /**
-     * @brief Parses the @a expressionString and updates the AST.
+     * @brief The subexpressions shared by the occurrences in the ast.
+     */
+    std::vector<SharedSubexpression> m_sharedSubexpressions;
+    /**
+     * @brief The texts and profiles of the adaptively ordered logic
+     * operators in the ast.
+     */
+    std::vector<std::pair<
+        String, std::shared_ptr<interpreter::LogicOperatorProfile>>>
+        m_logicOperatorProfiles;
+    /**
+     * @brief Parses the @a expressionString and updates the AST, which gets
+     * optimized if the optimizer is enabled.
      * @param[in] expressionString The string representation of the JMESPath
      * expression.
      * @throws SyntaxError When the syntax of the specified
@@ -157,6 +261,56 @@ private:
     void parseExpression(const String &expressionString);
 };
 
+/**
+ * @ingroup public
+ * @brief Enables or disables the optimization of the parsed expressions.
+ *
+ * The ASTs of the expressions are rewritten into equivalent ones which can be
+ * evaluated faster when they're parsed. The expressions parsed while the
+ * optimizer is disabled are evaluated as they were written, which can be
+ * useful for debugging, and they don't report shared subexpressions. The
+ * expressions parsed before the call are not affected. The optimizer is
+ * enabled by default.
+ * @param[in] enabled If false the parsed expressions are not optimized.
+ * @note This function is thread safe.
+ */
+void setOptimizerEnabled(bool enabled);
+
+/**
+ * @ingroup public
+ * @brief Returns whether the parsed expressions get optimized.
+ * @return Returns true if the optimizer is enabled, otherwise false.
+ * @note This function is thread safe.
+ */
+bool isOptimizerEnabled();
+
+/**
+ * @ingroup public
+ * @brief Enables or disables the adaptive ordering of the `&&` and `||`
+ * operators of the parsed expressions.
+ *
+ * The operands of adaptively ordered operators are evaluated in the order
+ * which is observed to be cheaper, based on the sampled cost and short
+ * circuiting rate of the operands. Only the operators whose result is tested
+ * just for its truthiness, like the operators in the conditions of filters,
+ * and whose left operand doesn't call functions and whose right operand
+ * doesn't call custom functions are ordered adaptively, so the results of
+ * the searches don't depend on the order. The expressions parsed before the
+ * call are not affected. The adaptive ordering is disabled by default.
+ * @param[in] enabled If true the operators are ordered adaptively.
+ * @note This function is thread safe.
+ */
+void setAdaptiveLogicOrderEnabled(bool enabled);
+
+/**
+ * @ingroup public
+ * @brief Returns whether the operators of the parsed expressions are ordered
+ * adaptively.
+ * @return Returns true if the adaptive ordering is enabled, otherwise false.
+ * @note This function is thread safe.
+ */
+bool isAdaptiveLogicOrderEnabled();
+
 /**
  * @brief User defined literals
  */
@@ -0,0 +1,146 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef FUNCTIONS_H
+#define FUNCTIONS_H
+#include <functional>
+#include <vector>
+#include <jmespath/types.h>
+#include <jmespath/exceptions.h>
+
+namespace jmespath {
+
+/**
+ * @ingroup public
+ * @brief The types of values a custom function argument can accept.
+ */
+enum class ArgumentType
+{
+    Any,
+    Null,
+    Boolean,
+    Number,
+    String,
+    Array,
+    Object
+};
+
+/**
+ * @ingroup public
+ * @brief The FunctionArguments class provides access to the evaluated
+ * arguments of a custom function call.
+ *
+ * The arguments are borrowed from the evaluation, the returned references are
+ * only valid until the custom function returns.
+ */
+class FunctionArguments
+{
+public:
+    /**
+     * @brief Destroys the FunctionArguments object.
+     */
+    virtual ~FunctionArguments();
+    /**
+     * @brief Returns the number of arguments the function was called with.
+     * @return The number of arguments.
+     */
+    virtual std::size_t size() const = 0;
+    /**
+     * @brief Returns the argument at the given @a index.
+     *
+     * Arguments of functions which evaluate their arguments on demand are
+     * evaluated by the first call of this function.
+     * @param[in] index The argument's position.
+     * @return Constant reference to the argument's value.
+     * @throws InvalidAgrument If the @a index is out of range.
+     * @throws InvalidFunctionArgumentType If the argument doesn't match the
+     * declared type.
+     */
+    virtual const Json& at(std::size_t index) const = 0;
+    /**
+     * @brief Returns the argument at the given @a index.
+     * @sa at
+     */
+    const Json& operator[](std::size_t index) const
+    {
+        return at(index);
+    }
+};
+
+/**
+ * @ingroup public
+ * @brief Custom function implementation type.
+ */
+using CustomFunction = std::function<Json(const FunctionArguments&)>;
+
+/**
+ * @ingroup public
+ * @brief The FunctionSignature struct describes the arguments of a custom
+ * function.
+ */
+struct FunctionSignature
+{
+    /**
+     * @brief The types of the function's arguments, which also determine the
+     * number of arguments the function can be called with.
+     */
+    std::vector<ArgumentType> argumentTypes;
+    /**
+     * @brief If true the last argument type can be repeated any number of
+     * times.
+     */
+    bool variadic = false;
+    /**
+     * @brief If true the arguments are only evaluated when the function
+     * requests their values, otherwise they're evaluated before the call.
+     */
+    bool evaluateOnDemand = false;
+};
+
+/**
+ * @ingroup public
+ * @brief Registers a custom function which can be called from JMESPath
+ * expressions under the given @a name.
+ *
+ * Calls of the function are resolved when the expressions get parsed, so the
+ * function should be registered before parsing the expressions which use it.
+ * The declared argument types are validated by the library before the values
+ * are handed to @a function, and arguments with constant values are already
+ * validated when the expression is parsed. Expression references (`&expr`)
+ * can't be passed to custom functions.
+ * @param[in] name The function's name.
+ * @param[in] signature The function's signature.
+ * @param[in] function The function's implementation.
+ * @note This function is thread safe.
+ * @throws InvalidAgrument If a function with the same @a name already exists,
+ * or if the @a signature or @a function is invalid.
+ */
+void registerFunction(const String& name,
+                      const FunctionSignature& signature,
+                      CustomFunction function);
+} // namespace jmespath
+#endif // FUNCTIONS_H
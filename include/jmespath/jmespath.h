@@ -31,6 +31,8 @@
 #include <jmespath/types.h>
 #include <jmespath/exceptions.h>
 #include <jmespath/expression.h>
+#include <jmespath/functions.h>
+#include <jmespath/documentindex.h>
 
 /**
  * @mainpage %jmespath.cpp
@@ -136,6 +138,61 @@
  * auto result2 = jmespath::search(expression, R"({"foo": {"bar": "baz"}})"_json);
  * @endcode
  *
+ * The repeated subexpressions which are evaluated on the same value are
+ * shared when the expression is parsed, so they are evaluated only once.
+ * They can be listed with @ref jmespath::Expression::sharedSubexpressions.
+ * @code{.cpp}
+ * jmespath::Expression expression {"{a: foo.bar.a, b: foo.bar.b}"};
+ * // prints foo.bar 2
+ * for (const auto& shared: expression.sharedSubexpressions())
+ * {
+ *     std::cout << shared.expression << " " << shared.occurrences << std::endl;
+ * }
+ * @endcode
+ *
+ * Sharing the subexpressions is one of the passes of the optimizer, which
+ * rewrites the parsed expressions into equivalent ones that can be evaluated
+ * faster. For debugging, the optimizer can be disabled with
+ * @ref jmespath::setOptimizerEnabled, in which case the expressions parsed
+ * afterwards are evaluated as they were written.
+ *
+ * The operands of the `&&` and `||` operators in filter conditions can also
+ * be ordered adaptively, after enabling it with
+ * @ref jmespath::setAdaptiveLogicOrderEnabled. The operators of the
+ * expressions parsed afterwards sample the cost and the short circuiting rate
+ * of their operands, and evaluate the right operand first if that's expected
+ * to be cheaper. The chosen orders are listed by
+ * @ref jmespath::Expression::logicOperatorOrders.
+ *
+ * @subsection document_indexes Document indexes
+ * The filters which select the items of an array with a given key, like
+ * `users[?id == 'u123']`, can look up the matching items in an index instead
+ * of evaluating their condition on every item. The index of an array of a
+ * document is built by creating a @ref jmespath::DocumentIndex object, and
+ * it's used by the searches while the object exists and the array isn't
+ * modified.
+ * @code{.cpp}
+ * jmespath::DocumentIndex index {document, "users", "id"};
+ * auto result = jmespath::search("users[?id == 'u123']", document);
+ * @endcode
+ *
+ * @subsection custom_functions Custom functions
+ * Besides the built in JMESPath functions you can also register your own
+ * functions with @ref jmespath::registerFunction. The arguments are evaluated
+ * and their types are validated by the library, so the function receives
+ * them as constant references through a @ref jmespath::FunctionArguments
+ * object. Functions should be registered before parsing the expressions
+ * which call them.
+ * @code{.cpp}
+ * jmespath::registerFunction(
+ *     "add", {{jmespath::ArgumentType::Number,
+ *              jmespath::ArgumentType::Number}},
+ *     [](const jmespath::FunctionArguments& arguments) -> jmespath::Json {
+ *         return arguments[0].get<double>() + arguments[1].get<double>();
+ *     });
+ * auto result = jmespath::search("add(foo, `2`)", R"({"foo": 3})"_json);
+ * @endcode
+ *
  * @subsection json JSON documents
  * For the handling of JSON documents and values %jmespath.cpp relies on the
  * excelent <a href="https://github.com/nlohmann/json">nlohmann_json</a>
@@ -157,6 +214,14 @@
  * nlohmann::json jsonObject {{"foo", "bar"}};
  * @endcode
  *
+ * The results can be serialized with the @ref jmespath::dump function, which
+ * produces the same compact JSON text as the `dump()` member function, but
+ * formats numbers and strings faster.
+ * @code{.cpp}
+ * auto result = jmespath::search("foo", R"({"foo": [1, 2.5, "bar"]})"_json);
+ * std::string text = jmespath::dump(result); // [1,2.5,"bar"]
+ * @endcode
+ *
  * @subsection error Error handling
  * All the exceptions that might get thrown by @ref jmespath::search or
  * @ref jmespath::Expression are listed on the @ref exceptions page.
@@ -326,6 +391,8 @@ namespace jmespath {
  * an unexpected number of arguments in the *expression*.
  * @throws InvalidFunctionArgumentType When an invalid type of argument was
  * specified for a JMESPath function call in the *expression*.
+ * @throws UndefinedVariable When a variable which isn't bound by any of the
+ * enclosing let expressions is referenced in the *expression*.
  */
 template <typename JsonT>
 std::enable_if_t<std::is_same<std::decay_t<JsonT>, Json>::value, Json>
@@ -340,5 +407,30 @@ extern template Json search<const Json&>(const Expression&, const Json&);
 extern template Json search<Json&>(const Expression&, Json&);
 extern template Json search<Json>(const Expression&, Json&&);
 /** @}*/
+
+/**
+ * @ingroup public
+ * @brief Serializes the @a value into compact JSON text.
+ *
+ * The produced text is the same as the result of calling `dump()` on the
+ * @a value, but numbers and strings are written directly into the result,
+ * which makes it faster for large search results.
+ * @param value The JSON value which should be serialized.
+ * @return The JSON text of the @a value.
+ * @throws InvalidValue If a string in the @a value is not valid UTF-8.
+ */
+String dump(const Json& value);
+
+/**
+ * @ingroup public
+ * @brief Appends the compact JSON text of the @a value to the @a output.
+ *
+ * Reusing the same @a output string for the serialization of multiple values
+ * avoids allocating a new buffer for each of them.
+ * @param value The JSON value which should be serialized.
+ * @param output The string to which the JSON text is appended.
+ * @throws InvalidValue If a string in the @a value is not valid UTF-8.
+ */
+void dump(const Json& value, String& output);
 } // namespace jmespath
 #endif // JMESPATH_H
@@ -158,6 +158,25 @@ public:
     {
         return _m->max_size();
     }
+    // 预留至少能容纳 new_cap 个元素的存储空间
+    inline void reserve(size_type new_cap)
+    {
+        _m->reserve(new_cap);
+    }
+    // 检查容器是否独占其缓冲区，只有独占时修改容器才不会影响其他的副本
+    // checks whether the container is the sole owner of its buffer, only then
+    // can it be modified without affecting its copies
+    inline bool unique() const SC_NOEXCEPT
+    {
+        return _m.use_count() == 1;
+    }
+    // 检查两个容器是否共享同一缓冲区，这样的容器无需比较元素即相等
+    // checks whether the two containers share the same buffer, such
+    // containers are equal without comparing their items
+    inline bool same_items(const this_type& x) const SC_NOEXCEPT
+    {
+        return _m == x._m;
+    }
     // 从容器擦除所有元素。此调用后 size() 返回零。
     // 非法化任何指代所含元素的引用、指针或迭代器。可能亦非法化尾后迭代器。
     inline void clear() SC_NOEXCEPT
@@ -237,17 +256,40 @@ public:
         return sz - size();
     }
 
-    // 插入一个值
+    // 若容器中无拥有该关键的元素，则插入一个值
     inline insert_return_type insert(const value_type& value)
     {
+        iterator it = find(value.first);
+        if (it != end()) {
+            return std::make_pair(it, false);
+        }
         return std::make_pair(_m->insert(_m->end(), value), true);
     }
+    inline insert_return_type insert(value_type&& value)
+    {
+        iterator it = find(value.first);
+        if (it != end()) {
+            return std::make_pair(it, false);
+        }
+        return std::make_pair(_m->insert(_m->end(), std::move(value)), true);
+    }
     template <class P>
     inline std::pair<iterator, bool> insert(P&& value) SC_NOEXCEPT(std::is_constructible<value_type, P&&>::value)
     {
         // 确保 value 可以构造一个 value_type 对象
         // static_assert(std::is_constructible<value_type, P&&>::value == true);
-        return insert(value_type(value));
+        return insert(value_type(std::forward<P>(value)));
+    }
+    /// append
+    /// 这是一个扩展，用于不查找 key 直接在容器末尾追加键值对，调用者需确保 key 不存在。
+    /// an extension which appends the key-value pair to the end of the container
+    /// without looking up the key, the caller must ensure that the key doesn't
+    /// exist yet
+    template <class K, class M>
+    inline mapped_type& append(K&& key, M&& value)
+    {
+        _m->emplace_back(std::forward<K>(key), std::forward<M>(value));
+        return _m->back().second;
     }
     /// insert
     /// 这是一个扩展，用于若 key 不存在则创建一个键值对，值使用默认值。
@@ -348,12 +390,19 @@ inline bool operator==(const SharedContainer::unordered_map<Key, T, Hash, KeyEqu
     if (a.size() != b.size())
         return false;
 
+    // Containers sharing the same buffer don't have to be compared item by item.
+    if (a.same_items(b))
+        return true;
+
     // For map (with its unique keys), we need only test that each element in a can be found in b,
     // as there can be only one such pairing per element. multimap needs to do a something more elaborate.
-    for (const_iterator ai = a.begin(), aiEnd = a.end(), biEnd = b.end(); ai != aiEnd; ++ai) {
-        const_iterator bi = b.find(ai->first);
+    // The keys are usually stored in the same order, so the element at the same position in b is
+    // checked first, and b is only searched if its key is different.
+    const_iterator bi = b.begin();
+    for (const_iterator ai = a.begin(), aiEnd = a.end(), biEnd = b.end(); ai != aiEnd; ++ai, ++bi) {
+        const_iterator match = (bi->first == ai->first) ? bi : b.find(ai->first);
 
-        if ((bi == biEnd) || !(*ai == *bi)) // We have to compare the values, because lookups are done by keys alone but the full value_type of a map is a key/value pair.
+        if ((match == biEnd) || !(*ai == *match)) // We have to compare the values, because lookups are done by keys alone but the full value_type of a map is a key/value pair.
             return false; // It's possible that two elements in the two containers have identical keys but different values.
     }
 
@@ -1,7 +1,13 @@
 ﻿#ifndef SHARED_VECTOR_H
 #define SHARED_VECTOR_H
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #ifndef SC_NOEXCEPT
@@ -10,6 +16,86 @@
 
 namespace SharedContainer {
 
+/// stride_iterator
+///
+/// 以固定步长遍历连续内存的随机访问迭代器，用于遍历 vector 的切片视图。
+/// Random access iterator which visits the items of a contiguous buffer with
+/// a fixed step, used for iterating over the slice views of vector. The
+/// position is stored as an index, so a reversed view never points before
+/// the start of the buffer.
+///
+template <typename T, typename Pointer, typename Reference>
+class stride_iterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef Pointer pointer;
+    typedef Reference reference;
+
+    inline stride_iterator() SC_NOEXCEPT
+        : _origin(nullptr)
+        , _position(0)
+        , _stride(1)
+    {
+    }
+    inline stride_iterator(Pointer origin, difference_type position, difference_type stride) SC_NOEXCEPT
+        : _origin(origin)
+        , _position(position)
+        , _stride(stride)
+    {
+    }
+    // iterator 到 const_iterator 的转换
+    template <typename P, typename R>
+    inline stride_iterator(const stride_iterator<T, P, R>& x) SC_NOEXCEPT
+        : _origin(x._origin)
+        , _position(x._position)
+        , _stride(x._stride)
+    {
+    }
+
+    inline reference operator*() const { return _origin[_position * _stride]; }
+    inline pointer operator->() const { return _origin + _position * _stride; }
+    inline reference operator[](difference_type n) const { return _origin[(_position + n) * _stride]; }
+
+    inline stride_iterator& operator++() { ++_position; return *this; }
+    inline stride_iterator operator++(int) { stride_iterator it(*this); ++_position; return it; }
+    inline stride_iterator& operator--() { --_position; return *this; }
+    inline stride_iterator operator--(int) { stride_iterator it(*this); --_position; return it; }
+    inline stride_iterator& operator+=(difference_type n) { _position += n; return *this; }
+    inline stride_iterator& operator-=(difference_type n) { _position -= n; return *this; }
+    inline stride_iterator operator+(difference_type n) const { return stride_iterator(_origin, _position + n, _stride); }
+    inline stride_iterator operator-(difference_type n) const { return stride_iterator(_origin, _position - n, _stride); }
+    friend inline stride_iterator operator+(difference_type n, const stride_iterator& it) { return it + n; }
+
+    template <typename P, typename R>
+    inline difference_type operator-(const stride_iterator<T, P, R>& x) const { return _position - x._position; }
+    template <typename P, typename R>
+    inline bool operator==(const stride_iterator<T, P, R>& x) const { return _position == x._position; }
+    template <typename P, typename R>
+    inline bool operator!=(const stride_iterator<T, P, R>& x) const { return _position != x._position; }
+    template <typename P, typename R>
+    inline bool operator<(const stride_iterator<T, P, R>& x) const { return _position < x._position; }
+    template <typename P, typename R>
+    inline bool operator>(const stride_iterator<T, P, R>& x) const { return _position > x._position; }
+    template <typename P, typename R>
+    inline bool operator<=(const stride_iterator<T, P, R>& x) const { return _position <= x._position; }
+    template <typename P, typename R>
+    inline bool operator>=(const stride_iterator<T, P, R>& x) const { return _position >= x._position; }
+
+    /// 迭代器在视图中的位置
+    /// The index of the item in the iterated view.
+    inline difference_type position() const SC_NOEXCEPT { return _position; }
+
+private:
+    template <typename, typename, typename>
+    friend class stride_iterator;
+
+    Pointer _origin;
+    difference_type _position;
+    difference_type _stride;
+};
+
 /// \class vector uvector.h ustl.h
 /// \ingroup Sequences
 ///
@@ -20,6 +106,22 @@ namespace SharedContainer {
 /// this design elements frequently undergo bitwise move, so don't put it in
 /// here if it doesn't support it. This mostly means having no self-pointers.
 ///
+/// 切片视图：slice() 在 O(1) 时间内返回共享同一缓冲区的视图（偏移、步长、长度），
+/// 只有在修改视图的结构（插入、删除、改变大小等）时才会复制出独立的缓冲区。
+/// Slice views: slice() returns a view in O(1) time which shares the buffer
+/// of the vector (offset, stride and length). The view is materialized into
+/// its own buffer only when its structure gets modified (insertion, erasure,
+/// resizing and so on), reading and serializing it doesn't copy the items.
+///
+/// 修改计数：track_modifications() 之后，通过任何共享该缓冲区的容器修改缓冲区的结构
+/// （赋值、插入、删除、调整大小等），都会增加 modification_count()。通过引用原地修改元素
+/// 不会被计数，因为 nlohmann::json 的 const 成员也会调用非 const 的访问函数。
+/// Modification counting: after track_modifications(), modifying the
+/// structure of the buffer (assignment, insertion, erasure, resizing and so
+/// on) through any container sharing it increments modification_count().
+/// Modifying the items in place through references isn't counted, since the
+/// const members of nlohmann::json call the non const accessors as well.
+///
 template <typename T, typename Allocator = std::allocator<T>>
 class vector {
 public:
@@ -34,62 +136,119 @@ public:
     typedef typename base_type::const_reference const_reference;
     typedef typename base_type::pointer pointer;
     typedef typename base_type::const_pointer const_pointer;
-    typedef typename base_type::iterator iterator;
-    typedef typename base_type::const_iterator const_iterator;
-    typedef typename base_type::reverse_iterator reverse_iterator;
-    typedef typename base_type::const_reverse_iterator const_reverse_iterator;
+    typedef stride_iterator<T, pointer, reference> iterator;
+    typedef stride_iterator<T, const_pointer, const_reference> const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
 
 private:
-    std::shared_ptr<base_type> _m;
+    // 共享的缓冲区，以及它的修改次数
+    // the shared buffer, and the number of its modifications
+    struct buffer_type : base_type {
+        using base_type::base_type;
+        std::atomic<bool> tracked{false};
+        std::atomic<std::uint64_t> modifications{0};
+    };
+
+    std::shared_ptr<buffer_type> _m;
+    // 视图的参数，只有 _view 为 true 时有效
+    // parameters of the view, only valid if _view is true
+    bool _view = false;
+    size_type _offset = 0;
+    difference_type _stride = 1;
+    size_type _length = 0;
+
+    // 视图第一个元素的地址
+    // address of the first item of the view
+    inline pointer origin() const SC_NOEXCEPT
+    {
+        return _view ? _m->data() + _offset : _m->data();
+    }
+    inline difference_type stride() const SC_NOEXCEPT { return _view ? _stride : 1; }
+
+    // 将视图复制到独立的缓冲区，在修改结构之前调用
+    // copy the items of the view into its own buffer, it's called before
+    // modifying the structure of the container
+    inline void materialize()
+    {
+        if (_view) {
+            _m = std::make_shared<buffer_type>(cbegin(), cend());
+            _view = false;
+        }
+    }
+    // 在修改缓冲区的结构之前调用，必须在 materialize() 之后调用
+    // called before modifying the structure of the buffer, it must be called
+    // after materialize()
+    inline void touch() const SC_NOEXCEPT
+    {
+        if (_m->tracked.load(std::memory_order_relaxed)) {
+            _m->modifications.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    // 将迭代器转换为缓冲区的迭代器，必须在 materialize() 之后调用
+    // convert the iterator into an iterator of the buffer, it must be called
+    // after materialize()
+    inline typename base_type::iterator base_iterator(difference_type position)
+    {
+        return _m->begin() + position;
+    }
+    inline iterator make_iterator(typename base_type::iterator it)
+    {
+        return begin() + (it - _m->begin());
+    }
 
 public:
     // 从各种数据源构造新容器
     // 使用传入参数，调用std::vector 的构造
     // template<class... Args>
     // inline vector(Args&&... args)
-    //   : _m(std::make_shared<base_type>(std::forward<Args>(args)...))
+    //   : _m(std::make_shared<buffer_type>(std::forward<Args>(args)...))
     // {
     //     // Empty
     // }
     inline vector() SC_NOEXCEPT(SC_NOEXCEPT(Allocator()))
-        : _m(std::make_shared<base_type>())
+        : _m(std::make_shared<buffer_type>())
     {
     }
     inline explicit vector(const allocator_type& allocator) SC_NOEXCEPT
-        : _m(std::make_shared<base_type>())
+        : _m(std::make_shared<buffer_type>())
     {
     }
     inline explicit vector(size_type n, const allocator_type& allocator = Allocator())
-        : _m(std::make_shared<base_type>(n))
+        : _m(std::make_shared<buffer_type>(n))
     {
     }
     inline vector(size_type n, const value_type& value, const allocator_type& allocator = Allocator())
-        : _m(std::make_shared<base_type>(n, value))
+        : _m(std::make_shared<buffer_type>(n, value))
     {
     }
     inline vector(const this_type& x)
         : _m(x._m)
+        , _view(x._view)
+        , _offset(x._offset)
+        , _stride(x._stride)
+        , _length(x._length)
     {
     }
     inline vector(const this_type& x, const allocator_type& allocator)
-        : _m(x._m)
+        : vector(x)
     {
     }
     inline vector(this_type&& x) SC_NOEXCEPT
-        : _m(x._m)
+        : vector(x)
     {
     }
     inline vector(this_type&& x, const allocator_type& allocator)
-        : _m(x._m)
+        : vector(x)
     {
     }
     inline vector(std::initializer_list<value_type> ilist, const allocator_type& allocator = Allocator())
-        : _m(std::make_shared<base_type>(ilist))
+        : _m(std::make_shared<buffer_type>(ilist))
     {
     }
     template <typename InputIterator>
     inline vector(InputIterator first, InputIterator last, const allocator_type& allocator = Allocator())
-        : _m(std::make_shared<base_type>(first, last))
+        : _m(std::make_shared<buffer_type>(first, last))
     {
     }
 
@@ -99,22 +258,54 @@ public:
     this_type& operator=(const this_type& x)
     {
         _m = x._m;
+        _view = x._view;
+        _offset = x._offset;
+        _stride = x._stride;
+        _length = x._length;
+        return *this;
     }
     this_type& operator=(std::initializer_list<value_type> ilist)
     {
-        _m = std::make_shared<base_type>(ilist);
+        _m = std::make_shared<buffer_type>(ilist);
+        _view = false;
+        return *this;
     }
     // 此处 C++17 使用
     this_type& operator=(this_type&& x) SC_NOEXCEPT(
         std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value)
     {
-        _m = x._m;
+        return operator=(static_cast<const this_type&>(x));
     }
     // 此处 C++17 使用
     void swap(this_type& x) SC_NOEXCEPT(
         std::allocator_traits<Allocator>::propagate_on_container_move_assignment::value || std::allocator_traits<Allocator>::is_always_equal::value)
     {
-        _m = x._m;
+        std::swap(_m, x._m);
+        std::swap(_view, x._view);
+        std::swap(_offset, x._offset);
+        std::swap(_stride, x._stride);
+        std::swap(_length, x._length);
+    }
+
+    /// slice
+    ///
+    /// 返回从 first 开始、步长为 step 的 count 个元素组成的视图，与本容器共享缓冲区。
+    /// Returns a view of count items starting at the item at first and
+    /// advancing by step, which shares the buffer of this container. The
+    /// items selected by the view must be in the container's range.
+    ///
+    this_type slice(size_type first, difference_type step, size_type count) const
+    {
+        this_type result(*this);
+        result._view = true;
+        result._length = count;
+        result._stride = stride() * step;
+        result._offset = 0;
+        if (count > 0) {
+            result._offset = static_cast<size_type>(origin() - _m->data()
+                + static_cast<difference_type>(first) * stride());
+        }
+        return result;
     }
 
     // 将值赋给容器
@@ -122,75 +313,122 @@ public:
     template <class... Args>
     inline void assign(Args&&... args)
     {
+        materialize();
+        touch();
         return _m->assign(std::forward<Args>(args)...);
     }
     void assign(size_type n, const value_type& value)
     {
+        materialize();
+        touch();
         return _m->assign(n, value);
     }
 
     template <typename InputIterator>
     void assign(InputIterator first, InputIterator last)
     {
-        return _m->assign(first, last);
+        // 迭代器可能指向本容器，所以先复制
+        // the iterators might point into this container, so copy them first
+        base_type items(first, last);
+        materialize();
+        touch();
+        _m->swap(items);
     }
 
     void assign(std::initializer_list<value_type> ilist)
     {
+        materialize();
+        touch();
         return _m->assign(ilist);
     }
 
-    inline iterator begin() SC_NOEXCEPT { return _m->begin(); }
-    inline const_iterator begin() const SC_NOEXCEPT { return _m->begin(); }
-    inline const_iterator cbegin() const SC_NOEXCEPT { return _m->cbegin(); }
+    inline iterator begin() SC_NOEXCEPT { return iterator(origin(), 0, stride()); }
+    inline const_iterator begin() const SC_NOEXCEPT { return const_iterator(origin(), 0, stride()); }
+    inline const_iterator cbegin() const SC_NOEXCEPT { return begin(); }
 
-    inline iterator end() SC_NOEXCEPT { return _m->end(); }
-    inline const_iterator end() const SC_NOEXCEPT { return _m->end(); }
-    inline const_iterator cend() const SC_NOEXCEPT { return _m->cend(); }
+    inline iterator end() SC_NOEXCEPT { return begin() + static_cast<difference_type>(size()); }
+    inline const_iterator end() const SC_NOEXCEPT { return begin() + static_cast<difference_type>(size()); }
+    inline const_iterator cend() const SC_NOEXCEPT { return end(); }
 
-    inline reverse_iterator rbegin() SC_NOEXCEPT { return _m->rbegin(); }
-    inline const_reverse_iterator rbegin() const SC_NOEXCEPT { return _m->rbegin(); }
-    inline const_reverse_iterator crbegin() const SC_NOEXCEPT { return _m->cbegin(); }
+    inline reverse_iterator rbegin() SC_NOEXCEPT { return reverse_iterator(end()); }
+    inline const_reverse_iterator rbegin() const SC_NOEXCEPT { return const_reverse_iterator(end()); }
+    inline const_reverse_iterator crbegin() const SC_NOEXCEPT { return rbegin(); }
 
-    inline reverse_iterator rend() SC_NOEXCEPT { return _m->rend(); }
-    inline const_reverse_iterator rend() const SC_NOEXCEPT { return _m->rend(); }
-    inline const_reverse_iterator crend() const SC_NOEXCEPT { return _m->crend(); }
+    inline reverse_iterator rend() SC_NOEXCEPT { return reverse_iterator(begin()); }
+    inline const_reverse_iterator rend() const SC_NOEXCEPT { return const_reverse_iterator(begin()); }
+    inline const_reverse_iterator crend() const SC_NOEXCEPT { return rend(); }
 
-    inline bool empty() const SC_NOEXCEPT { return _m->empty(); }
-    inline size_type size() const SC_NOEXCEPT { return _m->size(); }
+    inline bool empty() const SC_NOEXCEPT { return size() == 0; }
+    // 检查两个容器是否引用同一缓冲区中的相同元素，这样的容器无需比较元素即相等
+    // checks whether the two containers refer to the same items of the same
+    // buffer, such containers are equal without comparing their items
+    inline bool same_items(const this_type& x) const SC_NOEXCEPT
+    {
+        return size() == x.size()
+            && (empty() || (origin() == x.origin() && (size() == 1 || stride() == x.stride())));
+    }
+    inline size_type size() const SC_NOEXCEPT { return _view ? _length : _m->size(); }
     inline size_type max_size() const SC_NOEXCEPT { return _m->max_size(); }
-    inline size_type capacity() const SC_NOEXCEPT { return _m->capacity(); }
-
-    inline void resize(size_type n, const value_type& value) { return _m->resize(n, value); }
-    inline void resize(size_type n) { return _m->resize(n); }
-    inline void reserve(size_type n) { return _m->reserve(n); }
-    inline void set_capacity(size_type n = base_type::npos) { return _m->set_capacity(n); }
-    inline void shrink_to_fit() { return _m->shrink_to_fit(); }
-
-    inline pointer data() SC_NOEXCEPT { return _m->data(); }
-    inline const_pointer data() const SC_NOEXCEPT { return _m->data(); }
-
-    inline reference operator[](size_type n) { return _m->operator[](n); }
-    inline const_reference operator[](size_type n) const { return _m->operator[](n); }
-
-    inline reference at(size_type n) { return _m->at(n); }
-    inline const_reference at(size_type n) const { return _m->at(n); }
+    // 检查容器是否独占其缓冲区，只有独占时修改容器才不会影响其他的副本和视图
+    // checks whether the container is the sole owner of its buffer, only then
+    // can it be modified without affecting its copies and views
+    inline bool unique() const SC_NOEXCEPT { return !_view && _m.use_count() == 1; }
+    // 缓冲区的标识，共享同一缓冲区的容器和视图的标识相同
+    // identifies the buffer, the copies and views sharing the same buffer
+    // have the same identifier
+    inline const void* buffer_id() const SC_NOEXCEPT { return _m.get(); }
+    // 开始记录缓冲区的修改次数，包括通过共享该缓冲区的其他容器进行的修改
+    // starts counting the modifications of the buffer, including the ones
+    // made through the other containers sharing it
+    inline void track_modifications() const SC_NOEXCEPT { _m->tracked.store(true, std::memory_order_relaxed); }
+    // 缓冲区开始记录以来的修改次数
+    // the number of modifications since the buffer's modifications are tracked
+    inline std::uint64_t modification_count() const SC_NOEXCEPT { return _m->modifications.load(std::memory_order_relaxed); }
+    inline size_type capacity() const SC_NOEXCEPT { return _view ? _length : _m->capacity(); }
+
+    inline void resize(size_type n, const value_type& value) { materialize(); touch(); return _m->resize(n, value); }
+    inline void resize(size_type n) { materialize(); touch(); return _m->resize(n); }
+    inline void reserve(size_type n) { materialize(); return _m->reserve(n); }
+    inline void shrink_to_fit() { materialize(); return _m->shrink_to_fit(); }
+
+    inline pointer data() { materialize(); return _m->data(); }
+    inline const_pointer data() const { const_cast<this_type*>(this)->materialize(); return _m->data(); }
+
+    inline reference operator[](size_type n) { return origin()[static_cast<difference_type>(n) * stride()]; }
+    inline const_reference operator[](size_type n) const { return origin()[static_cast<difference_type>(n) * stride()]; }
+
+    inline reference at(size_type n)
+    {
+        if (n >= size()) {
+            throw std::out_of_range("SharedContainer::vector::at");
+        }
+        return operator[](n);
+    }
+    inline const_reference at(size_type n) const
+    {
+        if (n >= size()) {
+            throw std::out_of_range("SharedContainer::vector::at");
+        }
+        return operator[](n);
+    }
 
-    inline reference front() { return _m->front(); }
-    inline const_reference front() const { return _m->front(); }
+    inline reference front() { return operator[](0); }
+    inline const_reference front() const { return operator[](0); }
 
-    inline reference back() { return _m->back(); }
-    inline const_reference back() const { return _m->back(); }
+    inline reference back() { return operator[](size() - 1); }
+    inline const_reference back() const { return operator[](size() - 1); }
 
-    inline void push_back(const value_type& value) { return _m->push_back(value); }
-    inline reference push_back() { return _m->push_back(); }
-    inline void push_back(value_type&& value) { return _m->push_back(value); }
-    inline void pop_back() { return _m->pop_back(); }
+    inline void push_back(const value_type& value) { materialize(); touch(); return _m->push_back(value); }
+    inline void push_back(value_type&& value) { materialize(); touch(); return _m->push_back(std::move(value)); }
+    inline void pop_back() { materialize(); touch(); return _m->pop_back(); }
 
     template <class... Args>
     inline iterator emplace(const_iterator pos, Args&&... args)
     {
-        return _m->emplace(pos, std::forward<Args>(args)...);
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->emplace(base_iterator(position), std::forward<Args>(args)...));
     }
 
     // C++17 之前返回 void，C++17开始返回 reference
@@ -198,40 +436,117 @@ public:
     template<class... Args>
     inline void emplace_back(Args&&... args)
     {
+        materialize();
+        touch();
         return _m->emplace_back(std::forward<Args>(args)...);
     }
     #else
     template<class... Args>
     inline reference emplace_back(Args&&... args)
     {
+        materialize();
+        touch();
         return _m->emplace_back(std::forward<Args>(args)...);
     }
     #endif
 
-    inline iterator insert(const_iterator pos, const value_type& value) { return _m->insert(pos, value); }
-    inline iterator insert(const_iterator pos, size_type n, const value_type& value) { return _m->insert(pos, n, value); }
-    inline iterator insert(const_iterator pos, value_type&& value) { return _m->insert(pos, value); }
-    inline iterator insert(const_iterator pos, std::initializer_list<value_type> ilist) { return _m->insert(pos, ilist); }
+    inline iterator insert(const_iterator pos, const value_type& value)
+    {
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->insert(base_iterator(position), value));
+    }
+    inline iterator insert(const_iterator pos, size_type n, const value_type& value)
+    {
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->insert(base_iterator(position), n, value));
+    }
+    inline iterator insert(const_iterator pos, value_type&& value)
+    {
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->insert(base_iterator(position), std::move(value)));
+    }
+    inline iterator insert(const_iterator pos, std::initializer_list<value_type> ilist)
+    {
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->insert(base_iterator(position), ilist));
+    }
 
     template <typename InputIterator>
     inline iterator insert(const_iterator pos, InputIterator first, InputIterator last)
     {
-        return _m->insert(pos, first, last);
+        // 迭代器可能指向本容器，所以先复制
+        // the iterators might point into this container, so copy them first
+        base_type items(first, last);
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->insert(base_iterator(position),
+            std::make_move_iterator(items.begin()),
+            std::make_move_iterator(items.end())));
     }
 
-    inline iterator erase(const_iterator pos) { return _m->erase(pos); }
-    inline iterator erase(const_iterator first, const_iterator last) { return _m->erase(first, last); }
+    inline iterator erase(const_iterator pos)
+    {
+        difference_type position = pos.position();
+        materialize();
+        touch();
+        return make_iterator(_m->erase(base_iterator(position)));
+    }
+    inline iterator erase(const_iterator first, const_iterator last)
+    {
+        difference_type firstPosition = first.position();
+        difference_type lastPosition = last.position();
+        materialize();
+        touch();
+        return make_iterator(_m->erase(base_iterator(firstPosition), base_iterator(lastPosition)));
+    }
 
-    inline reverse_iterator erase(const_reverse_iterator pos) { return _m->erase(pos); }
-    inline reverse_iterator erase(const_reverse_iterator first, const_reverse_iterator last) { return _m->erase(first, last); }
+    inline reverse_iterator erase(const_reverse_iterator pos) { return reverse_iterator(erase((++pos).base())); }
+    inline reverse_iterator erase(const_reverse_iterator first, const_reverse_iterator last) { return reverse_iterator(erase(last.base(), first.base())); }
 
     inline void clear() SC_NOEXCEPT
     {
-        if (_m.use_count() == 1) {
+        // 视图或者共享的缓冲区不能被清空，而是替换为新的缓冲区
+        // views and shared buffers are replaced with a new buffer instead of
+        // clearing them
+        if (_view || _m.use_count() > 1) {
+            _m = std::make_shared<buffer_type>();
+            _view = false;
+        } else {
+            touch();
             _m->clear();
         }
     }
 };
+
+template <typename T, typename Allocator>
+inline bool operator==(const vector<T, Allocator>& a, const vector<T, Allocator>& b)
+{
+    if (a.size() != b.size()) {
+        return false;
+    }
+    // 共享相同元素的容器无需比较元素
+    // containers sharing the same items don't have to be compared item by item
+    return a.same_items(b) || std::equal(a.begin(), a.end(), b.begin());
+}
+template <typename T, typename Allocator>
+inline bool operator!=(const vector<T, Allocator>& a, const vector<T, Allocator>& b)
+{
+    return !(a == b);
+}
+template <typename T, typename Allocator>
+inline bool operator<(const vector<T, Allocator>& a, const vector<T, Allocator>& b)
+{
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
 } // namespace SharedContainer
 
 namespace std {
@@ -54,4 +54,7 @@
 #include "src/ast/filterexpressionnode.h"
 #include "src/ast/functionexpressionnode.h"
 #include "src/ast/expressionargumentnode.h"
+#include "src/ast/variablerefnode.h"
+#include "src/ast/letexpressionnode.h"
+#include "src/ast/pathnode.h"
 #endif // ALLNODES_H
@@ -28,8 +28,14 @@
 #ifndef ANDEXPRESSIONNODE_H
 #define ANDEXPRESSIONNODE_H
 #include "src/ast/binaryexpressionnode.h"
+#include <memory>
 #include <boost/fusion/include/adapt_struct.hpp>
 
+namespace jmespath { namespace interpreter {
+
+class LogicOperatorProfile;
+}}
+
 namespace jmespath { namespace ast {
 
 /**
@@ -69,6 +75,16 @@ public:
      * @param[in] visitor A visitor implementation
      */
     void accept(interpreter::AbstractVisitor* visitor) const override;
+    /**
+     * @brief The profile of the operands, which is only set if the result
+     * of the node is only tested for its truthiness and its operands can be
+     * evaluated in either order.
+     *
+     * The operands are evaluated in the order chosen by the profile. It's
+     * ignored by the equality comparison, and it's shared by the copies of
+     * the node.
+     */
+    std::shared_ptr<interpreter::LogicOperatorProfile> profile;
 };
 }} // namespace jmespath::ast
 
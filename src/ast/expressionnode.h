@@ -50,6 +50,9 @@ class ParenExpressionNode;
 class PipeExpressionNode;
 class CurrentNode;
 class FunctionExpressionNode;
+class VariableRefNode;
+class LetExpressionNode;
+class PathNode;
 /**
  * @brief The ExpressionNode class represents a JMESPath expression.
  */
@@ -69,7 +72,10 @@ class ExpressionNode : public VariantNode<
         boost::recursive_wrapper<ParenExpressionNode>,
         boost::recursive_wrapper<PipeExpressionNode>,
         boost::recursive_wrapper<CurrentNode>,
-        boost::recursive_wrapper<FunctionExpressionNode> >
+        boost::recursive_wrapper<FunctionExpressionNode>,
+        boost::recursive_wrapper<VariableRefNode>,
+        boost::recursive_wrapper<LetExpressionNode>,
+        boost::recursive_wrapper<PathNode> >
 {
 public:
     /**
@@ -28,8 +28,14 @@
 #ifndef FILTEREXPRESSIONNODE_H
 #define FILTEREXPRESSIONNODE_H
 #include "src/ast/expressionnode.h"
+#include <memory>
 #include <boost/fusion/include/adapt_struct.hpp>
 
+namespace jmespath { namespace interpreter {
+
+class FilterKernel;
+}}
+
 namespace jmespath { namespace ast {
 
 /**
@@ -66,6 +72,15 @@ public:
      * @brief The node's child expression.
      */
     ExpressionNode expression;
+    /**
+     * @brief The columnar kernel which evaluates the filter's condition on
+     * whole arrays, which is only set if the condition is a conjunction of
+     * comparisons between fields of the items and constants.
+     *
+     * It's ignored by the equality comparison, and it's shared by the copies
+     * of the node.
+     */
+    std::shared_ptr<const interpreter::FilterKernel> kernel;
 };
 }} // namespace jmespath::ast
 
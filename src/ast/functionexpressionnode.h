@@ -31,7 +31,10 @@
 #include "jmespath/types.h"
 #include <vector>
 #include <initializer_list>
+#include <memory>
+#include <regex>
 #include <boost/variant.hpp>
+#include <boost/optional.hpp>
 #include <boost/fusion/include/adapt_struct.hpp>
 
 namespace jmespath { namespace ast {
@@ -81,6 +84,31 @@ public:
      * @brief The function expressions's arguments.
      */
     std::vector<ArgumentType> arguments;
+    /**
+     * @brief The identifier of the function's implementation if it was
+     * resolved when the expression got parsed.
+     *
+     * It's not part of the node's value, so it's ignored by the equality
+     * comparison.
+     */
+    boost::optional<std::size_t> functionId;
+    /**
+     * @brief Specifies whether the types of the arguments were proven to be
+     * valid when the expression got parsed, in which case the function can be
+     * evaluated without checking the types of its arguments.
+     *
+     * Like @ref functionId, it's ignored by the equality comparison.
+     */
+    bool argumentTypesProven = false;
+    /**
+     * @brief The compiled regular expression of the function's pattern
+     * argument, if the function takes a pattern and the argument is a
+     * constant string, in which case it's compiled when the expression gets
+     * parsed.
+     *
+     * Like @ref functionId, it's ignored by the equality comparison.
+     */
+    std::shared_ptr<const std::regex> pattern;
 };
 }} // namespace jmespath::ast
 
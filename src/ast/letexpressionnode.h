@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef LETEXPRESSIONNODE_H
+#define LETEXPRESSIONNODE_H
+#include "src/ast/abstractnode.h"
+#include "src/ast/variablerefnode.h"
+#include "src/ast/expressionnode.h"
+#include <utility>
+#include <vector>
+#include <boost/fusion/include/adapt_struct.hpp>
+#include <boost/fusion/include/std_pair.hpp>
+#include <boost/fusion/adapted/std_pair.hpp>
+
+namespace jmespath { namespace ast {
+
+/**
+ * @brief The LetExpressionNode class represents a let expression of the
+ * JMESPath lexical scoping extension, which binds the results of expressions
+ * to variables that can be referenced in the node's child expression.
+ */
+class LetExpressionNode : public AbstractNode
+{
+public:
+    using BindingType = std::pair<VariableRefNode, ExpressionNode>;
+    /**
+     * @brief Constructs an empty LetExpressionNode object.
+     */
+    LetExpressionNode();
+    /**
+     * @brief Constructs a LetExpressionNode object with the given
+     * @a bindings and child @a expression.
+     * @param[in] bindings The variables and the expressions whose results
+     * are bound to them.
+     * @param[in] expression The expression in which the variables are
+     * visible.
+     */
+    LetExpressionNode(const std::vector<BindingType>& bindings,
+                      const ExpressionNode& expression);
+    /**
+     * @brief Calls the visit method of the given @a visitor with the
+     * dynamic type of the node.
+     * @param[in] visitor A visitor implementation
+     */
+    void accept(interpreter::AbstractVisitor* visitor) const override;
+    /**
+     * @brief Equality compares this node to the @a other
+     * @param[in] other The node that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const LetExpressionNode& other) const;
+    /**
+     * @brief The variables and the expressions whose results are bound to
+     * them.
+     */
+    std::vector<BindingType> bindings;
+    /**
+     * @brief The expression in which the variables are visible.
+     */
+    ExpressionNode expression;
+    /**
+     * @brief Whether the bound expressions are evaluated only when their
+     * variables are first referenced, instead of before the evaluation of
+     * the child expression.
+     *
+     * Deferred bindings are created by the optimizer for expressions which
+     * don't depend on the scope, so they can be evaluated in any scope.
+     */
+    bool deferred = false;
+};
+}} // namespace jmespath::ast
+
+BOOST_FUSION_ADAPT_STRUCT(
+    jmespath::ast::LetExpressionNode,
+    (std::vector<jmespath::ast::LetExpressionNode::BindingType>, bindings)
+    (jmespath::ast::ExpressionNode, expression)
+)
+#endif // LETEXPRESSIONNODE_H
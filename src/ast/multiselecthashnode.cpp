@@ -28,6 +28,7 @@
 #include "src/ast/multiselecthashnode.h"
 #include "src/ast/allnodes.h"
 #include "src/interpreter/abstractvisitor.h"
+#include <unordered_set>
 
 namespace jmespath { namespace ast {
 
@@ -41,6 +42,7 @@ MultiselectHashNode::MultiselectHashNode(
     : AbstractNode(),
       expressions(subexpressions)
 {
+    updateUniqueKeys();
 }
 
 MultiselectHashNode::MultiselectHashNode(
@@ -48,6 +50,7 @@ MultiselectHashNode::MultiselectHashNode(
     : AbstractNode(),
       expressions(subexpressions)
 {
+    updateUniqueKeys();
 }
 
 void MultiselectHashNode::accept(interpreter::AbstractVisitor *visitor) const
@@ -63,4 +66,21 @@ bool MultiselectHashNode::operator==(const MultiselectHashNode &other) const
     }
     return true;
 }
+
+void MultiselectHashNode::updateUniqueKeys()
+{
+    std::unordered_set<String> keys;
+    keys.reserve(expressions.size());
+    uniqueKeys = true;
+    // try to insert every key into the set of keys until a key is found
+    // which is already in the set
+    for (const auto& keyValuePair: expressions)
+    {
+        if (!keys.insert(keyValuePair.first.identifier).second)
+        {
+            uniqueKeys = false;
+            break;
+        }
+    }
+}
 }} // namespace jmespath::ast
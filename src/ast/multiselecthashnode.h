@@ -75,10 +75,24 @@ public:
      * false
      */
     bool operator==(const MultiselectHashNode& other) const;
+    /**
+     * @brief Updates the value of @ref uniqueKeys according to the keys of
+     * the node's child expressions.
+     */
+    void updateUniqueKeys();
     /**
      * @brief The node's child expressions.
      */
     std::vector<KeyValuePairType> expressions;
+    /**
+     * @brief Specifies whether the keys of the child expressions are known to
+     * be different, in which case their results can be added to the
+     * resulting object without looking up the keys.
+     *
+     * It's not part of the node's value, so it's ignored by the equality
+     * comparison.
+     */
+    bool uniqueKeys = false;
 };
 }} // namespace jmespath::ast
 
@@ -0,0 +1,89 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef PATHNODE_H
+#define PATHNODE_H
+#include "src/ast/abstractnode.h"
+#include "jmespath/types.h"
+#include <cstdint>
+#include <vector>
+#include <boost/variant.hpp>
+#include <boost/fusion/include/adapt_struct.hpp>
+
+namespace jmespath { namespace ast {
+
+/**
+ * @brief The PathNode class represents a chain of identifiers and array
+ * items, like `a.b[0].c`, which is evaluated as a single sequence of lookups.
+ *
+ * Path nodes are not produced by the parser, the optimizer fuses the
+ * subexpressions and index expressions of such chains into them.
+ */
+class PathNode : public AbstractNode
+{
+public:
+    /**
+     * @brief The type of a step of the path, which is either a key looked up
+     * in an object or the index of an item selected from an array.
+     *
+     * Negative indices select items from the end of the array.
+     */
+    using SegmentType = boost::variant<String, std::int64_t>;
+    /**
+     * @brief Constructs an empty PathNode object.
+     */
+    PathNode();
+    /**
+     * @brief Constructs a PathNode object with the given @a segments.
+     * @param[in] segments The steps of the path.
+     */
+    PathNode(const std::vector<SegmentType>& segments);
+    /**
+     * @brief Calls the visit method of the given @a visitor with the
+     * dynamic type of the node.
+     * @param[in] visitor A visitor implementation
+     */
+    void accept(interpreter::AbstractVisitor* visitor) const override;
+    /**
+     * @brief Equality compares this node to the @a other
+     * @param[in] other The node that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const PathNode& other) const;
+    /**
+     * @brief The steps of the path in the order of their evaluation.
+     */
+    std::vector<SegmentType> segments;
+};
+}} // namespace jmespath::ast
+
+BOOST_FUSION_ADAPT_STRUCT(
+    jmespath::ast::PathNode,
+    (std::vector<jmespath::ast::PathNode::SegmentType>, segments)
+)
+#endif // PATHNODE_H
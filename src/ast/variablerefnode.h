@@ -0,0 +1,76 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef VARIABLEREFNODE_H
+#define VARIABLEREFNODE_H
+#include "src/ast/abstractnode.h"
+#include "jmespath/types.h"
+#include <boost/fusion/include/adapt_struct.hpp>
+
+namespace jmespath { namespace ast {
+
+/**
+ * @brief The VariableRefNode class represents a reference to a variable bound
+ * by an enclosing let expression.
+ */
+class VariableRefNode : public AbstractNode
+{
+public:
+    /**
+     * @brief Constructs a VariableRefNode object with an empty name.
+     */
+    VariableRefNode();
+    /**
+     * @brief Constructs a VariableRefNode object with the given @a name.
+     * @param[in] name The name of the variable without the dollar sign.
+     */
+    VariableRefNode(const String& name);
+    /**
+     * @brief Calls the visit method of the given @a visitor with the
+     * dynamic type of the node.
+     * @param[in] visitor A visitor implementation
+     */
+    void accept(interpreter::AbstractVisitor* visitor) const override;
+    /**
+     * @brief Equality compares this node to the @a other
+     * @param[in] other The node that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const VariableRefNode& other) const;
+    /**
+     * @brief The name of the variable without the dollar sign.
+     */
+    String name;
+};
+}} // namespace jmespath::ast
+
+BOOST_FUSION_ADAPT_STRUCT(
+    jmespath::ast::VariableRefNode,
+    (jmespath::String, name)
+)
+#endif // VARIABLEREFNODE_H
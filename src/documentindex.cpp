@@ -0,0 +1,128 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "jmespath/documentindex.h"
+#include "jmespath/expression.h"
+#include "src/interpreter/interpreter.h"
+#include "src/interpreter/hashindex.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath {
+
+DocumentIndex::DocumentIndex(const Json &document,
+                             const String &arrayPath,
+                             const String &keyExpression)
+    : m_arrayPath(arrayPath),
+      m_keyExpression(keyExpression)
+{
+    const Expression path{arrayPath};
+    const Expression key{keyExpression};
+    if (path.isEmpty() || key.isEmpty())
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{});
+    }
+    // the results of custom functions might change between the evaluations
+    ast::ExpressionNode keyRoot = *key.astRoot();
+    bool callsCustomFunction = false;
+    optimizer::transformBottomUp(keyRoot, [&](ast::ExpressionNode& node) {
+        const auto* functionNode
+                = optimizer::match<ast::FunctionExpressionNode>(node);
+        callsCustomFunction = callsCustomFunction
+                || (functionNode && !interpreter::Interpreter
+                    ::isBuiltInFunction(*functionNode));
+    });
+    if (callsCustomFunction)
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{});
+    }
+
+    // the array must be a part of the document, and not a computed value
+    interpreter::Interpreter interpreter;
+    interpreter.setContext(document);
+    interpreter.visit(path.astRoot());
+    const auto* array = boost::get<interpreter::JsonRef>(
+                &interpreter.currentContextValue());
+    if (!array || !array->get().is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{});
+    }
+    m_index = std::make_shared<const interpreter::HashIndex>(
+                array->get(), std::move(keyRoot));
+    interpreter::HashIndexRegistry::add(m_index);
+}
+
+DocumentIndex::DocumentIndex(DocumentIndex &&other)
+    : m_arrayPath(std::move(other.m_arrayPath)),
+      m_keyExpression(std::move(other.m_keyExpression)),
+      m_index(std::move(other.m_index))
+{
+}
+
+DocumentIndex &DocumentIndex::operator=(DocumentIndex &&other)
+{
+    if (this != &other)
+    {
+        if (m_index)
+        {
+            interpreter::HashIndexRegistry::remove(m_index.get());
+        }
+        m_arrayPath = std::move(other.m_arrayPath);
+        m_keyExpression = std::move(other.m_keyExpression);
+        m_index = std::move(other.m_index);
+    }
+    return *this;
+}
+
+DocumentIndex::~DocumentIndex()
+{
+    if (m_index)
+    {
+        interpreter::HashIndexRegistry::remove(m_index.get());
+    }
+}
+
+const String &DocumentIndex::arrayPath() const
+{
+    return m_arrayPath;
+}
+
+const String &DocumentIndex::keyExpression() const
+{
+    return m_keyExpression;
+}
+
+bool DocumentIndex::isValid() const
+{
+    return m_index && m_index->isValid();
+}
+
+std::size_t DocumentIndex::keyCount() const
+{
+    return m_index ? m_index->keyCount() : 0;
+}
+} // namespace jmespath
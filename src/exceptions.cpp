@@ -56,4 +56,8 @@ void InvalidFunctionArgumentArity::anchor()
 void InvalidFunctionArgumentType::anchor()
 {
 }
+
+void UndefinedVariable::anchor()
+{
+}
 } // namespace jmespath
@@ -28,6 +28,9 @@
 #include "jmespath/expression.h"
 #include "src/parser/parser.h"
 #include "src/parser/grammar.h"
+#include "src/optimizer/optimizer.h"
+#include "src/optimizer/commonsubexpressioneliminator.h"
+#include "src/optimizer/adaptivelogicorderer.h"
 
 namespace jmespath {
 
@@ -53,6 +56,8 @@ Expression& Expression::operator=(const Expression &other)
     {
         m_expressionString = other.m_expressionString;
         *m_astRoot = *other.m_astRoot;
+        m_sharedSubexpressions = other.m_sharedSubexpressions;
+        m_logicOperatorProfiles = other.m_logicOperatorProfiles;
     }
     return *this;
 }
@@ -63,6 +68,8 @@ Expression& Expression::operator=(Expression &&other)
     {
         m_expressionString = std::move(other.m_expressionString);
         m_astRoot = std::move(other.m_astRoot);
+        m_sharedSubexpressions = std::move(other.m_sharedSubexpressions);
+        m_logicOperatorProfiles = std::move(other.m_logicOperatorProfiles);
     }
     return *this;
 }
@@ -82,6 +89,25 @@ const ast::ExpressionNode *Expression::astRoot() const
     return m_astRoot.get();
 }
 
+const std::vector<SharedSubexpression> &
+Expression::sharedSubexpressions() const
+{
+    return m_sharedSubexpressions;
+}
+
+std::vector<LogicOperatorOrder> Expression::logicOperatorOrders() const
+{
+    std::vector<LogicOperatorOrder> result;
+    result.reserve(m_logicOperatorProfiles.size());
+    for (const auto& profile: m_logicOperatorProfiles)
+    {
+        result.push_back({profile.first,
+                          profile.second->isSwapped(),
+                          profile.second->sampleCount()});
+    }
+    return result;
+}
+
 void Expression::parseExpression(const String& expressionString)
 {
     if (!m_astRoot)
@@ -93,6 +119,59 @@ void Expression::parseExpression(const String& expressionString)
      thread_local parser::Parser<parser::Grammar> s_parser;
 #pragma clang diagnostic pop
     *m_astRoot = s_parser.parse(expressionString);
+    // rewrite the AST into an equivalent one which can be evaluated faster
+    m_sharedSubexpressions.clear();
+    if (optimizer::Optimizer::isEnabled())
+    {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+        thread_local optimizer::Optimizer s_optimizer;
+#pragma clang diagnostic pop
+        s_optimizer.optimize(*m_astRoot);
+        const auto* eliminator = s_optimizer.findPass<
+                optimizer::CommonSubexpressionEliminator>();
+        if (eliminator)
+        {
+            m_sharedSubexpressions = eliminator->sharedSubexpressions();
+        }
+    }
+    // profile the logic operators whose operands can be evaluated in either
+    // order, after the optimizer, since the rewritten expressions might
+    // change the operators
+    m_logicOperatorProfiles.clear();
+    if (optimizer::AdaptiveLogicOrderer::isEnabled())
+    {
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+        thread_local optimizer::AdaptiveLogicOrderer s_orderer;
+#pragma clang diagnostic pop
+        s_orderer.run(*m_astRoot);
+        for (const auto& profiledOperator: s_orderer.profiledOperators())
+        {
+            m_logicOperatorProfiles.emplace_back(profiledOperator.expression,
+                                                 profiledOperator.profile);
+        }
+    }
+}
+
+void setOptimizerEnabled(bool enabled)
+{
+    optimizer::Optimizer::setEnabled(enabled);
+}
+
+bool isOptimizerEnabled()
+{
+    return optimizer::Optimizer::isEnabled();
+}
+
+void setAdaptiveLogicOrderEnabled(bool enabled)
+{
+    optimizer::AdaptiveLogicOrderer::setEnabled(enabled);
+}
+
+bool isAdaptiveLogicOrderEnabled()
+{
+    return optimizer::AdaptiveLogicOrderer::isEnabled();
 }
 
 bool Expression::operator==(const Expression &other) const
@@ -56,6 +56,9 @@ class CurrentNode;
 class FilterExpressionNode;
 class FunctionExpressionNode;
 class ExpressionArgumentNode;
+class VariableRefNode;
+class LetExpressionNode;
+class PathNode;
 }} // namespace jmespath::ast
 
 /**
@@ -105,6 +108,9 @@ public:
     virtual void visit(const ast::FilterExpressionNode* node) = 0;
     virtual void visit(const ast::FunctionExpressionNode* node) = 0;
     virtual void visit(const ast::ExpressionArgumentNode* node) = 0;
+    virtual void visit(const ast::VariableRefNode* node) = 0;
+    virtual void visit(const ast::LetExpressionNode* node) = 0;
+    virtual void visit(const ast::PathNode* node) = 0;
     /** @}*/
 };
 }} // namespace jmespath::interpreter
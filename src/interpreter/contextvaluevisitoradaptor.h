@@ -34,6 +34,45 @@
 
 namespace jmespath{ namespace interpreter {
 
+/**
+ * @brief Replaces the array or object container of @a value with its own
+ * copy if the container is shared with other values or it's a view.
+ *
+ * Copies of @ref Json arrays and objects share their containers, so the
+ * container must be detached before the value is modified or its items are
+ * moved, otherwise the values sharing the container would change as well.
+ * Only the container itself gets copied, the items keep sharing their own
+ * containers.
+ * @param[in] value A @ref Json value.
+ */
+inline void detachSharedContainer(Json& value)
+{
+    if (value.is_array())
+    {
+        const auto& array = value.get_ref<const Json::array_t&>();
+        if (!array.unique())
+        {
+            value = Json(Json::array_t(array.cbegin(), array.cend()));
+        }
+    }
+    else if (value.is_object())
+    {
+        const auto& object = value.get_ref<const Json::object_t&>();
+        if (!object.unique())
+        {
+            value = Json(Json::object_t(object.cbegin(), object.cend()));
+        }
+    }
+}
+
+/**
+ * @brief Overload for values accessed through const references, which are
+ * never modified, so their containers don't have to be detached.
+ */
+inline void detachSharedContainer(const Json&)
+{
+}
+
 /**
  * @brief The ContextValueVisitorAdaptor class adapts a visitor object,
  * which is callable with const lvalue reference of @ref Json and with rvalue
@@ -57,14 +96,17 @@ public:
 
     /**
      * @brief Calls the visitor object with the rvalue reference of the copy
-     * of the object to which @a value refers to.
+     * of the object to which @a value refers to, which doesn't share its
+     * container with the original object.
      * @param[in] value A @ref JsonRef value.
      */
     template <typename T>
     std::enable_if_t<std::is_same<T, JsonRef>::value && ForceMove, void>
     operator()(const T& value)
     {
-        m_visitor(Json(value.get()));
+        Json copy(value.get());
+        detachSharedContainer(copy);
+        m_visitor(std::move(copy));
     }
 
     /**
@@ -80,11 +122,13 @@ public:
     }
 
     /**
-     * @brief Calls the visitor object with the rvalue reference of @a value.
+     * @brief Calls the visitor object with the rvalue reference of @a value,
+     * after detaching its container if it's shared with other values.
      * @param[in] value A @ref Json value.
      */
     void operator()(Json& value)
     {
+        detachSharedContainer(value);
         m_visitor(std::move(value));
     }
 
@@ -101,17 +145,27 @@ private:
  * @ref Json reference held by the @ref ContextValue or calls the @a rvalueFunc
  * callable with an rvalue ref of the @ref Json object held by
  * @ref ContextValue.
+ *
+ * The callables are stored without type erasure, so creating the visitor
+ * doesn't allocate memory.
  * @param[in] lvalueFunc A callable taking a const lvalue reference to Json.
  * @param[in] rvalueFunc A callable taking an rvalue reference to Json.
+ * @tparam LvalueFuncT The type of @a lvalueFunc.
+ * @tparam RvalueFuncT The type of @a rvalueFunc.
  * @return A visitor object which accepts @ref ContextValue objects
  */
-inline decltype(auto) makeVisitor(
-    std::function<void(const Json&)> &&lvalueFunc,
-    std::function<void(Json&&)> &&rvalueFunc)
+template <typename LvalueFuncT, typename RvalueFuncT>
+inline decltype(auto) makeVisitor(LvalueFuncT&& lvalueFunc,
+                                  RvalueFuncT&& rvalueFunc)
 {
     auto functions = boost::hana::overload_linearly(
-        std::move(rvalueFunc),
-        std::move(lvalueFunc)
+        [rvalueFunc = std::forward<RvalueFuncT>(rvalueFunc)](Json&& value) {
+            rvalueFunc(std::move(value));
+        },
+        [lvalueFunc = std::forward<LvalueFuncT>(lvalueFunc)](
+                const Json& value) {
+            lvalueFunc(value);
+        }
     );
     return ContextValueVisitorAdaptor<decltype(functions)>{
         std::move(functions)
@@ -125,13 +179,18 @@ inline decltype(auto) makeVisitor(
  * ref of the copy of the object to which the @ref Json reference points in the
  * @ref ContextValue object.
  * @param[in] rvalueFunc A callable taking an rvalue reference to @ref Json.
+ * @tparam RvalueFuncT The type of @a rvalueFunc.
  * @return A visitor object which accepts @ref ContextValue objects
  */
-inline decltype(auto) makeMoveOnlyVisitor(
-        std::function<void(Json&&)> rvalueFunc)
+template <typename RvalueFuncT>
+inline decltype(auto) makeMoveOnlyVisitor(RvalueFuncT&& rvalueFunc)
 {
-    auto result = ContextValueVisitorAdaptor<decltype(rvalueFunc), true>{
-        std::move(rvalueFunc)
+    auto function = [rvalueFunc = std::forward<RvalueFuncT>(rvalueFunc)](
+            Json&& value) {
+        rvalueFunc(std::move(value));
+    };
+    auto result = ContextValueVisitorAdaptor<decltype(function), true>{
+        std::move(function)
     };
     return result;
 }
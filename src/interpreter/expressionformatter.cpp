@@ -0,0 +1,362 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/expressionformatter.h"
+#include "src/interpreter/jsonserializer.h"
+#include "src/ast/allnodes.h"
+#include <algorithm>
+
+namespace jmespath { namespace interpreter {
+
+String ExpressionFormatter::format(const ast::ExpressionNode &expression)
+{
+    m_text.clear();
+    visit(&expression);
+    return std::move(m_text);
+}
+
+void ExpressionFormatter::visit(const ast::AbstractNode *node)
+{
+    node->accept(this);
+}
+
+void ExpressionFormatter::visit(const ast::ExpressionNode *node)
+{
+    node->accept(this);
+}
+
+void ExpressionFormatter::visit(const ast::IdentifierNode *node)
+{
+    appendIdentifier(node->identifier);
+}
+
+void ExpressionFormatter::visit(const ast::RawStringNode *node)
+{
+    m_text.push_back('\'');
+    // escape the apostrophes, every other character is taken literally
+    for (auto character: node->rawString)
+    {
+        if (character == '\'')
+        {
+            m_text.push_back('\\');
+        }
+        m_text.push_back(character);
+    }
+    m_text.push_back('\'');
+}
+
+void ExpressionFormatter::visit(const ast::LiteralNode *node)
+{
+    m_text.push_back('`');
+    // escape the grave accents, every other character is taken literally
+    for (auto character: node->literal)
+    {
+        if (character == '`')
+        {
+            m_text.push_back('\\');
+        }
+        m_text.push_back(character);
+    }
+    m_text.push_back('`');
+}
+
+void ExpressionFormatter::visit(const ast::SubexpressionNode *node)
+{
+    appendBinaryExpression(node, ".");
+}
+
+void ExpressionFormatter::visit(const ast::IndexExpressionNode *node)
+{
+    visit(&node->leftExpression);
+    visit(&node->bracketSpecifier);
+    appendProjectedExpression(node->rightExpression);
+}
+
+void ExpressionFormatter::visit(const ast::ArrayItemNode *node)
+{
+    m_text += "[" + node->index.str() + "]";
+}
+
+void ExpressionFormatter::visit(const ast::PathNode *node)
+{
+    for (auto it = node->segments.cbegin(); it != node->segments.cend(); ++it)
+    {
+        if (const auto* key = boost::get<String>(&*it))
+        {
+            // every key except the first one is separated by a dot
+            if (it != node->segments.cbegin())
+            {
+                m_text.push_back('.');
+            }
+            appendIdentifier(*key);
+        }
+        else
+        {
+            m_text += "[" + std::to_string(boost::get<std::int64_t>(*it))
+                    + "]";
+        }
+    }
+}
+
+void ExpressionFormatter::visit(const ast::FlattenOperatorNode *)
+{
+    m_text += "[]";
+}
+
+void ExpressionFormatter::visit(const ast::BracketSpecifierNode *node)
+{
+    node->accept(this);
+}
+
+void ExpressionFormatter::visit(const ast::SliceExpressionNode *node)
+{
+    m_text.push_back('[');
+    if (node->start)
+    {
+        m_text += node->start->str();
+    }
+    m_text.push_back(':');
+    if (node->stop)
+    {
+        m_text += node->stop->str();
+    }
+    if (node->step)
+    {
+        m_text += ":" + node->step->str();
+    }
+    m_text.push_back(']');
+}
+
+void ExpressionFormatter::visit(const ast::ListWildcardNode *)
+{
+    m_text += "[*]";
+}
+
+void ExpressionFormatter::visit(const ast::HashWildcardNode *node)
+{
+    // the wildcard is separated from a left side expression with a dot
+    if (!node->leftExpression.isNull())
+    {
+        visit(&node->leftExpression);
+        m_text.push_back('.');
+    }
+    m_text.push_back('*');
+    appendProjectedExpression(node->rightExpression);
+}
+
+void ExpressionFormatter::visit(const ast::MultiselectListNode *node)
+{
+    m_text.push_back('[');
+    for (auto it = node->expressions.cbegin();
+         it != node->expressions.cend();
+         ++it)
+    {
+        if (it != node->expressions.cbegin())
+        {
+            m_text += ", ";
+        }
+        visit(&*it);
+    }
+    m_text.push_back(']');
+}
+
+void ExpressionFormatter::visit(const ast::MultiselectHashNode *node)
+{
+    m_text.push_back('{');
+    for (auto it = node->expressions.cbegin();
+         it != node->expressions.cend();
+         ++it)
+    {
+        if (it != node->expressions.cbegin())
+        {
+            m_text += ", ";
+        }
+        appendIdentifier(it->first.identifier);
+        m_text += ": ";
+        visit(&it->second);
+    }
+    m_text.push_back('}');
+}
+
+void ExpressionFormatter::visit(const ast::NotExpressionNode *node)
+{
+    m_text.push_back('!');
+    visit(&node->expression);
+}
+
+void ExpressionFormatter::visit(const ast::ComparatorExpressionNode *node)
+{
+    using Comparator = ast::ComparatorExpressionNode::Comparator;
+
+    const char* separator = "";
+    switch (node->comparator)
+    {
+    case Comparator::Less: separator = " < "; break;
+    case Comparator::LessOrEqual: separator = " <= "; break;
+    case Comparator::Equal: separator = " == "; break;
+    case Comparator::GreaterOrEqual: separator = " >= "; break;
+    case Comparator::Greater: separator = " > "; break;
+    case Comparator::NotEqual: separator = " != "; break;
+    case Comparator::Unknown: break;
+    }
+    appendBinaryExpression(node, separator);
+}
+
+void ExpressionFormatter::visit(const ast::OrExpressionNode *node)
+{
+    appendBinaryExpression(node, " || ");
+}
+
+void ExpressionFormatter::visit(const ast::AndExpressionNode *node)
+{
+    appendBinaryExpression(node, " && ");
+}
+
+void ExpressionFormatter::visit(const ast::ParenExpressionNode *node)
+{
+    m_text.push_back('(');
+    visit(&node->expression);
+    m_text.push_back(')');
+}
+
+void ExpressionFormatter::visit(const ast::PipeExpressionNode *node)
+{
+    appendBinaryExpression(node, " | ");
+}
+
+void ExpressionFormatter::visit(const ast::CurrentNode *)
+{
+    m_text.push_back('@');
+}
+
+void ExpressionFormatter::visit(const ast::FilterExpressionNode *node)
+{
+    m_text += "[?";
+    visit(&node->expression);
+    m_text.push_back(']');
+}
+
+void ExpressionFormatter::visit(const ast::FunctionExpressionNode *node)
+{
+    m_text += node->functionName;
+    m_text.push_back('(');
+    for (auto it = node->arguments.cbegin();
+         it != node->arguments.cend();
+         ++it)
+    {
+        if (it != node->arguments.cbegin())
+        {
+            m_text += ", ";
+        }
+        if (const auto* expression = boost::get<ast::ExpressionNode>(&*it))
+        {
+            visit(expression);
+        }
+        else if (const auto* argument
+                 = boost::get<ast::ExpressionArgumentNode>(&*it))
+        {
+            visit(argument);
+        }
+    }
+    m_text.push_back(')');
+}
+
+void ExpressionFormatter::visit(const ast::ExpressionArgumentNode *node)
+{
+    m_text.push_back('&');
+    visit(&node->expression);
+}
+
+void ExpressionFormatter::visit(const ast::VariableRefNode *node)
+{
+    m_text += "$" + node->name;
+}
+
+void ExpressionFormatter::visit(const ast::LetExpressionNode *node)
+{
+    m_text += "let ";
+    for (auto it = node->bindings.cbegin(); it != node->bindings.cend(); ++it)
+    {
+        if (it != node->bindings.cbegin())
+        {
+            m_text += ", ";
+        }
+        visit(&it->first);
+        m_text += " = ";
+        visit(&it->second);
+    }
+    m_text += " in ";
+    visit(&node->expression);
+}
+
+void ExpressionFormatter::appendIdentifier(const String &identifier)
+{
+    // an unquoted string starts with a letter or an underscore, which can be
+    // followed by letters, digits and underscores
+    auto isUnquotedChar = [](char character) {
+        return ((character >= 'A') && (character <= 'Z'))
+                || ((character >= 'a') && (character <= 'z'))
+                || (character == '_')
+                || ((character >= '0') && (character <= '9'));
+    };
+    if (!identifier.empty()
+        && !((identifier.front() >= '0') && (identifier.front() <= '9'))
+        && std::all_of(identifier.cbegin(), identifier.cend(),
+                       isUnquotedChar))
+    {
+        m_text += identifier;
+    }
+    // otherwise write the identifier as a quoted JSON string
+    else
+    {
+        appendJson(m_text, Json(identifier));
+    }
+}
+
+void ExpressionFormatter::appendProjectedExpression(
+        const ast::ExpressionNode &expression)
+{
+    // a projected subexpression starts with a dot since its left side is
+    // empty, while a path which starts with a key has to be preceded by one
+    const auto* pathNode = boost::get<ast::PathNode>(&expression.value);
+    if (pathNode && !pathNode->segments.empty()
+        && boost::get<String>(&pathNode->segments.front()))
+    {
+        m_text.push_back('.');
+    }
+    visit(&expression);
+}
+
+void ExpressionFormatter::appendBinaryExpression(
+        const ast::BinaryExpressionNode *node,
+        const char *separator)
+{
+    visit(&node->leftExpression);
+    m_text += separator;
+    visit(&node->rightExpression);
+}
+}} // namespace jmespath::interpreter
@@ -0,0 +1,121 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef EXPRESSIONFORMATTER_H
+#define EXPRESSIONFORMATTER_H
+#include "src/interpreter/abstractvisitor.h"
+#include "jmespath/types.h"
+
+namespace jmespath { namespace ast {
+
+class ExpressionNode;
+class BinaryExpressionNode;
+}} // namespace jmespath::ast
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The ExpressionFormatter class converts an AST back into the text of
+ * a JMESPath expression.
+ *
+ * Parsing the text of an AST produced by the parser results in an equal AST.
+ * Parentheses are emitted only where the AST contains a parenthesized
+ * expression, and identifiers are quoted only if they can't be written as
+ * unquoted strings.
+ */
+class ExpressionFormatter : public AbstractVisitor
+{
+public:
+    /**
+     * @brief Converts the @a expression into JMESPath text.
+     * @param[in] expression The expression which should be formatted.
+     * @return The text of the expression.
+     */
+    String format(const ast::ExpressionNode& expression);
+
+    /**
+     * @brief Appends the text of the given @a node to the result.
+     * @param[in] node Pointer to the node
+     * @{
+     */
+    void visit(const ast::AbstractNode *node) override;
+    void visit(const ast::ExpressionNode *node) override;
+    void visit(const ast::IdentifierNode *node) override;
+    void visit(const ast::RawStringNode *node) override;
+    void visit(const ast::LiteralNode* node) override;
+    void visit(const ast::SubexpressionNode* node) override;
+    void visit(const ast::IndexExpressionNode* node) override;
+    void visit(const ast::ArrayItemNode* node) override;
+    void visit(const ast::FlattenOperatorNode*) override;
+    void visit(const ast::BracketSpecifierNode* node) override;
+    void visit(const ast::SliceExpressionNode* node) override;
+    void visit(const ast::ListWildcardNode*) override;
+    void visit(const ast::HashWildcardNode* node) override;
+    void visit(const ast::MultiselectListNode* node) override;
+    void visit(const ast::MultiselectHashNode* node) override;
+    void visit(const ast::NotExpressionNode* node) override;
+    void visit(const ast::ComparatorExpressionNode* node) override;
+    void visit(const ast::OrExpressionNode* node) override;
+    void visit(const ast::AndExpressionNode* node) override;
+    void visit(const ast::ParenExpressionNode* node) override;
+    void visit(const ast::PipeExpressionNode* node) override;
+    void visit(const ast::CurrentNode*) override;
+    void visit(const ast::FilterExpressionNode* node) override;
+    void visit(const ast::FunctionExpressionNode* node) override;
+    void visit(const ast::ExpressionArgumentNode* node) override;
+    void visit(const ast::VariableRefNode* node) override;
+    void visit(const ast::LetExpressionNode* node) override;
+    void visit(const ast::PathNode* node) override;
+    /** @}*/
+
+private:
+    /**
+     * @brief The text of the expression formatted so far.
+     */
+    String m_text;
+    /**
+     * @brief Appends the given @a identifier, enclosed in quotes if it's not
+     * a valid unquoted string.
+     * @param[in] identifier The identifier.
+     */
+    void appendIdentifier(const String& identifier);
+    /**
+     * @brief Appends the projected right side @a expression of a projection.
+     * @param[in] expression The projected expression.
+     */
+    void appendProjectedExpression(const ast::ExpressionNode& expression);
+    /**
+     * @brief Appends the left and right side expressions of the binary
+     * @a node separated by the given @a separator.
+     * @param[in] node Pointer to the node.
+     * @param[in] separator The text of the operator.
+     */
+    void appendBinaryExpression(const ast::BinaryExpressionNode* node,
+                                const char* separator);
+};
+}} // namespace jmespath::interpreter
+#endif // EXPRESSIONFORMATTER_H
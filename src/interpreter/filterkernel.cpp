@@ -0,0 +1,378 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/filterkernel.h"
+#include <functional>
+#include <limits>
+
+namespace jmespath { namespace interpreter {
+
+namespace {
+
+/**
+ * @brief The kinds of the values stored in a column.
+ */
+enum Kind : std::uint8_t
+{
+    OtherKind,
+    NullKind,
+    FalseKind,
+    TrueKind,
+    IntegerKind,
+    FloatKind,
+    StringKind
+};
+
+/**
+ * @brief Finds the field selected by the given @a path in the @a item.
+ * @param[in] item The item of the array.
+ * @param[in] path The keys and indices which select the field.
+ * @return Returns a pointer to the field or nullptr if it doesn't exist.
+ */
+const Json* findField(const Json& item, const FilterKernel::PathType& path)
+{
+    const Json* value = &item;
+    for (const auto& segment: path)
+    {
+        if (const auto* key = boost::get<String>(&segment))
+        {
+            if (!value->is_object())
+            {
+                return nullptr;
+            }
+            auto it = value->find(*key);
+            if (it == value->end())
+            {
+                return nullptr;
+            }
+            value = &*it;
+        }
+        else
+        {
+            if (!value->is_array())
+            {
+                return nullptr;
+            }
+            auto length = static_cast<std::int64_t>(value->size());
+            std::int64_t index = boost::get<std::int64_t>(segment);
+            if (index < 0)
+            {
+                index += length;
+            }
+            if ((index < 0) || (index >= length))
+            {
+                return nullptr;
+            }
+            value = &(*value)[static_cast<std::size_t>(index)];
+        }
+    }
+    return value;
+}
+
+/**
+ * @brief Checks whether the given number @a value can be compared as a
+ * signed 64-bit integer or as a floating point number.
+ * @param[in] value A @ref Json number.
+ * @return Returns true if the number is supported, otherwise false.
+ */
+bool isSupportedNumber(const Json& value)
+{
+    return !value.is_number_unsigned()
+            || (value.get<std::uint64_t>() <= static_cast<std::uint64_t>(
+                    std::numeric_limits<std::int64_t>::max()));
+}
+
+/**
+ * @brief Combines the results of comparing the numbers of a column with the
+ * @a constant into the @a mask.
+ * @param[in] kinds The kinds of the values of the column.
+ * @param[in] integers The integer values of the column.
+ * @param[in] floats The floating point values of the column.
+ * @param[in] constant The number which the values are compared to.
+ * @param[in] compare The comparison operator.
+ * @param[in] negate Whether the results of the comparisons should be
+ * negated, including the results of the non numbers.
+ * @param[in,out] mask The selection mask.
+ */
+template <typename Compare>
+void compareNumbers(const std::vector<std::uint8_t>& kinds,
+                    const std::vector<std::int64_t>& integers,
+                    const std::vector<double>& floats,
+                    const Json& constant,
+                    Compare compare,
+                    bool negate,
+                    std::vector<std::uint8_t>& mask)
+{
+    const std::size_t size = mask.size();
+    const auto flip = static_cast<std::uint8_t>(negate);
+    // integers are compared to floating point constants as floating point
+    // numbers
+    if (constant.is_number_float())
+    {
+        const double value = constant.get<double>();
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            bool isNumber = (kinds[i] == IntegerKind)
+                    | (kinds[i] == FloatKind);
+            mask[i] &= static_cast<std::uint8_t>(
+                        isNumber & compare(floats[i], value)) ^ flip;
+        }
+        return;
+    }
+    // integers are compared to integer constants as integers, and floating
+    // point numbers as floating point numbers
+    const auto value = constant.get<std::int64_t>();
+    const auto floatValue = static_cast<double>(value);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        bool integerResult = (kinds[i] == IntegerKind)
+                & compare(integers[i], value);
+        bool floatResult = (kinds[i] == FloatKind)
+                & compare(floats[i], floatValue);
+        mask[i] &= static_cast<std::uint8_t>(
+                    integerResult | floatResult) ^ flip;
+    }
+}
+
+/**
+ * @brief Combines the results of comparing the kinds of the values of a
+ * column with the given @a kind into the @a mask.
+ * @param[in] kinds The kinds of the values of the column.
+ * @param[in] kind The kind which the values are compared to.
+ * @param[in] negate Whether the results of the comparisons should be
+ * negated.
+ * @param[in,out] mask The selection mask.
+ */
+void compareKinds(const std::vector<std::uint8_t>& kinds,
+                  std::uint8_t kind,
+                  bool negate,
+                  std::vector<std::uint8_t>& mask)
+{
+    const std::size_t size = mask.size();
+    const auto flip = static_cast<std::uint8_t>(negate);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        mask[i] &= static_cast<std::uint8_t>(kinds[i] == kind) ^ flip;
+    }
+}
+
+/**
+ * @brief Combines the results of comparing the strings of a column with the
+ * @a constant into the @a mask.
+ * @param[in] strings The string values of the column.
+ * @param[in] constant The string which the values are compared to.
+ * @param[in] negate Whether the results of the comparisons should be
+ * negated.
+ * @param[in,out] mask The selection mask.
+ */
+void compareStrings(const std::vector<const String*>& strings,
+                    const String& constant,
+                    bool negate,
+                    std::vector<std::uint8_t>& mask)
+{
+    const std::size_t size = mask.size();
+    const auto flip = static_cast<std::uint8_t>(negate);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        // only compare the strings of the items which are still selected
+        if (mask[i] != 0)
+        {
+            bool equal = strings[i] && (*strings[i] == constant);
+            mask[i] = static_cast<std::uint8_t>(equal) ^ flip;
+        }
+    }
+}
+} // anonymous namespace
+
+const std::vector<std::uint8_t> &FilterKernel::Workspace::mask() const
+{
+    return m_mask;
+}
+
+bool FilterKernel::isSupported(const Predicate &predicate)
+{
+    const Json& constant = predicate.constant;
+    switch (predicate.comparator)
+    {
+    case Comparator::Equal:
+    case Comparator::NotEqual:
+        return constant.is_null() || constant.is_boolean()
+                || constant.is_string()
+                || (constant.is_number() && isSupportedNumber(constant));
+    case Comparator::Less:
+    case Comparator::LessOrEqual:
+    case Comparator::GreaterOrEqual:
+    case Comparator::Greater:
+        return constant.is_number() && isSupportedNumber(constant);
+    case Comparator::Unknown:
+        break;
+    }
+    return false;
+}
+
+FilterKernel::FilterKernel(std::vector<Predicate> predicates)
+    : m_predicates(std::move(predicates))
+{
+}
+
+const std::vector<FilterKernel::Predicate> &FilterKernel::predicates() const
+{
+    return m_predicates;
+}
+
+bool FilterKernel::select(const Json &array, Workspace &workspace) const
+{
+    const std::size_t size = array.size();
+    workspace.m_mask.assign(size, 1);
+    for (const auto& predicate: m_predicates)
+    {
+        const Json& constant = predicate.constant;
+        const bool isNumeric = constant.is_number();
+        const bool isString = constant.is_string();
+        // extract the compared field of the items into a typed column
+        workspace.m_kinds.resize(size);
+        if (isNumeric)
+        {
+            workspace.m_integers.resize(size);
+            workspace.m_floats.resize(size);
+        }
+        if (isString)
+        {
+            workspace.m_strings.resize(size);
+        }
+        std::size_t i = 0;
+        for (const auto& item: array)
+        {
+            const Json* value = findField(item, predicate.path);
+            std::uint8_t kind = NullKind;
+            std::int64_t integer = 0;
+            double floatValue = 0.0;
+            const String* string = nullptr;
+            if (value)
+            {
+                switch (value->type())
+                {
+                case Json::value_t::null:
+                    break;
+                case Json::value_t::boolean:
+                    kind = value->get<bool>() ? TrueKind : FalseKind;
+                    break;
+                case Json::value_t::number_unsigned:
+                    if (!isSupportedNumber(*value))
+                    {
+                        return false;
+                    }
+                    kind = IntegerKind;
+                    integer = value->get<std::int64_t>();
+                    floatValue = static_cast<double>(integer);
+                    break;
+                case Json::value_t::number_integer:
+                    kind = IntegerKind;
+                    integer = value->get<std::int64_t>();
+                    floatValue = static_cast<double>(integer);
+                    break;
+                case Json::value_t::number_float:
+                    kind = FloatKind;
+                    floatValue = value->get<double>();
+                    break;
+                case Json::value_t::string:
+                    kind = StringKind;
+                    string = &value->get_ref<const String&>();
+                    break;
+                default:
+                    kind = OtherKind;
+                    break;
+                }
+            }
+            workspace.m_kinds[i] = kind;
+            if (isNumeric)
+            {
+                workspace.m_integers[i] = integer;
+                workspace.m_floats[i] = floatValue;
+            }
+            if (isString)
+            {
+                workspace.m_strings[i] = string;
+            }
+            ++i;
+        }
+
+        // compare the column to the constant
+        const bool negate = (predicate.comparator == Comparator::NotEqual);
+        if (isNumeric)
+        {
+            const auto& kinds = workspace.m_kinds;
+            const auto& integers = workspace.m_integers;
+            const auto& floats = workspace.m_floats;
+            auto& mask = workspace.m_mask;
+            switch (predicate.comparator)
+            {
+            case Comparator::Less:
+                compareNumbers(kinds, integers, floats, constant,
+                               std::less<>{}, false, mask);
+                break;
+            case Comparator::LessOrEqual:
+                compareNumbers(kinds, integers, floats, constant,
+                               std::less_equal<>{}, false, mask);
+                break;
+            case Comparator::GreaterOrEqual:
+                compareNumbers(kinds, integers, floats, constant,
+                               std::greater_equal<>{}, false, mask);
+                break;
+            case Comparator::Greater:
+                compareNumbers(kinds, integers, floats, constant,
+                               std::greater<>{}, false, mask);
+                break;
+            default:
+                compareNumbers(kinds, integers, floats, constant,
+                               std::equal_to<>{}, negate, mask);
+                break;
+            }
+        }
+        else if (isString)
+        {
+            compareStrings(workspace.m_strings,
+                           constant.get_ref<const String&>(),
+                           negate,
+                           workspace.m_mask);
+        }
+        else if (constant.is_boolean())
+        {
+            compareKinds(workspace.m_kinds,
+                         constant.get<bool>() ? TrueKind : FalseKind,
+                         negate,
+                         workspace.m_mask);
+        }
+        else
+        {
+            compareKinds(workspace.m_kinds, NullKind, negate,
+                         workspace.m_mask);
+        }
+    }
+    return true;
+}
+}} // namespace jmespath::interpreter
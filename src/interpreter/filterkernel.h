@@ -0,0 +1,164 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef FILTERKERNEL_H
+#define FILTERKERNEL_H
+#include "jmespath/types.h"
+#include "src/ast/pathnode.h"
+#include "src/ast/comparatorexpressionnode.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The FilterKernel class evaluates a filter condition, which is a
+ * conjunction of comparisons between fields and constants, on all the items
+ * of an array at once.
+ *
+ * For every comparison the compared field of the items is extracted into a
+ * typed column first, then the column is compared to the constant in a tight
+ * loop without branches, which the compiler can vectorize, and the results
+ * are combined into a selection mask. The comparisons give the same results
+ * as the interpreter, numbers are compared as integers if both of them are
+ * integers and as floating point numbers otherwise, and ordering comparisons
+ * are false for non numbers.
+ */
+class FilterKernel
+{
+public:
+    /**
+     * @brief The type of the comparison operators.
+     */
+    using Comparator = ast::ComparatorExpressionNode::Comparator;
+    /**
+     * @brief The type of the segments of the compared fields.
+     */
+    using PathType = std::vector<ast::PathNode::SegmentType>;
+    /**
+     * @brief The Predicate struct describes the comparison of a field of the
+     * items with a constant.
+     */
+    struct Predicate
+    {
+        /**
+         * @brief The keys and indices which select the field of an item.
+         *
+         * An empty path selects the item itself.
+         */
+        PathType path;
+        /**
+         * @brief The comparison operator, with the field on its left side.
+         */
+        Comparator comparator;
+        /**
+         * @brief The constant which the field is compared to.
+         */
+        Json constant;
+    };
+    /**
+     * @brief The Workspace class stores the columns and the selection mask
+     * of an evaluation, so their buffers can be reused by later evaluations.
+     */
+    class Workspace
+    {
+    public:
+        /**
+         * @brief Returns the selection mask of the last evaluation, which
+         * has a non zero value for the selected items.
+         * @return The selection mask.
+         */
+        const std::vector<std::uint8_t>& mask() const;
+
+    private:
+        friend class FilterKernel;
+        /**
+         * @brief The selection mask.
+         */
+        std::vector<std::uint8_t> m_mask;
+        /**
+         * @brief The kinds of the values of the column.
+         */
+        std::vector<std::uint8_t> m_kinds;
+        /**
+         * @brief The integer values of the column.
+         */
+        std::vector<std::int64_t> m_integers;
+        /**
+         * @brief The floating point values of the column, which are also set
+         * for integers.
+         */
+        std::vector<double> m_floats;
+        /**
+         * @brief The string values of the column, or nullptr for non
+         * strings.
+         */
+        std::vector<const String*> m_strings;
+    };
+
+    /**
+     * @brief Checks whether the given @a predicate can be evaluated by a
+     * kernel.
+     *
+     * Equality comparisons with null, boolean, number and string constants,
+     * and ordering comparisons with numbers are supported, except for
+     * integers which are too large to be represented as signed 64-bit
+     * integers.
+     * @param[in] predicate The predicate which should be checked.
+     * @return Returns true if the predicate is supported, otherwise false.
+     */
+    static bool isSupported(const Predicate& predicate);
+    /**
+     * @brief Constructs a FilterKernel object which selects the items
+     * satisfying all the given @a predicates.
+     * @param[in] predicates The supported predicates of the conjunction.
+     */
+    explicit FilterKernel(std::vector<Predicate> predicates);
+    /**
+     * @brief Returns the predicates of the conjunction.
+     */
+    const std::vector<Predicate>& predicates() const;
+    /**
+     * @brief Evaluates the predicates on the items of the given @a array and
+     * stores the selection mask in the @a workspace.
+     * @param[in] array A @ref Json array.
+     * @param[in,out] workspace The workspace of the evaluation.
+     * @return Returns false if a compared field holds an integer which can't
+     * be represented as a signed 64-bit integer, in which case the selection
+     * mask is not valid, otherwise true.
+     */
+    bool select(const Json& array, Workspace& workspace) const;
+
+private:
+    /**
+     * @brief The predicates of the conjunction.
+     */
+    std::vector<Predicate> m_predicates;
+};
+}} // namespace jmespath::interpreter
+#endif // FILTERKERNEL_H
@@ -0,0 +1,211 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/hashindex.h"
+#include "src/interpreter/interpreter.h"
+#include "src/ast/allnodes.h"
+#include "jmespath/exceptions.h"
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <unordered_map>
+
+namespace jmespath { namespace interpreter {
+
+namespace {
+
+/**
+ * @brief The Registry struct stores the registered indexes.
+ */
+struct Registry
+{
+    /**
+     * @brief Protects the @ref indexes.
+     */
+    std::mutex mutex;
+    /**
+     * @brief The registered indexes by the identifiers of their containers.
+     */
+    std::unordered_multimap<const void*, std::shared_ptr<const HashIndex>>
+        indexes;
+    /**
+     * @brief The number of registered indexes, which can be read without
+     * locking the @ref mutex.
+     */
+    std::atomic<std::size_t> size{0};
+};
+
+/**
+ * @brief Returns the registry of the indexes.
+ * @return Reference to the registry.
+ */
+Registry& registry()
+{
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+    static Registry s_registry;
+#pragma clang diagnostic pop
+    return s_registry;
+}
+} // anonymous namespace
+
+HashIndex::HashIndex(const Json &array, ast::ExpressionNode key)
+    : m_array(array),
+      m_modificationCount{0},
+      m_key(std::move(key))
+{
+    if (!m_array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{});
+    }
+    // track the modifications of the container before reading its items,
+    // so the modifications made after reading them invalidate the index
+    const auto& items = m_array.get_ref<const Json::array_t&>();
+    items.track_modifications();
+    m_modificationCount = items.modification_count();
+
+    // evaluate the key on every item
+    Interpreter interpreter;
+    std::vector<std::size_t> keyIds;
+    keyIds.reserve(items.size());
+    for (const auto& item: items)
+    {
+        interpreter.setContext(item);
+        interpreter.visit(&m_key);
+        keyIds.push_back(m_keys.insert(interpreter.currentContext()).first);
+    }
+
+    // group the positions of the items by their keys, the positions of the
+    // items with the same key remain in increasing order
+    m_offsets.assign(m_keys.size() + 1, 0);
+    for (auto keyId: keyIds)
+    {
+        ++m_offsets[keyId + 1];
+    }
+    std::partial_sum(m_offsets.begin(), m_offsets.end(), m_offsets.begin());
+    std::vector<std::size_t> nextOffsets(m_offsets.begin(),
+                                         m_offsets.end() - 1);
+    m_positions.resize(keyIds.size());
+    for (std::size_t position = 0; position < keyIds.size(); ++position)
+    {
+        m_positions[nextOffsets[keyIds[position]]++] = position;
+    }
+}
+
+const ast::ExpressionNode &HashIndex::key() const
+{
+    return m_key;
+}
+
+const void *HashIndex::containerId() const
+{
+    return m_array.get_ref<const Json::array_t&>().buffer_id();
+}
+
+bool HashIndex::isValid() const
+{
+    return m_array.get_ref<const Json::array_t&>().modification_count()
+            == m_modificationCount;
+}
+
+bool HashIndex::matches(const Json &array) const
+{
+    return array.is_array()
+            && array.get_ref<const Json::array_t&>().same_items(
+                m_array.get_ref<const Json::array_t&>())
+            && isValid();
+}
+
+HashIndex::PositionRange HashIndex::find(const Json &value) const
+{
+    auto keyPosition = m_keys.find(value);
+    if (!keyPosition.second)
+    {
+        return {};
+    }
+    const std::size_t* positions = m_positions.data();
+    return {positions + m_offsets[keyPosition.first],
+            positions + m_offsets[keyPosition.first + 1]};
+}
+
+std::size_t HashIndex::keyCount() const
+{
+    return m_keys.size();
+}
+
+void HashIndexRegistry::add(std::shared_ptr<const HashIndex> index)
+{
+    auto& indexRegistry = registry();
+    std::lock_guard<std::mutex> lock{indexRegistry.mutex};
+    const void* containerId = index->containerId();
+    indexRegistry.indexes.emplace(containerId, std::move(index));
+    indexRegistry.size = indexRegistry.indexes.size();
+}
+
+void HashIndexRegistry::remove(const HashIndex *index)
+{
+    auto& indexRegistry = registry();
+    std::lock_guard<std::mutex> lock{indexRegistry.mutex};
+    auto range = indexRegistry.indexes.equal_range(index->containerId());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (it->second.get() == index)
+        {
+            indexRegistry.indexes.erase(it);
+            break;
+        }
+    }
+    indexRegistry.size = indexRegistry.indexes.size();
+}
+
+bool HashIndexRegistry::isEmpty()
+{
+    return registry().size == 0;
+}
+
+std::shared_ptr<const HashIndex> HashIndexRegistry::find(
+        const Json &array,
+        const ast::ExpressionNode &key)
+{
+    if (!array.is_array())
+    {
+        return {};
+    }
+    auto& indexRegistry = registry();
+    std::lock_guard<std::mutex> lock{indexRegistry.mutex};
+    auto range = indexRegistry.indexes.equal_range(
+                array.get_ref<const Json::array_t&>().buffer_id());
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if ((it->second->key() == key) && it->second->matches(array))
+        {
+            return it->second;
+        }
+    }
+    return {};
+}
+}} // namespace jmespath::interpreter
@@ -0,0 +1,171 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef HASHINDEX_H
+#define HASHINDEX_H
+#include "jmespath/types.h"
+#include "src/ast/expressionnode.h"
+#include "src/interpreter/jsonhashtable.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <boost/range/iterator_range.hpp>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The HashIndex class maps the values of a key expression, evaluated
+ * on the items of an array, to the positions of the items, so the filters
+ * selecting the items with a given key can be evaluated without evaluating
+ * the key on every item.
+ *
+ * The index is tied to the container of the array. It keeps the container
+ * alive, so its identity can't be reused by another container, and tracks
+ * its modifications, so the index stops matching the array when it gets
+ * modified.
+ */
+class HashIndex
+{
+public:
+    /**
+     * @brief The type of the positions of the items with the same key.
+     */
+    using PositionRange = boost::iterator_range<const std::size_t*>;
+    /**
+     * @brief Constructs a HashIndex object by evaluating the @a key
+     * expression on every item of the @a array.
+     * @param[in] array The indexed array, which shares its container with
+     * the array of the document.
+     * @param[in] key The root of the key expression's AST.
+     * @throws InvalidAgrument If @a array is not an array.
+     */
+    HashIndex(const Json& array, ast::ExpressionNode key);
+    /**
+     * @brief Returns the key expression.
+     * @return The root of the key expression's AST.
+     */
+    const ast::ExpressionNode& key() const;
+    /**
+     * @brief Returns the identifier of the indexed container.
+     * @return The identifier of the container.
+     */
+    const void* containerId() const;
+    /**
+     * @brief Checks whether the indexed container wasn't modified since the
+     * index was built.
+     * @return Returns true if the index is still valid, otherwise false.
+     */
+    bool isValid() const;
+    /**
+     * @brief Checks whether the given @a array holds the same items of the
+     * indexed container and whether the index is still valid.
+     * @param[in] array A @ref Json value.
+     * @return Returns true if the index can be used for the @a array,
+     * otherwise false.
+     */
+    bool matches(const Json& array) const;
+    /**
+     * @brief Finds the positions of the items whose key is equal to the
+     * given @a value.
+     * @param[in] value The value of the key.
+     * @return The positions of the items in increasing order.
+     */
+    PositionRange find(const Json& value) const;
+    /**
+     * @brief Returns the number of distinct keys.
+     * @return The number of distinct keys.
+     */
+    std::size_t keyCount() const;
+
+private:
+    /**
+     * @brief The indexed array, which keeps the indexed container alive.
+     */
+    Json m_array;
+    /**
+     * @brief The modification count of the container when the index was
+     * built.
+     */
+    std::uint64_t m_modificationCount;
+    /**
+     * @brief The root of the key expression's AST.
+     */
+    ast::ExpressionNode m_key;
+    /**
+     * @brief The distinct keys of the items.
+     */
+    JsonHashTable m_keys;
+    /**
+     * @brief The start of the positions of each key in @ref m_positions,
+     * followed by the number of positions.
+     */
+    std::vector<std::size_t> m_offsets;
+    /**
+     * @brief The positions of the items grouped by their keys.
+     */
+    std::vector<std::size_t> m_positions;
+};
+
+/**
+ * @brief The HashIndexRegistry class stores the indexes which can be used by
+ * the interpreter, grouped by the identifiers of their containers.
+ *
+ * The functions of the registry are thread safe.
+ */
+class HashIndexRegistry
+{
+public:
+    /**
+     * @brief Adds the @a index to the registry.
+     * @param[in] index The index which should be added.
+     */
+    static void add(std::shared_ptr<const HashIndex> index);
+    /**
+     * @brief Removes the @a index from the registry.
+     * @param[in] index The index which should be removed.
+     */
+    static void remove(const HashIndex* index);
+    /**
+     * @brief Checks whether the registry is empty, without locking it.
+     * @return Returns true if there are no registered indexes, otherwise
+     * false.
+     */
+    static bool isEmpty();
+    /**
+     * @brief Finds a valid index of the given @a array with the given
+     * @a key expression.
+     * @param[in] array A @ref Json value.
+     * @param[in] key The root of the key expression's AST.
+     * @return The index, or nullptr if there is no such index.
+     */
+    static std::shared_ptr<const HashIndex> find(
+            const Json& array,
+            const ast::ExpressionNode& key);
+};
+}} // namespace jmespath::interpreter
+#endif // HASHINDEX_H
@@ -29,12 +29,21 @@
 #include "src/ast/allnodes.h"
 #include "jmespath/exceptions.h"
 #include "src/interpreter/contextvaluevisitoradaptor.h"
+#include "src/interpreter/typeinferrer.h"
+#include "src/interpreter/jsonhashtable.h"
+#include "src/interpreter/numericarray.h"
+#include "src/interpreter/stringkernels.h"
+#include "src/interpreter/numberconversion.h"
+#include "src/interpreter/jsonserializer.h"
+#include <algorithm>
 #include <numeric>
+#include <cstddef>
+#include <limits>
 #include <boost/range.hpp>
 #include <boost/range/algorithm.hpp>
 #include <boost/range/numeric.hpp>
+#include <boost/algorithm/cxx11/all_of.hpp>
 #include <boost/algorithm/cxx11/any_of.hpp>
-#include <boost/algorithm/string.hpp>
 #include <boost/hana.hpp>
 #include <boost/type_index.hpp>
 
@@ -45,87 +54,445 @@ namespace alg = boost::algorithm;
 
 Interpreter::Interpreter()
     : AbstractVisitor{}
+{
+}
+
+void Interpreter::resolveFunction(ast::FunctionExpressionNode &node)
+{
+    node.functionId = boost::none;
+    node.argumentTypesProven = false;
+    node.pattern.reset();
+    const auto& functionIds = Interpreter::functionIds();
+    auto it = functionIds.find(node.functionName);
+    if (it != functionIds.end())
+    {
+        const auto& descriptor = functionDescriptors()[it->second];
+        // validate that the function has been called with the appropriate
+        // number of arguments
+        validateArity(descriptor.minArity,
+                      descriptor.maxArity,
+                      node.arguments.size());
+        node.functionId = it->second;
+        // skip the runtime type checks of the function if the first argument
+        // is proven to be a comparable array
+        node.argumentTypesProven = descriptor.uncheckedFunction
+                && TypeInferrer::inferArgument(
+                    node.arguments.front()).isComparableArray();
+        // compile the constant pattern argument only once
+        if (descriptor.hasPattern)
+        {
+            node.pattern = compileConstantPattern(node.arguments[1]);
+        }
+        return;
+    }
+
+    // look up the function among the custom functions
+    auto& registry = customFunctionRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    auto customIt = registry.functionIds.find(node.functionName);
+    // leave unknown functions unresolved
+    if (customIt == registry.functionIds.end())
+    {
+        return;
+    }
+    const auto& descriptor = registry.descriptors[customIt->second];
+    validateArity(descriptor.minArity,
+                  descriptor.maxArity,
+                  node.arguments.size());
+    validateConstantArguments(node, descriptor);
+    node.functionId = functionDescriptors().size() + customIt->second;
+}
+
+bool Interpreter::isBuiltInFunction(const ast::FunctionExpressionNode &node)
+{
+    return node.functionId
+            && (*node.functionId < functionDescriptors().size());
+}
+
+void Interpreter::registerFunction(const String &name,
+                                   const FunctionSignature &signature,
+                                   CustomFunction function)
+{
+    // the function needs a name, an implementation and at least a single
+    // argument type if it's variadic
+    if (name.empty() || !function
+        || (signature.variadic && signature.argumentTypes.empty()))
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{});
+    }
+    // built in functions can't be overridden
+    if (functionIds().count(name) > 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{}
+                              << InfoFunctionName(name));
+    }
+
+    auto& registry = customFunctionRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    if (registry.functionIds.count(name) > 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidAgrument{}
+                              << InfoFunctionName(name));
+    }
+    std::size_t argumentCount = signature.argumentTypes.size();
+    std::size_t maxArity = signature.variadic
+            ? std::numeric_limits<std::size_t>::max()
+            : argumentCount;
+    registry.descriptors.push_back(CustomFunctionDescriptor{
+        name, argumentCount, maxArity, signature, std::move(function)});
+    registry.functionIds.emplace(name, registry.descriptors.size() - 1);
+}
+
+const std::vector<Interpreter::FunctionDescriptor>&
+Interpreter::functionDescriptors()
 {
     // initialize JMESPath function name to function implementation mapping
-    using std::placeholders::_1;
-    using std::bind;
-    using Descriptor = FunctionDescriptor;
-    using FunctionType = void(Interpreter::*)(FunctionArgumentList&);
-    using MaxFunctionType = void(Interpreter::*)(FunctionArgumentList&,
-                                                  const JsonComparator&);
-    auto exactlyOne = bind(std::equal_to<size_t>{}, _1, 1);
-    auto exactlyTwo = bind(std::equal_to<size_t>{}, _1, 2);
-    auto zeroOrMore = bind(std::greater_equal<size_t>{}, _1, 0);
-    auto oneOrMore = bind(std::greater_equal<size_t>{}, _1, 1);
-    auto mapPtr = static_cast<FunctionType>(&Interpreter::map);
-    auto reversePtr = static_cast<FunctionType>(&Interpreter::reverse);
-    auto sortPtr = static_cast<FunctionType>(&Interpreter::sort);
-    auto sortByPtr = static_cast<FunctionType>(&Interpreter::sortBy);
-    auto toArrayPtr = static_cast<FunctionType>(&Interpreter::toArray);
-    auto toStringPtr = static_cast<FunctionType>(&Interpreter::toString);
-    auto toNumberPtr = static_cast<FunctionType>(&Interpreter::toNumber);
-    auto valuesPtr = static_cast<FunctionType>(&Interpreter::values);
-    auto maxPtr = static_cast<MaxFunctionType>(&Interpreter::max);
-    auto maxByPtr = static_cast<MaxFunctionType>(&Interpreter::maxBy);
-    m_functionMap = {
-        {"abs", Descriptor{exactlyOne, true,
-                           bind(&Interpreter::abs, this, _1)}},
-        {"avg",  Descriptor{exactlyOne, true,
-                            bind(&Interpreter::avg, this, _1)}},
-        {"contains", Descriptor{exactlyTwo, false,
-                                bind(&Interpreter::contains, this, _1)}},
-        {"ceil", Descriptor{exactlyOne, true,
-                            bind(&Interpreter::ceil, this, _1)}},
-        {"ends_with", Descriptor{exactlyTwo, false,
-                                 bind(&Interpreter::endsWith, this, _1)}},
-        {"floor", Descriptor{exactlyOne, true,
-                             bind(&Interpreter::floor, this, _1)}},
-        {"join", Descriptor{exactlyTwo, false,
-                            bind(&Interpreter::join, this, _1)}},
-        {"keys", Descriptor{exactlyOne, true,
-                            bind(&Interpreter::keys, this, _1)}},
-        {"length", Descriptor{exactlyOne, true,
-                              bind(&Interpreter::length, this, _1)}},
-        {"map", Descriptor{exactlyTwo, true,
-                           bind(mapPtr, this, _1)}},
-        {"max", Descriptor{exactlyOne, true,
-                           bind(maxPtr, this, _1, std::less<Json>{})}},
-        {"max_by", Descriptor{exactlyTwo, true,
-                              bind(maxByPtr, this, _1, std::less<Json>{})}},
-        {"merge", Descriptor{zeroOrMore, false,
-                             bind(&Interpreter::merge, this, _1)}},
-        {"min", Descriptor{exactlyOne, true,
-                           bind(maxPtr, this, _1, std::greater<Json>{})}},
-        {"min_by", Descriptor{exactlyTwo, true,
-                              bind(maxByPtr, this, _1, std::greater<Json>{})}},
-        {"not_null", Descriptor{oneOrMore, false,
-                                bind(&Interpreter::notNull, this, _1)}},
-        {"reverse", Descriptor{exactlyOne, true,
-                               bind(reversePtr, this, _1)}},
-        {"sort",  Descriptor{exactlyOne, true,
-                             bind(sortPtr, this, _1)}},
-        {"sort_by", Descriptor{exactlyTwo, true,
-                               bind(sortByPtr, this, _1)}},
-        {"starts_with", Descriptor{exactlyTwo, false,
-                                   bind(&Interpreter::startsWith, this, _1)}},
-        {"sum", Descriptor{exactlyOne, true,
-                           bind(&Interpreter::sum, this, _1)}},
-        {"to_array", Descriptor{exactlyOne, true,
-                                bind(toArrayPtr, this, _1)}},
-        {"to_string", Descriptor{exactlyOne, true,
-                                 bind(toStringPtr, this, _1)}},
-        {"to_number", Descriptor{exactlyOne, true,
-                                 bind(toNumberPtr, this, _1)}},
-        {"type", Descriptor{exactlyOne, true,
-                            bind(&Interpreter::type, this, _1)}},
-        {"values", Descriptor{exactlyOne, true,
-                              bind(valuesPtr, this, _1)}}
+    using std::less;
+    using std::greater;
+    const auto variadic = std::numeric_limits<std::size_t>::max();
+    const auto singleValue = ArgumentEvaluation::SingleValue;
+    const auto multipleValues = ArgumentEvaluation::MultipleValues;
+    const auto onDemand = ArgumentEvaluation::OnDemand;
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+    static const std::vector<FunctionDescriptor> s_descriptors {
+        {"abs", 1, 1, singleValue, &Interpreter::abs},
+        {"all", 2, 2, singleValue, &Interpreter::all},
+        {"any", 2, 2, singleValue, &Interpreter::any},
+        {"avg", 1, 1, singleValue, &Interpreter::avg},
+        {"bottom_k", 2, 2, multipleValues,
+         &Interpreter::callWithComparator<&Interpreter::topK, less<Json>>},
+        {"bottom_k_by", 3, 3, multipleValues,
+         &Interpreter::callWithComparator<&Interpreter::topKBy, less<Json>>},
+        {"contains", 2, 2, multipleValues, &Interpreter::contains},
+        {"ceil", 1, 1, singleValue, &Interpreter::ceil},
+        {"count_by", 2, 2, singleValue,
+         &Interpreter::groupBy<Grouping::Count>},
+        {"count_if", 2, 2, singleValue, &Interpreter::countIf},
+        {"ends_with", 2, 2, multipleValues, &Interpreter::endsWith},
+        {"find_first", 2, 2, singleValue, &Interpreter::findFirst},
+        {"floor", 1, 1, singleValue, &Interpreter::floor},
+        {"group_by", 2, 2, singleValue,
+         &Interpreter::groupBy<Grouping::Group>},
+        {"index_by", 2, 2, singleValue,
+         &Interpreter::groupBy<Grouping::Index>},
+        {"join", 2, 2, multipleValues, &Interpreter::join},
+        {"keys", 1, 1, singleValue, &Interpreter::keys},
+        {"length", 1, 1, singleValue, &Interpreter::length},
+        {"map", 2, 2, singleValue, &Interpreter::map},
+        {"matches", 2, 2, multipleValues, &Interpreter::matches, nullptr,
+         true},
+        {"max", 1, 1, singleValue,
+         &Interpreter::callWithComparator<&Interpreter::max, less<Json>>,
+         &Interpreter::callWithComparator<&Interpreter::maxUnchecked,
+                                          less<Json>>},
+        {"max_by", 2, 2, singleValue,
+         &Interpreter::callWithComparator<&Interpreter::maxBy, less<Json>>},
+        {"merge", 0, variadic, multipleValues, &Interpreter::merge},
+        {"min", 1, 1, singleValue,
+         &Interpreter::callWithComparator<&Interpreter::max, greater<Json>>,
+         &Interpreter::callWithComparator<&Interpreter::maxUnchecked,
+                                          greater<Json>>},
+        {"min_by", 2, 2, singleValue,
+         &Interpreter::callWithComparator<&Interpreter::maxBy, greater<Json>>},
+        {"not_null", 1, variadic, onDemand, &Interpreter::notNull},
+        {"regex_extract", 2, 2, multipleValues, &Interpreter::regexExtract,
+         nullptr, true},
+        {"regex_replace", 3, 3, multipleValues, &Interpreter::regexReplace,
+         nullptr, true},
+        {"reverse", 1, 1, singleValue, &Interpreter::reverse},
+        {"sort", 1, 1, singleValue, &Interpreter::sort,
+         &Interpreter::sortUnchecked},
+        {"sort_by", 2, 2, singleValue, &Interpreter::sortBy},
+        {"starts_with", 2, 2, multipleValues, &Interpreter::startsWith},
+        {"sum", 1, 1, singleValue, &Interpreter::sum},
+        {"to_array", 1, 1, singleValue, &Interpreter::toArray},
+        {"to_string", 1, 1, singleValue, &Interpreter::toString},
+        {"to_number", 1, 1, singleValue, &Interpreter::toNumber},
+        {"top_k", 2, 2, multipleValues,
+         &Interpreter::callWithComparator<&Interpreter::topK, greater<Json>>},
+        {"top_k_by", 3, 3, multipleValues,
+         &Interpreter::callWithComparator<&Interpreter::topKBy,
+                                          greater<Json>>},
+        {"type", 1, 1, singleValue, &Interpreter::type},
+        {"unique", 1, 1, singleValue, &Interpreter::unique},
+        {"values", 1, 1, singleValue, &Interpreter::values}
     };
+#pragma clang diagnostic pop
+    return s_descriptors;
+}
+
+const std::unordered_map<String, std::size_t>& Interpreter::functionIds()
+{
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+    static const std::unordered_map<String, std::size_t> s_functionIds = [] {
+        // map the function names to the index of their descriptors
+        std::unordered_map<String, std::size_t> functionIds;
+        const auto& descriptors = functionDescriptors();
+        for (std::size_t i = 0; i < descriptors.size(); ++i)
+        {
+            functionIds.emplace(descriptors[i].name, i);
+        }
+        return functionIds;
+    }();
+#pragma clang diagnostic pop
+    return s_functionIds;
+}
+
+const Interpreter::FunctionDescriptor& Interpreter::findFunction(
+        const ast::FunctionExpressionNode *node)
+{
+    // functions resolved during parsing are already validated
+    if (node->functionId && (*node->functionId < functionDescriptors().size()))
+    {
+        return functionDescriptors()[*node->functionId];
+    }
+
+    // throw an error if the function doesn't exists
+    const auto& functionIds = Interpreter::functionIds();
+    auto it = functionIds.find(node->functionName);
+    if (it == functionIds.end())
+    {
+        BOOST_THROW_EXCEPTION(UnknownFunction()
+                              << InfoFunctionName(node->functionName));
+    }
+    const auto& descriptor = functionDescriptors()[it->second];
+    // validate that the function has been called with the appropriate
+    // number of arguments
+    validateArity(descriptor.minArity,
+                  descriptor.maxArity,
+                  node->arguments.size());
+    return descriptor;
+}
+
+void Interpreter::validateArity(std::size_t minArity,
+                                std::size_t maxArity,
+                                std::size_t argumentCount)
+{
+    if ((argumentCount < minArity) || (argumentCount > maxArity))
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentArity());
+    }
+}
+
+Interpreter::CustomFunctionRegistry& Interpreter::customFunctionRegistry()
+{
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wexit-time-destructors"
+    static CustomFunctionRegistry s_registry;
+#pragma clang diagnostic pop
+    return s_registry;
+}
+
+const Interpreter::CustomFunctionDescriptor*
+Interpreter::findCustomFunction(const ast::FunctionExpressionNode *node)
+{
+    const std::size_t builtInCount = functionDescriptors().size();
+    if (node->functionId)
+    {
+        // built in functions aren't handled here
+        if (*node->functionId < builtInCount)
+        {
+            return nullptr;
+        }
+        // update the cached descriptors if the function was registered
+        // since the last update
+        std::size_t offset = *node->functionId - builtInCount;
+        if (offset >= m_customFunctions.size())
+        {
+            auto& registry = customFunctionRegistry();
+            std::lock_guard<std::mutex> lock{registry.mutex};
+            for (std::size_t i = m_customFunctions.size();
+                 i < registry.descriptors.size();
+                 ++i)
+            {
+                m_customFunctions.push_back(&registry.descriptors[i]);
+            }
+        }
+        return m_customFunctions[offset];
+    }
+
+    // look up unresolved function calls by the function's name
+    if (functionIds().count(node->functionName) > 0)
+    {
+        return nullptr;
+    }
+    auto& registry = customFunctionRegistry();
+    std::lock_guard<std::mutex> lock{registry.mutex};
+    auto it = registry.functionIds.find(node->functionName);
+    if (it == registry.functionIds.end())
+    {
+        return nullptr;
+    }
+    const auto& descriptor = registry.descriptors[it->second];
+    validateArity(descriptor.minArity,
+                  descriptor.maxArity,
+                  node->arguments.size());
+    return &descriptor;
+}
+
+void Interpreter::validateConstantArguments(
+        const ast::FunctionExpressionNode &node,
+        const CustomFunctionDescriptor &descriptor)
+{
+    for (std::size_t i = 0; i < node.arguments.size(); ++i)
+    {
+        ArgumentType type = argumentType(descriptor.signature, i);
+        const auto& argument = node.arguments[i];
+        // expression arguments can't be passed to custom functions
+        if (boost::get<ast::ExpressionArgumentNode>(&argument))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType()
+                                  << InfoFunctionName(node.functionName));
+        }
+        const auto* expression = boost::get<ast::ExpressionNode>(&argument);
+        if (!expression)
+        {
+            continue;
+        }
+        // raw strings and literals have the same value on every evaluation
+        bool isValid = true;
+        if (boost::get<ast::RawStringNode>(&expression->value))
+        {
+            isValid = matchesType(Json(String{}), type);
+        }
+        else if (const auto* literal = boost::get<ast::LiteralNode>(
+                     &expression->value))
+        {
+            isValid = matchesType(Json::parse(literal->literal), type);
+        }
+        if (!isValid)
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType()
+                                  << InfoFunctionName(node.functionName));
+        }
+    }
+}
+
+ArgumentType Interpreter::argumentType(const FunctionSignature &signature,
+                                       std::size_t index)
+{
+    // the arguments of variadic functions after the declared ones have the
+    // type of the last declared argument
+    if (index < signature.argumentTypes.size())
+    {
+        return signature.argumentTypes[index];
+    }
+    return signature.argumentTypes.back();
+}
+
+bool Interpreter::matchesType(const Json &value, ArgumentType type)
+{
+    switch (type)
+    {
+    case ArgumentType::Any:
+        return true;
+    case ArgumentType::Null:
+        return value.is_null();
+    case ArgumentType::Boolean:
+        return value.is_boolean();
+    case ArgumentType::Number:
+        return value.is_number();
+    case ArgumentType::String:
+        return value.is_string();
+    case ArgumentType::Array:
+        return value.is_array();
+    case ArgumentType::Object:
+        return value.is_object();
+    }
+    return false;
+}
+
+class Interpreter::CustomFunctionArguments : public FunctionArguments
+{
+public:
+    CustomFunctionArguments(Interpreter& interpreter,
+                            FunctionArgumentList& arguments,
+                            const CustomFunctionDescriptor& descriptor)
+        : m_interpreter(interpreter),
+          m_arguments(arguments),
+          m_descriptor(descriptor),
+          m_validated(false)
+    {
+    }
+
+    void validate()
+    {
+        for (std::size_t i = 0; i < m_arguments.size(); ++i)
+        {
+            at(i);
+        }
+        m_validated = true;
+    }
+
+    std::size_t size() const override
+    {
+        return m_arguments.size();
+    }
+
+    const Json& at(std::size_t index) const override
+    {
+        if (index >= m_arguments.size())
+        {
+            BOOST_THROW_EXCEPTION(InvalidAgrument{}
+                                  << InfoFunctionName(m_descriptor.name));
+        }
+        // evaluate the argument if needed and validate its type
+        const Json& value = m_interpreter.getJsonArgument(m_arguments[index]);
+        if (!m_validated
+            && !matchesType(value,
+                            argumentType(m_descriptor.signature, index)))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType()
+                                  << InfoFunctionName(m_descriptor.name));
+        }
+        return value;
+    }
+
+private:
+    Interpreter& m_interpreter;
+    FunctionArgumentList& m_arguments;
+    const CustomFunctionDescriptor& m_descriptor;
+    bool m_validated;
+};
+
+void Interpreter::callCustomFunction(
+        const ast::FunctionExpressionNode *node,
+        const CustomFunctionDescriptor &descriptor)
+{
+    // move the current context into a temporary variable in case it holds
+    // a value, since every argument is evaluated on it
+    ContextValue contextValue {std::move(m_context)};
+    auto evaluation = descriptor.signature.evaluateOnDemand
+            ? ArgumentEvaluation::OnDemand
+            : ArgumentEvaluation::MultipleValues;
+    FunctionArgumentList argumentList = evaluateArguments(node->arguments,
+                                                          &contextValue,
+                                                          evaluation);
+    CustomFunctionArguments arguments{*this, argumentList, descriptor};
+    // validate the types of the already evaluated arguments once before the
+    // call, arguments evaluated on demand are validated on access
+    if (evaluation == ArgumentEvaluation::MultipleValues)
+    {
+        arguments.validate();
+    }
+    m_context = descriptor.function(arguments);
 }
 
 void Interpreter::evaluateProjection(const ast::ExpressionNode *expression)
 {
     using std::placeholders::_1;
+    // projecting the current node only removes the null items of an array,
+    // so if it has none then the array, which might be a view created in
+    // constant time, can be kept as it is
+    const Json& array = getJsonValue(m_context);
+    if (expression->isNull() && array.is_array()
+        && std::none_of(std::begin(array), std::end(array),
+                        [](const Json& item) { return item.is_null(); }))
+    {
+        return;
+    }
     // move the current context into a temporary variable in case it holds
     // a value, since the context member variable will get overwritten during
     // the evaluation of the projection
@@ -186,6 +553,336 @@ void Interpreter::evaluateProjection(const ast::ExpressionNode* expression,
     }
 }
 
+bool Interpreter::isLazyProjection(const ast::ExpressionNode &expression) const
+{
+    // hash wildcard expressions are always projections
+    if (boost::get<ast::HashWildcardNode>(&expression.value))
+    {
+        return true;
+    }
+    // index expressions are projections unless they select a single item
+    const auto* indexNode = boost::get<ast::IndexExpressionNode>(
+                &expression.value);
+    return indexNode && indexNode->isProjection();
+}
+
+bool Interpreter::evaluateLazyProjection(const ast::ExpressionNode &expression,
+                                         const ProjectionConsumer &consumer)
+{
+    const auto* indexNode = boost::get<ast::IndexExpressionNode>(
+                &expression.value);
+    const auto* wildcardNode = boost::get<ast::HashWildcardNode>(
+                &expression.value);
+    // evaluate the left side expression of the projection
+    if (indexNode)
+    {
+        visit(&indexNode->leftExpression);
+    }
+    else
+    {
+        visit(&wildcardNode->leftExpression);
+    }
+    // move the result of the left side expression into a temporary variable,
+    // since the context member variable will get overwritten during the
+    // evaluation of the projected expression
+    ContextValue contextValue {std::move(m_context)};
+
+    // project the expression with either an lvalue const ref or rvalue ref
+    // context
+    bool result = false;
+    auto visitor = makeVisitor(
+        [&](const Json& context) {
+            result = indexNode
+                ? evaluateLazyProjection(indexNode, consumer, context)
+                : evaluateLazyProjection(wildcardNode, consumer, context);
+        },
+        [&](Json&& context) {
+            result = indexNode
+                ? evaluateLazyProjection(indexNode, consumer,
+                                         std::move(context))
+                : evaluateLazyProjection(wildcardNode, consumer,
+                                         std::move(context));
+        }
+    );
+    boost::apply_visitor(visitor, contextValue);
+    // the projection evaluates to null if its left side result can't be
+    // projected
+    if (!result)
+    {
+        m_context = {};
+    }
+    return result;
+}
+
+template <typename JsonT>
+bool Interpreter::evaluateLazyProjection(const ast::IndexExpressionNode* node,
+                                         const ProjectionConsumer& consumer,
+                                         JsonT&& context)
+{
+    // only arrays can be projected
+    if (!context.is_array())
+    {
+        return false;
+    }
+
+    const auto& bracket = node->bracketSpecifier.value;
+    const ast::ExpressionNode* expression = &node->rightExpression;
+    // evaluate the filtering condition on the items and project the ones
+    // which satisfy it
+    if (const auto* filterNode = boost::get<ast::FilterExpressionNode>(
+            &bracket))
+    {
+        // select the items with a registered index, the items of rvalue
+        // contexts are copied since the index shares their container
+        Json key;
+        if (auto index = findHashIndex(filterNode, context, key))
+        {
+            const Json& items = context;
+            for (auto position: index->find(key))
+            {
+                ContextValue item;
+                if (std::is_lvalue_reference<JsonT>::value)
+                {
+                    item = assignContextValue(items[position]);
+                }
+                else
+                {
+                    item = Json(items[position]);
+                }
+                if (!projectLazily(expression, consumer, std::move(item)))
+                {
+                    break;
+                }
+            }
+        }
+        // select the items with the filter's kernel if it has one, the mask
+        // is copied since the projected expression might evaluate other
+        // filters
+        else if (filterNode->kernel
+            && filterNode->kernel->select(context, m_filterWorkspace))
+        {
+            const std::vector<std::uint8_t> mask = m_filterWorkspace.mask();
+            std::size_t index = 0;
+            for (auto& item: context)
+            {
+                if (mask[index++]
+                    && !projectLazily(expression, consumer,
+                                      assignContextValue(std::move(item))))
+                {
+                    break;
+                }
+            }
+        }
+        else
+        {
+            for (auto& item: context)
+            {
+                // evaluate the filtering condition on the item
+                if (evaluateCondition(&filterNode->expression, item)
+                    && !projectLazily(expression, consumer,
+                                      assignContextValue(std::move(item))))
+                {
+                    break;
+                }
+            }
+        }
+    }
+    // project the items selected by the slice
+    else if (const auto* sliceNode = boost::get<ast::SliceExpressionNode>(
+                 &bracket))
+    {
+        NativeIndex startIndex;
+        NativeIndex stopIndex;
+        NativeIndex step;
+        std::tie(startIndex, stopIndex, step) = sliceIndices(sliceNode,
+                                                             context.size());
+        for (auto i = startIndex;
+             step > 0 ? (i < stopIndex) : (i > stopIndex);
+             i += step)
+        {
+            size_t arrayIndex = static_cast<size_t>(i);
+            if (!projectLazily(expression, consumer,
+                               assignContextValue(
+                                   std::move(context[arrayIndex]))))
+            {
+                break;
+            }
+        }
+    }
+    // project the items of the nested arrays or the items themselves if they
+    // are not arrays
+    else if (boost::get<ast::FlattenOperatorNode>(&bracket))
+    {
+        bool finished = false;
+        for (auto it = std::begin(context);
+             !finished && it != std::end(context);
+             ++it)
+        {
+            auto& item = *it;
+            if (item.is_array())
+            {
+                // the nested array might be shared with other values even
+                // if the context is an rvalue
+                detachSharedContainer(item);
+                for (auto& subItem: item)
+                {
+                    if (!projectLazily(expression, consumer,
+                                       assignContextValue(
+                                           std::move(subItem))))
+                    {
+                        finished = true;
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                finished = !projectLazily(expression, consumer,
+                                          assignContextValue(std::move(item)));
+            }
+        }
+    }
+    // project every item in case of a list wildcard
+    else
+    {
+        for (auto& item: context)
+        {
+            if (!projectLazily(expression, consumer,
+                               assignContextValue(std::move(item))))
+            {
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+template <typename JsonT>
+bool Interpreter::evaluateLazyProjection(const ast::HashWildcardNode* node,
+                                         const ProjectionConsumer& consumer,
+                                         JsonT&& context)
+{
+    // only objects can be projected
+    if (!context.is_object())
+    {
+        return false;
+    }
+    // project the values of the object
+    for (auto& item: context)
+    {
+        if (!projectLazily(&node->rightExpression, consumer,
+                           assignContextValue(std::move(item))))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+bool Interpreter::projectLazily(const ast::ExpressionNode *expression,
+                                const ProjectionConsumer &consumer,
+                                ContextValue &&item)
+{
+    m_context = std::move(item);
+    // evaluate the expression
+    visit(expression);
+    // null results are not part of the projection
+    if (getJsonValue(m_context).is_null())
+    {
+        return true;
+    }
+    return consumer(std::move(m_context));
+}
+
+bool Interpreter::evaluateLazyArrayItem(const ast::ExpressionNode &expression,
+                                        const ast::IndexExpressionNode *node)
+{
+    // only non negative indeces can be selected without evaluating the
+    // whole projection
+    const auto* arrayItemNode = boost::get<ast::ArrayItemNode>(
+                &node->bracketSpecifier.value);
+    if (!arrayItemNode || arrayItemNode->index < 0
+        || !isLazyProjection(expression))
+    {
+        return false;
+    }
+
+    // skip the results of the projection until the item at the selected
+    // index is reached
+    auto remainingItems = arrayItemNode->index.convert_to<std::size_t>();
+    ContextValue result;
+    evaluateLazyProjection(expression, [&](ContextValue&& item) {
+        if (remainingItems == 0)
+        {
+            result = std::move(item);
+            return false;
+        }
+        --remainingItems;
+        return true;
+    });
+    // set the selected item or null if the projection had fewer items
+    m_context = std::move(result);
+    return true;
+}
+
+bool Interpreter::evaluateLazyFunction(const ast::FunctionExpressionNode *node,
+                                       Function function)
+{
+    // only functions which take a projection as their first argument can
+    // consume it lazily
+    const auto* subject = boost::get<ast::ExpressionNode>(&node->arguments[0]);
+    if (!subject || !isLazyProjection(*subject))
+    {
+        return false;
+    }
+
+    // count the results of the projection without storing them
+    if (function == &Interpreter::length)
+    {
+        size_t count = 0;
+        if (!evaluateLazyProjection(*subject, [&count](ContextValue&&) {
+                ++count;
+                return true;
+            }))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        m_context = count;
+        return true;
+    }
+    // stop at the first result which equals to the searched item
+    else if (function == &Interpreter::contains)
+    {
+        const auto* itemExpression = boost::get<ast::ExpressionNode>(
+                    &node->arguments[1]);
+        if (!itemExpression)
+        {
+            return false;
+        }
+        // move the current context into a temporary variable in case it
+        // holds a value, since both arguments are evaluated on it
+        ContextValue contextValue {std::move(m_context)};
+        // evaluate the searched item
+        m_context = assignContextValue(getJsonValue(contextValue));
+        visit(itemExpression);
+        ContextValue item {std::move(m_context)};
+        const Json& searchedItem = getJsonValue(item);
+        // evaluate the projection until the searched item is found
+        bool found = false;
+        m_context = assignContextValue(getJsonValue(contextValue));
+        if (!evaluateLazyProjection(*subject, [&](ContextValue&& value) {
+                found = (getJsonValue(value) == searchedItem);
+                return !found;
+            }))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        m_context = found;
+        return true;
+    }
+    return false;
+}
+
 void Interpreter::visit(const ast::AbstractNode *node)
 {
     node->accept(this);
@@ -219,15 +916,16 @@ void Interpreter::visit(const ast::IdentifierNode *node, JsonT &&context)
     // evaluete the identifier if the context holds an object
     if (context.is_object())
     {
-        try
+        // look up the identifier without throwing an exception if it's
+        // missing
+        auto it = context.find(node->identifier);
+        if (it != context.end())
         {
             // assign either a const reference of the result or move the result
             // into the context depending on the type of the context parameter
-            m_context = assignContextValue(std::move(
-                                                context.at(node->identifier)));
+            m_context = assignContextValue(std::move(*it));
             return;
         }
-        catch (const nlohmann::json::out_of_range&) {}
     }
     // otherwise evaluate to null
     m_context = {};
@@ -250,6 +948,14 @@ void Interpreter::visit(const ast::SubexpressionNode *node)
 
 void Interpreter::visit(const ast::IndexExpressionNode *node)
 {
+    // if an item is selected from the result of a parenthesized projection
+    // then evaluate the projection only until the item is found
+    const auto* parenNode = boost::get<ast::ParenExpressionNode>(
+                &node->leftExpression.value);
+    if (parenNode && evaluateLazyArrayItem(parenNode->expression, node))
+    {
+        return;
+    }
     // evaluate the left side expression
     visit(&node->leftExpression);
     // evaluate the index expression if the context holds an array
@@ -293,15 +999,17 @@ void Interpreter::visit(const ast::ArrayItemNode *node, JsonT &&context)
     // evaluate the array item expression if the context holds an array
     if (context.is_array())
     {
-        // normalize the index value
-        auto arrayIndex = node->index;
+        // normalize the index value, indices out of the array's range are
+        // clamped to a value which is still out of range
+        auto length = static_cast<NativeIndex>(context.size());
+        auto arrayIndex = toNativeIndex(node->index, length + 1);
         if (arrayIndex < 0)
         {
-            arrayIndex += context.size();
+            arrayIndex += length;
         }
 
         // evaluate the expression if the index is not out of range
-        if ((arrayIndex >= 0) && (arrayIndex < context.size()))
+        if ((arrayIndex >= 0) && (arrayIndex < length))
         {
             // assign either a const reference of the result or move the result
             // into the context depending on the type of the context parameter
@@ -314,6 +1022,75 @@ void Interpreter::visit(const ast::ArrayItemNode *node, JsonT &&context)
     m_context = {};
 }
 
+void Interpreter::visit(const ast::PathNode *node)
+{
+    using std::placeholders::_1;
+    using LvalueType = void(Interpreter::*)(const ast::PathNode*,
+                                             const Json&);
+    using RvalueType = void(Interpreter::*)(const ast::PathNode*,
+                                             Json&&);
+    auto visitor = makeVisitor(
+        std::bind(static_cast<LvalueType>(&Interpreter::visit<const Json&>),
+                  this, node, _1),
+        std::bind(static_cast<RvalueType>(&Interpreter::visit<Json&&>),
+                  this, node, _1)
+    );
+    // visit the node with either an lvalue const ref or rvalue ref context
+    boost::apply_visitor(visitor, m_context);
+}
+
+template <typename JsonT>
+void Interpreter::visit(const ast::PathNode *node, JsonT &&context)
+{
+    // walk along the path with a pointer to the current value, so the
+    // intermediate values are neither copied nor stored in the context
+    std::remove_reference_t<JsonT>* value = &context;
+    for (const auto& segment: node->segments)
+    {
+        if (const auto* key = boost::get<String>(&segment))
+        {
+            if (!value->is_object())
+            {
+                m_context = {};
+                return;
+            }
+            // look up the key without throwing an exception if it's missing
+            auto it = value->find(*key);
+            if (it == value->end())
+            {
+                m_context = {};
+                return;
+            }
+            value = &*it;
+        }
+        else
+        {
+            if (!value->is_array())
+            {
+                m_context = {};
+                return;
+            }
+            // the indices of path nodes are already limited to the native
+            // range, so they can be normalized without overflowing
+            auto length = static_cast<NativeIndex>(value->size());
+            NativeIndex arrayIndex = boost::get<std::int64_t>(segment);
+            if (arrayIndex < 0)
+            {
+                arrayIndex += length;
+            }
+            if ((arrayIndex < 0) || (arrayIndex >= length))
+            {
+                m_context = {};
+                return;
+            }
+            value = &(*value)[static_cast<size_t>(arrayIndex)];
+        }
+    }
+    // assign either a const reference of the result or move the result
+    // into the context depending on the type of the context parameter
+    m_context = assignContextValue(std::move(*value));
+}
+
 void Interpreter::visit(const ast::FlattenOperatorNode *node)
 {
     using std::placeholders::_1;
@@ -346,6 +1123,9 @@ void Interpreter::visit(const ast::FlattenOperatorNode*, JsonT&& context)
             // to the end of the results variable
             if (item.is_array())
             {
+                // the nested array might be shared with other values even
+                // if the context is an rvalue
+                detachSharedContainer(item);
                 std::move(std::begin(item),
                           std::end(item),
                           std::back_inserter(result));
@@ -373,73 +1153,33 @@ void Interpreter::visit(const ast::BracketSpecifierNode *node)
 
 void Interpreter::visit(const ast::SliceExpressionNode *node)
 {
-    using std::placeholders::_1;
-    using LvalueType = void(Interpreter::*)(const ast::SliceExpressionNode*,
-                                             const Json&);
-    using RvalueType = void(Interpreter::*)(const ast::SliceExpressionNode*,
-                                             Json&&);
-    auto visitor = makeVisitor(
-        std::bind(static_cast<LvalueType>(&Interpreter::visit<const Json&>),
-                  this, node, _1),
-        std::bind(static_cast<RvalueType>(&Interpreter::visit<Json&&>),
-                  this, node, _1)
-    );
-    // visit the node with either an lvalue const ref or rvalue ref context
-    boost::apply_visitor(visitor, m_context);
-}
-
-template <typename JsonT>
-void Interpreter::visit(const ast::SliceExpressionNode* node, JsonT&& context)
-{
+    const Json& context = getJsonValue(m_context);
     // evaluate the slice operation if the context holds an array
     if (context.is_array())
     {
-        Index startIndex = 0;
-        Index stopIndex = 0;
-        Index step = 1;
-        size_t length = context.size();
-
-        // verify the validity of slice indeces and normalize their values
-        if (node->step)
-        {
-            if (*node->step == 0)
-            {
-                BOOST_THROW_EXCEPTION(InvalidValue{});
-            }
-            step = *node->step;
-        }
-        if (!node->start)
-        {
-            startIndex = step < 0 ? length - 1: 0;
-        }
-        else
+        NativeIndex startIndex;
+        NativeIndex stopIndex;
+        NativeIndex step;
+        std::tie(startIndex, stopIndex, step) = sliceIndices(node,
+                                                             context.size());
+        // calculate the number of selected items
+        NativeIndex count = 0;
+        if ((step > 0) && (stopIndex > startIndex))
         {
-            startIndex = adjustSliceEndpoint(length, *node->start, step);
+            count = (stopIndex - startIndex + step - 1) / step;
         }
-        if (!node->stop)
+        else if ((step < 0) && (startIndex > stopIndex))
         {
-            stopIndex = step < 0 ? -1 : Index{length};
-        }
-        else
-        {
-            stopIndex = adjustSliceEndpoint(length, *node->stop, step);
+            count = (startIndex - stopIndex - step - 1) / -step;
         }
 
-        // create the array of results
-        Json result(Json::value_t::array);
-        // iterate over the array
-        for (auto i = startIndex;
-             step > 0 ? (i < stopIndex) : (i > stopIndex);
-             i += step)
-        {
-            // append a copy of the item at arrayIndex or move it into the
-            // result array depending on the type of the context variable
-            size_t arrayIndex = static_cast<size_t>(i);
-            result.push_back(std::move(context[arrayIndex]));
-        }
-
-        // set the results of the projection
-        m_context = std::move(result);
+        // create a view of the selected items which shares the items of the
+        // context, so the slice is created in constant time and it stays
+        // valid even if the context is an rvalue that gets destroyed
+        const auto& array = context.get_ref<const Json::array_t&>();
+        m_context = Json(array.slice(static_cast<size_t>(startIndex),
+                                     step,
+                                     static_cast<size_t>(count)));
     }
     // otherwise evaluate to null
     else
@@ -506,8 +1246,11 @@ void Interpreter::visit(const ast::MultiselectListNode *node)
     // evaluate the multiselect list opration if the context doesn't holds null
     if (!getJsonValue(m_context).is_null())
     {
-        // create the array of results
+        // create the array of results with enough space for the result of
+        // every subexpression
         Json result(Json::value_t::array);
+        auto& items = result.get_ref<Json::array_t&>();
+        items.reserve(node->expressions.size());
         // move the current context into a temporary variable in case it holds
         // a value, since the context member variable will get overwritten
         // during  the evaluation of sub expressions
@@ -519,8 +1262,10 @@ void Interpreter::visit(const ast::MultiselectListNode *node)
             m_context = assignContextValue(getJsonValue(contextValue));
             // evaluate the subexpression
             visit(&expression);
-            // copy the result of the subexpression into the list of results
-            result.push_back(getJsonValue(m_context));
+            // move the result of the subexpression into the list of results,
+            // or add a copy which shares its containers with the referred
+            // value
+            items.push_back(takeJsonValue(std::move(m_context)));
         }
         // set the results of the projection
         m_context = std::move(result);
@@ -532,8 +1277,11 @@ void Interpreter::visit(const ast::MultiselectHashNode *node)
     // evaluate the multiselect hash opration if the context doesn't holds null
     if (!getJsonValue(m_context).is_null())
     {
-        // create the array of results
+        // create the object of results with enough space for the result of
+        // every subexpression
         Json result(Json::value_t::object);
+        auto& object = result.get_ref<Json::object_t&>();
+        object.reserve(node->expressions.size());
         // move the current context into a temporary variable in case it holds
         // a value, since the context member variable will get overwritten
         // during the evaluation of sub expressions
@@ -545,9 +1293,18 @@ void Interpreter::visit(const ast::MultiselectHashNode *node)
             m_context = assignContextValue(getJsonValue(contextValue));
             // evaluate the subexpression
             visit(&keyValuePair.second);
-            // add a copy of the result of the sub expression as the value
-            // for the key of the subexpression
-            result[keyValuePair.first.identifier] = getJsonValue(m_context);
+            // add the result of the sub expression as the value for the key
+            // of the subexpression, if the keys are unique the key doesn't
+            // have to be looked up in the object since it can't exist yet
+            const auto& key = keyValuePair.first.identifier;
+            if (node->uniqueKeys)
+            {
+                object.append(key, takeJsonValue(std::move(m_context)));
+            }
+            else
+            {
+                object[key] = takeJsonValue(std::move(m_context));
+            }
         }
         // set the results of the projection
         m_context = std::move(result);
@@ -588,7 +1345,7 @@ void Interpreter::visit(const ast::ComparatorExpressionNode *node)
         [&leftResultContext](Json&, const JsonRef& leftResult) {
             leftResultContext = leftResult.get();
         },
-        [](auto, auto) {}
+        [](const auto&, const auto&) {}
     );
     boost::apply_visitor(visitor, contextValue, leftResultContext);
     const Json& leftResult = getJsonValue(leftResultContext);
@@ -641,20 +1398,36 @@ void Interpreter::visit(const ast::OrExpressionNode *node)
 {
     // evaluate the logic operator and return with the left side result
     // if it's equal to true
-    evaluateLogicOperator(node, true);
+    evaluateLogicOperator(node, true, node->profile.get());
 }
 
 void Interpreter::visit(const ast::AndExpressionNode *node)
 {
     // evaluate the logic operator and return with the left side result
     // if it's equal to false
-    evaluateLogicOperator(node, false);
+    evaluateLogicOperator(node, false, node->profile.get());
 }
 
 void Interpreter::evaluateLogicOperator(
         const ast::BinaryExpressionNode* node,
-        bool shortCircuitValue)
+        bool shortCircuitValue,
+        LogicOperatorProfile* profile)
 {
+    // evaluate the operands in the order chosen by the profile, while
+    // sampling some of the evaluations to keep the order up to date
+    if (profile)
+    {
+        if (profile->beginEvaluation())
+        {
+            evaluateSampledLogicOperator(node, shortCircuitValue, profile);
+            return;
+        }
+        if (profile->isSwapped())
+        {
+            evaluateSwappedLogicOperator(node, shortCircuitValue);
+            return;
+        }
+    }
     // move the current context into a temporary variable and use a const lvalue
     // reference as the context for evaluating the left side expression, so
     // the context can be reused for the evaluation of the right expression
@@ -679,12 +1452,95 @@ void Interpreter::evaluateLogicOperator(
             [this](Json&, const JsonRef& leftResult) {
                 m_context = leftResult.get();
             },
-            [](auto, auto) {}
+            [](const auto&, const auto&) {}
         );
         boost::apply_visitor(visitor, contextValue, m_context);
     }
 }
 
+void Interpreter::evaluateSampledLogicOperator(
+        const ast::BinaryExpressionNode* node,
+        bool shortCircuitValue,
+        LogicOperatorProfile* profile)
+{
+    using Clock = LogicOperatorProfile::Clock;
+
+    ContextValue contextValue {std::move(m_context)};
+    const Json& context = getJsonValue(contextValue);
+    // evaluate the left operand as it's written
+    auto leftStart = Clock::now();
+    m_context = assignContextValue(context);
+    visit(&node->leftExpression);
+    bool leftShortCircuits
+            = (toBoolean(getJsonValue(m_context)) == shortCircuitValue);
+    // evaluate the right operand as well, to find out whether it would have
+    // short circuited the operator if it was evaluated first
+    auto rightStart = Clock::now();
+    bool rightShortCircuits = false;
+    m_context = assignContextValue(context);
+    try
+    {
+        visit(&node->rightExpression);
+        rightShortCircuits
+                = (toBoolean(getJsonValue(m_context)) == shortCircuitValue);
+    }
+    catch (const Exception&)
+    {
+        // the error of the right operand is only raised if it would have
+        // been evaluated in the written order
+        if (!leftShortCircuits)
+        {
+            throw;
+        }
+    }
+    auto rightEnd = Clock::now();
+    profile->addSample(rightStart - leftStart, leftShortCircuits,
+                       rightEnd - rightStart, rightShortCircuits);
+    // only the truthiness of the result is tested by the parent expressions
+    // of profiled operators
+    m_context = (leftShortCircuits || rightShortCircuits)
+            ? shortCircuitValue : !shortCircuitValue;
+}
+
+void Interpreter::evaluateSwappedLogicOperator(
+        const ast::BinaryExpressionNode* node,
+        bool shortCircuitValue)
+{
+    ContextValue contextValue {std::move(m_context)};
+    const Json& context = getJsonValue(contextValue);
+    // evaluate the right operand first
+    m_context = assignContextValue(context);
+    try
+    {
+        visit(&node->rightExpression);
+    }
+    catch (const Exception&)
+    {
+        // the error of the right operand is only raised if the left operand
+        // doesn't short circuit the operator, like in the written order
+        m_context = assignContextValue(context);
+        visit(&node->leftExpression);
+        if (toBoolean(getJsonValue(m_context)) != shortCircuitValue)
+        {
+            throw;
+        }
+        m_context = shortCircuitValue;
+        return;
+    }
+    // only evaluate the left operand if the right one doesn't short circuit
+    // the operator, and since only the truthiness of the result is tested by
+    // the parent expressions of profiled operators, replace the result with
+    // a boolean
+    if (toBoolean(getJsonValue(m_context)) == shortCircuitValue)
+    {
+        m_context = shortCircuitValue;
+        return;
+    }
+    m_context = assignContextValue(context);
+    visit(&node->leftExpression);
+    m_context = toBoolean(getJsonValue(m_context));
+}
+
 void Interpreter::visit(const ast::ParenExpressionNode *node)
 {
     // evaluate the sub expression
@@ -693,6 +1549,15 @@ void Interpreter::visit(const ast::ParenExpressionNode *node)
 
 void Interpreter::visit(const ast::PipeExpressionNode *node)
 {
+    // if the right side expression selects an item from the result of a
+    // projection then evaluate the projection only until the item is found
+    const auto* indexNode = boost::get<ast::IndexExpressionNode>(
+                &node->rightExpression.value);
+    if (indexNode && indexNode->leftExpression.isNull()
+        && evaluateLazyArrayItem(node->leftExpression, indexNode))
+    {
+        return;
+    }
     // evaluate the left followed by the right expression
     visit(&node->leftExpression);
     visit(&node->rightExpression);
@@ -732,6 +1597,36 @@ void Interpreter::visit(const ast::FilterExpressionNode* node, JsonT&& context)
     {
         // create the array of results
         Json result(Json::value_t::array);
+        // copy the items selected by a registered index, the items of
+        // rvalue contexts are not moved since the index shares their
+        // container
+        Json key;
+        if (auto index = findHashIndex(node, context, key))
+        {
+            const Json& items = context;
+            for (auto position: index->find(key))
+            {
+                result.push_back(items[position]);
+            }
+            m_context = std::move(result);
+            return;
+        }
+        // select the items with the filter's kernel if it has one and if it
+        // supports the values of the items
+        if (node->kernel && node->kernel->select(context, m_filterWorkspace))
+        {
+            const auto& mask = m_filterWorkspace.mask();
+            std::size_t index = 0;
+            std::copy_if(std::make_move_iterator(std::begin(context)),
+                         std::make_move_iterator(std::end(context)),
+                         std::back_inserter(result),
+                         [&mask, &index](const Json&)
+            {
+                return mask[index++] != 0;
+            });
+            m_context = std::move(result);
+            return;
+        }
         // move or copy every item the context array which satisfies the
         // filtering condition
         std::copy_if(std::make_move_iterator(std::begin(context)),
@@ -739,12 +1634,8 @@ void Interpreter::visit(const ast::FilterExpressionNode* node, JsonT&& context)
                      std::back_inserter(result),
                      [this, &node](const Json& item)
         {
-            // assign a const lvalue ref of the item to the context
-            m_context = assignContextValue(item);
-            // evaluate the filtering condition
-            visit(&node->expression);
-            // convert the result into a boolean
-            return toBoolean(getJsonValue(m_context));
+            // evaluate the filtering condition on the item
+            return evaluateCondition(&node->expression, item);
         });
 
         // set the results of the projection
@@ -759,50 +1650,200 @@ void Interpreter::visit(const ast::FilterExpressionNode* node, JsonT&& context)
 
 void Interpreter::visit(const ast::FunctionExpressionNode *node)
 {
-    // throw an error if the function doesn't exists
-    auto it = m_functionMap.find(node->functionName);
-    if (it == m_functionMap.end())
+    // call custom functions through their own calling convention
+    if (const auto* customDescriptor = findCustomFunction(node))
     {
-        BOOST_THROW_EXCEPTION(UnknownFunction()
-                              << InfoFunctionName(node->functionName));
+        callCustomFunction(node, *customDescriptor);
+        return;
     }
 
-    const auto& descriptor = it->second;
-    const auto& argumentArityValidator = std::get<0>(descriptor);
-    bool singleContextValueArgument = std::get<1>(descriptor);
-    const auto& function = std::get<2>(descriptor);
-    // validate that the function has been called with the appropriate
-    // number of arguments
-    if (!argumentArityValidator(node->arguments.size()))
+    const FunctionDescriptor& descriptor = findFunction(node);
+    // evaluate the function without materializing its projection argument
+    // if possible
+    if (evaluateLazyFunction(node, descriptor.function))
     {
-        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentArity());
+        return;
     }
 
     // if the function needs more than a single ContextValue
-    // argument
-    std::shared_ptr<ContextValue> contextValue;
-    if (!singleContextValueArgument)
+    // argument or it evaluates its arguments on demand
+    ContextValue contextValue;
+    const ContextValue* argumentContext = nullptr;
+    if (descriptor.argumentEvaluation != ArgumentEvaluation::SingleValue)
     {
         // move the current context into a temporary variable in
         // case it holds a value
-        contextValue = std::make_shared<ContextValue>(std::move(m_context));
+        contextValue = std::move(m_context);
+        argumentContext = &contextValue;
     }
 
     // evaluate the functins arguments
     FunctionArgumentList argumentList = evaluateArguments(
         node->arguments,
-        contextValue);
-    // evaluate the function
-    function(argumentList);
+        argumentContext,
+        descriptor.argumentEvaluation);
+    // evaluate the function, without checking the types of its arguments if
+    // they were proven to be valid during parsing
+    Function function = descriptor.function;
+    if (node->argumentTypesProven && descriptor.uncheckedFunction)
+    {
+        function = descriptor.uncheckedFunction;
+    }
+    m_constantPattern = node->pattern.get();
+    (this->*function)(argumentList);
 }
 
 void Interpreter::visit(const ast::ExpressionArgumentNode *)
 {
 }
 
-Index Interpreter::adjustSliceEndpoint(size_t length,
-                                        Index endpoint,
-                                        Index step) const
+void Interpreter::visit(const ast::VariableRefNode *node)
+{
+    // find the innermost binding of the variable
+    auto it = std::find_if(m_variables.rbegin(), m_variables.rend(),
+                           [node](const Variable& variable) {
+        return *variable.name == node->name;
+    });
+    if (it == m_variables.rend())
+    {
+        BOOST_THROW_EXCEPTION(UndefinedVariable{}
+                              << InfoVariableName(node->name));
+    }
+    // the reference stays valid while further variables are bound during
+    // the evaluation of a deferred expression, since the scope stack is a
+    // deque
+    Variable& variable = *it;
+    // evaluate a deferred expression on the context of its let expression
+    // when the variable is first referenced
+    if (variable.expression)
+    {
+        m_context = assignContextValue(getJsonValue(*variable.context));
+        visit(variable.expression);
+        variable.value = std::move(m_context);
+        variable.expression = nullptr;
+    }
+    // refer to the bound value without copying it
+    m_context = assignContextValue(getJsonValue(variable.value));
+}
+
+void Interpreter::visit(const ast::LetExpressionNode *node)
+{
+    // move the current context into a temporary variable in case it holds
+    // a value, since the context member variable will get overwritten
+    // during the evaluation of the bound expressions
+    ContextValue contextValue {std::move(m_context)};
+    const std::size_t scopeBegin = m_variables.size();
+    try
+    {
+        // bind the deferred expressions without evaluating them
+        if (node->deferred)
+        {
+            for (const auto& binding: node->bindings)
+            {
+                m_variables.push_back({&binding.first.name, {},
+                                       &binding.second, &contextValue});
+            }
+        }
+        else
+        {
+            // evaluate every bound expression in the enclosing scope, so the
+            // variables of the same let expression are not visible to each
+            // other
+            std::vector<ContextValue> values;
+            values.reserve(node->bindings.size());
+            for (const auto& binding: node->bindings)
+            {
+                m_context = assignContextValue(getJsonValue(contextValue));
+                visit(&binding.second);
+                values.push_back(std::move(m_context));
+            }
+            // bind the results to the variables, moving the values which
+            // are not references into the scope stack
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                m_variables.push_back({&node->bindings[i].first.name,
+                                       std::move(values[i]),
+                                       nullptr, nullptr});
+            }
+        }
+        // evaluate the child expression in the new scope
+        m_context = assignContextValue(getJsonValue(contextValue));
+        visit(&node->expression);
+    }
+    catch (...)
+    {
+        m_variables.erase(m_variables.begin() + scopeBegin,
+                          m_variables.end());
+        throw;
+    }
+    // if the result might refer to the context or the bound values which
+    // are released at the end of the scope, then replace it with a copy
+    // which shares its containers with the referred value
+    bool ownsValues = !boost::get<JsonRef>(&contextValue);
+    for (auto it = m_variables.begin() + scopeBegin;
+         it != m_variables.end();
+         ++it)
+    {
+        ownsValues |= !it->expression && !boost::get<JsonRef>(&it->value);
+    }
+    if (ownsValues)
+    {
+        m_context = takeJsonValue(std::move(m_context));
+    }
+    m_variables.erase(m_variables.begin() + scopeBegin, m_variables.end());
+}
+
+std::tuple<Interpreter::NativeIndex,
+           Interpreter::NativeIndex,
+           Interpreter::NativeIndex> Interpreter::sliceIndices(
+        const ast::SliceExpressionNode* node,
+        size_t length) const
+{
+    // clamp the indices into the range of -(length + 1) ... length + 1, which
+    // selects the same items as their original values, so that the slice can
+    // be evaluated with native arithmetic without overflowing
+    auto nativeLength = static_cast<NativeIndex>(length);
+    NativeIndex limit = nativeLength + 1;
+    NativeIndex startIndex = 0;
+    NativeIndex stopIndex = 0;
+    NativeIndex step = 1;
+
+    // verify the validity of slice indeces and normalize their values
+    if (node->step)
+    {
+        if (*node->step == 0)
+        {
+            BOOST_THROW_EXCEPTION(InvalidValue{});
+        }
+        step = toNativeIndex(*node->step, limit);
+    }
+    if (!node->start)
+    {
+        startIndex = step < 0 ? nativeLength - 1: 0;
+    }
+    else
+    {
+        startIndex = adjustSliceEndpoint(nativeLength,
+                                         toNativeIndex(*node->start, limit),
+                                         step);
+    }
+    if (!node->stop)
+    {
+        stopIndex = step < 0 ? -1 : nativeLength;
+    }
+    else
+    {
+        stopIndex = adjustSliceEndpoint(nativeLength,
+                                        toNativeIndex(*node->stop, limit),
+                                        step);
+    }
+    return std::make_tuple(startIndex, stopIndex, step);
+}
+
+Interpreter::NativeIndex Interpreter::adjustSliceEndpoint(
+        NativeIndex length,
+        NativeIndex endpoint,
+        NativeIndex step) const
 {
     if (endpoint < 0)
     {
@@ -819,6 +1860,26 @@ Index Interpreter::adjustSliceEndpoint(size_t length,
     return endpoint;
 }
 
+Interpreter::NativeIndex Interpreter::toNativeIndex(const Index &index,
+                                                    NativeIndex limit)
+{
+    // an array can't occupy more than ptrdiff_t bytes, and slicing adds up
+    // at most three values derived from its length, which must be
+    // representable as native indices
+    static_assert(std::numeric_limits<std::ptrdiff_t>::max() / sizeof(Json)
+                  < std::numeric_limits<NativeIndex>::max() / 4,
+                  "NativeIndex can't represent the indices of every array");
+    if (index > limit)
+    {
+        return limit;
+    }
+    if (index < -limit)
+    {
+        return -limit;
+    }
+    return index.convert_to<NativeIndex>();
+}
+
 bool Interpreter::toBoolean(const Json &json) const
 {
     return json.is_number()
@@ -828,10 +1889,87 @@ bool Interpreter::toBoolean(const Json &json) const
                 && !json.empty());
 }
 
+bool Interpreter::evaluateCondition(const ast::ExpressionNode* condition,
+                                    const Json& item)
+{
+    // assign a const lvalue ref of the item to the context
+    m_context = assignContextValue(item);
+    // evaluate the filtering condition
+    visit(condition);
+    // convert the result into a boolean
+    return toBoolean(getJsonValue(m_context));
+}
+
+std::shared_ptr<const HashIndex> Interpreter::findHashIndex(
+        const ast::FilterExpressionNode *node,
+        const Json &array,
+        Json &value) const
+{
+    // only lock the registry if there are indexes
+    if (HashIndexRegistry::isEmpty())
+    {
+        return {};
+    }
+    const auto* comparatorNode = boost::get<ast::ComparatorExpressionNode>(
+                &node->expression.value);
+    if (!comparatorNode
+        || (comparatorNode->comparator
+            != ast::ComparatorExpressionNode::Comparator::Equal))
+    {
+        return {};
+    }
+    // the key can be on either side of the comparison
+    const ast::ExpressionNode* key = &comparatorNode->leftExpression;
+    const ast::ExpressionNode* constant = &comparatorNode->rightExpression;
+    if (!boost::get<ast::LiteralNode>(&constant->value)
+        && !boost::get<ast::RawStringNode>(&constant->value))
+    {
+        std::swap(key, constant);
+    }
+    if (const auto* literalNode = boost::get<ast::LiteralNode>(
+            &constant->value))
+    {
+        value = Json::parse(literalNode->literal);
+    }
+    else if (const auto* rawStringNode = boost::get<ast::RawStringNode>(
+                 &constant->value))
+    {
+        value = rawStringNode->rawString;
+    }
+    else
+    {
+        return {};
+    }
+    return HashIndexRegistry::find(array, *key);
+}
+
+std::size_t Interpreter::findItem(const ast::ExpressionNode* condition,
+                                  const Json& array,
+                                  bool expected)
+{
+    // throw an exception if the argument is not an array
+    if (!array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // evaluate the condition on the items until the expected value is found
+    std::size_t index = 0;
+    for (const auto& item: array)
+    {
+        if (evaluateCondition(condition, item) == expected)
+        {
+            break;
+        }
+        ++index;
+    }
+    return index;
+}
+
 Interpreter::FunctionArgumentList
 Interpreter::evaluateArguments(
     const FunctionExpressionArgumentList &arguments,
-    const std::shared_ptr<ContextValue>& contextValue)
+    const ContextValue* contextValue,
+    ArgumentEvaluation evaluation)
 {
     // create a list to hold the evaluated expression arguments
     FunctionArgumentList argumentList;
@@ -843,6 +1981,12 @@ Interpreter::evaluateArguments(
         auto visitor = boost::hana::overload(
             // evaluate expressions and return their results
             [&, this](const ast::ExpressionNode& node) -> FunctionArgument {
+                // defer the evaluation of the expression if the function
+                // evaluates its arguments on demand
+                if (evaluation == ArgumentEvaluation::OnDemand)
+                {
+                    return LazyArgument{&node, contextValue};
+                }
                 if (contextValue)
                 {
                     const Json& context = getJsonValue(*contextValue);
@@ -858,7 +2002,7 @@ Interpreter::evaluateArguments(
             // in case of expression argument nodes return the expression they
             // hold so it can be evaluated inside a function
             [](const ast::ExpressionArgumentNode& node) -> FunctionArgument {
-                return node.expression;
+                return &node.expression;
             },
             // ignore blank arguments
             [](const boost::blank&) -> FunctionArgument {
@@ -885,8 +2029,18 @@ T& Interpreter::getArgument(FunctionArgument& argument) const
     }
 }
 
-const Json &Interpreter::getJsonArgument(FunctionArgument &argument) const
+const Json &Interpreter::getJsonArgument(FunctionArgument &argument)
 {
+    // evaluate the argument if its evaluation has been deferred and replace
+    // it with the result
+    if (auto lazyArgument = boost::get<LazyArgument>(&argument))
+    {
+        // assign a const lvalue ref to the context
+        m_context = assignContextValue(getJsonValue(*lazyArgument->context));
+        // evaluate the expression
+        visit(lazyArgument->expression);
+        argument = std::move(m_context);
+    }
     return getJsonValue(getArgument<ContextValue>(argument));
 }
 
@@ -910,52 +2064,50 @@ void Interpreter::abs(FunctionArgumentList &arguments)
     }
 }
 
+void Interpreter::all(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& array = getJsonArgument(arguments[0]);
+    const ast::ExpressionNode* condition
+            = getArgument<const ast::ExpressionNode*>(arguments[1]);
+    // every item satisfies the condition if there is no item which doesn't
+    m_context = findItem(condition, array, false) == array.size();
+}
+
+void Interpreter::any(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& array = getJsonArgument(arguments[0]);
+    const ast::ExpressionNode* condition
+            = getArgument<const ast::ExpressionNode*>(arguments[1]);
+    // check whether there is an item which satisfies the condition
+    m_context = findItem(condition, array, true) != array.size();
+}
+
 void Interpreter::avg(FunctionArgumentList &arguments)
 {
     // get the first argument
     const Json& items = getJsonArgument(arguments[0]);
-    // only evaluate if the argument is an array
-    if (items.is_array())
-    {
-        // evaluate only non empty arrays
-        if (!items.empty())
-        {
-            // calculate the sum of the array's items
-            double itemsSum = std::accumulate(items.cbegin(),
-                                              items.cend(),
-                                              0.0,
-                                              [](double sum,
-                                                 const Json& item) -> double
-            {
-                // add the value held by the item to the sum
-                if (item.is_number_integer())
-                {
-                    return sum + item.get<Json::number_integer_t>();
-                }
-                else if (item.is_number_float())
-                {
-                    return sum + item.get<Json::number_float_t>();
-                }
-                // or throw an exception if the current item is not a number
-                else
-                {
-                    BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
-                }
-            });
-            // the final result is the sum divided by the number of items
-            m_context = itemsSum / items.size();
-        }
-        // otherwise evaluate to null
-        else
-        {
-            m_context = Json{};
-        }
+    // throw an exception if the argument is not an array of numbers
+    if (!items.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
-    // otherwise throw an exception
-    else
+    NumericArray numbers(items);
+    if (!numbers.isNumeric())
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
+    // the result is the sum of the items divided by the number of items for
+    // non empty arrays, otherwise evaluate to null
+    if (numbers.size() != 0)
+    {
+        m_context = numbers.average();
+    }
+    else
+    {
+        m_context = Json{};
+    }
 }
 
 void Interpreter::contains(FunctionArgumentList &arguments)
@@ -984,7 +2136,7 @@ void Interpreter::contains(FunctionArgumentList &arguments)
         // try to find the given item as a substring in subject
         const String& stringSubject = subject.get_ref<const String&>();
         const String& stringItem = item.get_ref<const String&>();
-        result = boost::contains(stringSubject, stringItem);
+        result = containsString(stringSubject, stringItem);
     }
     // set the result
     m_context = result;
@@ -1011,6 +2163,29 @@ void Interpreter::ceil(FunctionArgumentList &arguments)
     }
 }
 
+void Interpreter::countIf(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& array = getJsonArgument(arguments[0]);
+    const ast::ExpressionNode* condition
+            = getArgument<const ast::ExpressionNode*>(arguments[1]);
+    // throw an exception if the argument is not an array
+    if (!array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // count the items which satisfy the condition
+    std::size_t count = 0;
+    for (const auto& item: array)
+    {
+        if (evaluateCondition(condition, item))
+        {
+            ++count;
+        }
+    }
+    m_context = count;
+}
+
 void Interpreter::endsWith(FunctionArgumentList &arguments)
 {
     // get the first argument
@@ -1025,7 +2200,26 @@ void Interpreter::endsWith(FunctionArgumentList &arguments)
     // check whether subject ends with the suffix
     const String& stringSubject = subject.get_ref<const String&>();
     const String& stringSuffix = suffix.get_ref<const String&>();
-    m_context = boost::ends_with(stringSubject, stringSuffix);
+    m_context = endsWithString(stringSubject, stringSuffix);
+}
+
+void Interpreter::findFirst(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& array = getJsonArgument(arguments[0]);
+    const ast::ExpressionNode* condition
+            = getArgument<const ast::ExpressionNode*>(arguments[1]);
+    // find the first item which satisfies the condition, or evaluate to
+    // null if there is no such item
+    std::size_t index = findItem(condition, array, true);
+    if (index < array.size())
+    {
+        m_context = Json(array[index]);
+    }
+    else
+    {
+        m_context = {};
+    }
 }
 
 void Interpreter::floor(FunctionArgumentList &arguments)
@@ -1037,39 +2231,230 @@ void Interpreter::floor(FunctionArgumentList &arguments)
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
-    // if the value is an integer then it evaluates to itself
-    if (value.is_number_integer())
+    // if the value is an integer then it evaluates to itself
+    if (value.is_number_integer())
+    {
+        m_context = value;
+    }
+    // otherwise return the result of floor
+    else
+    {
+        m_context = std::floor(value.get<Json::number_float_t>());
+    }
+}
+
+template <Interpreter::Grouping grouping>
+void Interpreter::groupBy(FunctionArgumentList &arguments)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
+    // get the second argument
+    const ast::ExpressionNode& expression
+            = *getArgument<const ast::ExpressionNode*>(arguments[1]);
+
+    // group the items of either a const lvalue ref to the array or of an
+    // rvalue ref whose items can be moved
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::groupBy<grouping, const Json&>,
+                  this, &expression, _1),
+        std::bind(&Interpreter::groupBy<grouping, Json&&>,
+                  this, &expression, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
+
+template <Interpreter::Grouping grouping, typename JsonT>
+void Interpreter::groupBy(const ast::ExpressionNode* expression,
+                          JsonT&& array)
+{
+    using ItemType = std::conditional_t<
+        std::is_const<std::remove_reference_t<JsonT>>::value,
+        const Json&,
+        Json&&>;
+    // throw an exception if the argument is not an array
+    if (!array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+
+    // create the resulting object, the keys are added in the order they are
+    // first seen so the position of every key in the table of distinct keys
+    // is the same as its position in the object
+    Json result(Json::value_t::object);
+    auto& object = result.get_ref<Json::object_t&>();
+    JsonHashTable keys;
+    std::vector<std::size_t> counts;
+    for (auto& item: array)
+    {
+        // evaluate the key of the item
+        m_context = assignContextValue(item);
+        visit(expression);
+        const Json& key = getJsonValue(m_context);
+        // skip the items without a key, and throw an exception if the key is
+        // not a string
+        if (key.is_null())
+        {
+            continue;
+        }
+        if (!key.is_string())
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        // look up the position of the key and add a new key to the object
+        auto entry = keys.insert(key);
+        if (entry.second)
+        {
+            object.append(key.get_ref<const String&>(),
+                          grouping == Grouping::Group
+                          ? Json(Json::value_t::array) : Json{});
+            counts.push_back(0);
+        }
+        // combine the item with the other items which have the same key
+        Json& value = std::next(object.begin(), entry.first)->second;
+        if (grouping == Grouping::Group)
+        {
+            value.push_back(static_cast<ItemType>(item));
+        }
+        else if (grouping == Grouping::Count)
+        {
+            ++counts[entry.first];
+        }
+        else
+        {
+            value = static_cast<ItemType>(item);
+        }
+    }
+    // store the number of items with the same keys
+    if (grouping == Grouping::Count)
+    {
+        for (std::size_t i = 0; i < counts.size(); ++i)
+        {
+            std::next(object.begin(), i)->second = counts[i];
+        }
+    }
+    m_context = std::move(result);
+}
+
+void Interpreter::join(FunctionArgumentList &arguments)
+{
+    // get the first argument
+    const Json& glue = getJsonArgument(arguments[0]);
+    // get the second argument
+    const Json& array = getJsonArgument(arguments[1]);
+    // throw an exception if the array or glue is not a string or if any items
+    // inside the array are not strings
+    if (!glue.is_string() || !array.is_array()
+       || alg::any_of(array, [](const auto& item) {return !item.is_string();}))
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // join together the strings with the glue string
+    m_context = joinStrings(array, glue.get_ref<const String&>());
+}
+
+void Interpreter::matches(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& subject = getJsonArgument(arguments[0]);
+    const Json& pattern = getJsonArgument(arguments[1]);
+    // throw an exception if the subject is not a string
+    if (!subject.is_string())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // check whether the expression matches any part of the subject
+    const std::regex& regex = patternArgument(pattern);
+    m_context = std::regex_search(subject.get_ref<const String&>(), regex);
+}
+
+void Interpreter::regexExtract(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& subject = getJsonArgument(arguments[0]);
+    const Json& pattern = getJsonArgument(arguments[1]);
+    // throw an exception if the subject is not a string
+    if (!subject.is_string())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // find the first match of the expression
+    const std::regex& regex = patternArgument(pattern);
+    std::smatch match;
+    const String& stringSubject = subject.get_ref<const String&>();
+    Json result;
+    if (std::regex_search(stringSubject, match, regex))
+    {
+        // evaluate to the text matched by the first capturing group, or to
+        // the whole match if there are no groups
+        const auto& submatch = match[regex.mark_count() > 0 ? 1 : 0];
+        if (submatch.matched)
+        {
+            result = submatch.str();
+        }
+    }
+    m_context = std::move(result);
+}
+
+void Interpreter::regexReplace(FunctionArgumentList &arguments)
+{
+    // get the arguments
+    const Json& subject = getJsonArgument(arguments[0]);
+    const Json& pattern = getJsonArgument(arguments[1]);
+    const Json& replacement = getJsonArgument(arguments[2]);
+    // throw an exception if the subject or the replacement is not a string
+    if (!subject.is_string() || !replacement.is_string())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // replace every match of the expression
+    const std::regex& regex = patternArgument(pattern);
+    m_context = std::regex_replace(subject.get_ref<const String&>(), regex,
+                                   replacement.get_ref<const String&>());
+}
+
+const std::regex &Interpreter::patternArgument(const Json &pattern)
+{
+    // throw an exception if the pattern is not a string
+    if (!pattern.is_string())
     {
-        m_context = value;
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
-    // otherwise return the result of floor
-    else
+    // use the pattern compiled during parsing if it's a constant
+    if (m_constantPattern)
     {
-        m_context = std::floor(value.get<Json::number_float_t>());
+        return *m_constantPattern;
     }
+    // otherwise look up the pattern in the cache
+    m_pattern = m_regexCache.get(pattern.get_ref<const String&>());
+    return *m_pattern;
 }
 
-void Interpreter::join(FunctionArgumentList &arguments)
+RegexPtr Interpreter::compileConstantPattern(
+        const ast::FunctionExpressionNode::ArgumentType &argument)
 {
-    // get the first argument
-    const Json& glue = getJsonArgument(arguments[0]);
-    // get the second argument
-    const Json& array = getJsonArgument(arguments[1]);
-    // throw an exception if the array or glue is not a string or if any items
-    // inside the array are not strings
-    if (!glue.is_string() || !array.is_array()
-       || alg::any_of(array, [](const auto& item) {return !item.is_string();}))
+    const auto* expression = boost::get<ast::ExpressionNode>(&argument);
+    if (!expression)
     {
-        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        return nullptr;
     }
-    // transform the array into a vector of strings
-    std::vector<String> stringArray;
-    rng::transform(array, std::back_inserter(stringArray), [](const Json& item)
+    // raw strings and string literals have the same value on every
+    // evaluation
+    if (const auto* rawString = boost::get<ast::RawStringNode>(
+            &expression->value))
     {
-        return item.get<String>();
-    });
-    // join together the vector of strings with the glue string
-    m_context = alg::join(stringArray, glue.get<String>());
+        return compileRegex(rawString->rawString);
+    }
+    if (const auto* literal = boost::get<ast::LiteralNode>(
+            &expression->value))
+    {
+        Json value = Json::parse(literal->literal);
+        if (value.is_string())
+        {
+            return compileRegex(value.get_ref<const String&>());
+        }
+    }
+    return nullptr;
 }
 
 void Interpreter::keys(FunctionArgumentList &arguments)
@@ -1104,13 +2489,10 @@ void Interpreter::length(FunctionArgumentList &arguments)
     // if it's a string
     if (subject.is_string())
     {
-        // calculate the distance between the two unicode iterators
-        // (since the expected string encoding is UTF-8 the number of
-        // items isn't equals to the number of code points)
-        const String& stringSubject = subject.get_ref<const String&>();
-        auto begin = UnicodeIteratorAdaptor(std::begin(stringSubject));
-        auto end = UnicodeIteratorAdaptor(std::end(stringSubject));
-        m_context = std::distance(begin, end);
+        // count the code points of the string (since the expected string
+        // encoding is UTF-8 the number of items isn't equals to the number
+        // of code points)
+        m_context = codePointCount(subject.get_ref<const String&>());
     }
     // otherwise get the size of the array or object
     else
@@ -1124,7 +2506,7 @@ void Interpreter::map(FunctionArgumentList &arguments)
     using std::placeholders::_1;
     // get the first argument
     const ast::ExpressionNode& expression
-            = getArgument<const ast::ExpressionNode>(arguments[0]);
+            = *getArgument<const ast::ExpressionNode*>(arguments[0]);
     // get the second argument
     ContextValue& contextValue = getArgument<ContextValue>(arguments[1]);
 
@@ -1173,52 +2555,86 @@ void Interpreter::map(const ast::ExpressionNode* node, JsonT&& array)
 void Interpreter::merge(FunctionArgumentList &arguments)
 {
     using std::placeholders::_1;
-    // create an emtpy object to hold the results
+    // throw an exception if any of the arguments is not an object, and count
+    // the items of the objects to know the maximum size of the result
+    std::size_t itemCount = 0;
+    for (auto& argument: arguments)
+    {
+        const Json& object = getJsonValue(
+                    getArgument<ContextValue>(argument));
+        if (!object.is_object())
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        itemCount += object.size();
+    }
+    // a single object doesn't have to be merged with anything, so it can be
+    // returned as it is
+    if (arguments.size() == 1)
+    {
+        m_context = takeJsonValue(std::move(
+                        getArgument<ContextValue>(arguments.front())));
+        return;
+    }
+
+    // create an emtpy object to hold the results with enough space for all
+    // the items, and an index of the positions of its keys
     Json result(Json::value_t::object);
+    auto& object = result.get_ref<Json::object_t&>();
+    object.reserve(itemCount);
+    KeyPositions positions;
+    positions.reserve(itemCount);
     // make a visitor which will call mergeObject with either a const lvalue
     // ref or an rvalue ref to the argument
     auto visitor = makeVisitor(
         std::bind(&Interpreter::mergeObject<const Json&>,
-                  this, &result, _1),
+                  this, std::ref(object), std::ref(positions), _1),
         std::bind(&Interpreter::mergeObject<Json&&>,
-                  this, &result, _1)
+                  this, std::ref(object), std::ref(positions), _1)
     );
-    // iterate over the arguments
+    // merge the arguments into the result object
     for (auto& argument: arguments)
     {
-        // convert the argument to a context value
-        ContextValue& contextValue = getArgument<ContextValue>(argument);
-        const Json& object = getJsonValue(contextValue);
-        // throw an exception if it's not an object
-        if (!object.is_object())
-        {
-            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
-        }
+        boost::apply_visitor(visitor, getArgument<ContextValue>(argument));
+    }
+    m_context = std::move(result);
+}
 
-        // if the resulting object is still empty then simply assign the first
-        // item to it
-        if (result.empty())
+template <typename JsonT>
+void Interpreter::mergeObject(Json::object_t& object,
+                              KeyPositions& positions,
+                              JsonT&& sourceObject)
+{
+    using SourceObjectType = std::conditional_t<
+        std::is_const<std::remove_reference_t<JsonT>>::value,
+        const Json::object_t&,
+        Json::object_t&>;
+    // add all key-value pairs from the sourceObject to the resulting object
+    // potentially overwriting some items, the values are moved if the
+    // sourceObject is an rvalue
+    for (auto& item: sourceObject.template get_ref<SourceObjectType>())
+    {
+        auto position = positions.emplace(item.first, object.size());
+        // append the item if the key is new, otherwise overwrite the value
+        // at the position of the key
+        if (position.second)
         {
-            result = std::move(object);
+            object.append(item.first, std::move(item.second));
         }
-        // otherwise merge the object into the result object
         else
         {
-            boost::apply_visitor(visitor, contextValue);
+            std::next(object.begin(), position.first->second)->second
+                    = std::move(item.second);
         }
-    };
-    m_context = std::move(result);
+    }
 }
 
-template <typename JsonT>
-void Interpreter::mergeObject(Json* object, JsonT&& sourceObject)
+template <void(Interpreter::*function)(Interpreter::FunctionArgumentList&,
+                                        const Interpreter::JsonComparator&),
+          typename Comparator>
+void Interpreter::callWithComparator(FunctionArgumentList &arguments)
 {
-    // add all key-value pairs from the sourceObject to the resulting object
-    // potentially overwriting some items
-    for (auto it = std::begin(sourceObject); it != std::end(sourceObject); ++it)
-    {
-        (*object)[it.key()] = std::move(*it);
-    }
+    (this->*function)(arguments, Comparator{});
 }
 
 void Interpreter::notNull(FunctionArgumentList &arguments)
@@ -1226,7 +2642,7 @@ void Interpreter::notNull(FunctionArgumentList &arguments)
     // iterate over the arguments
     for (auto& argument: arguments)
     {
-        // get the current argument
+        // evaluate the current argument
         const Json& item = getJsonArgument(argument);
         // if the current item is not null set it as the result
         if (!item.is_null())
@@ -1245,34 +2661,37 @@ void Interpreter::reverse(FunctionArgumentList &arguments)
     // get the first argument
     ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
 
-    // create a visitor which will reverse the argument if it's an rvalue
-    // or create a copy of it's argument and reverse the copy
-    auto visitor = makeMoveOnlyVisitor(
-        std::bind(
-            static_cast<void(Interpreter::*)(Json&&)>(&Interpreter::reverse),
-            this, _1)
+    // evaluate the reverse function with either const lvalue ref to the
+    // subject or as an rvalue ref
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::reverse<const Json&>, this, _1),
+        std::bind(&Interpreter::reverse<Json&&>, this, _1)
     );
     boost::apply_visitor(visitor, contextValue);
 }
 
-void Interpreter::reverse(Json&& subject)
+template <typename JsonT>
+void Interpreter::reverse(JsonT&& subject)
 {
     // throw an exception if the subject is not an array or a string
     if (!(subject.is_array() || subject.is_string()))
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
-    // reverse the array or string
+    // create a reversed view of the array which shares the items of the
+    // subject
     if (subject.is_array())
     {
-        rng::reverse(subject);
+        const auto& array = subject.template get_ref<const Json::array_t&>();
+        m_context = Json(array.slice(array.size() - 1, -1, array.size()));
     }
-    else if (subject.is_string())
+    // or reverse a copy of the string or the string itself if it's an rvalue
+    else
     {
-        rng::reverse(subject.template get_ref<String&>());
+        Json result = std::forward<JsonT>(subject);
+        rng::reverse(result.template get_ref<String&>());
+        m_context = std::move(result);
     }
-    // set the result
-    m_context = std::move(subject);
 }
 
 void Interpreter::sort(FunctionArgumentList &arguments)
@@ -1293,14 +2712,57 @@ void Interpreter::sort(FunctionArgumentList &arguments)
 
 void Interpreter::sort(Json&& array)
 {
-    // throw an exception if the argument is not a homogenous array
-    if (!array.is_array() || !isComparableArray(array))
+    // throw an exception if the argument is not a homogenous array, arrays
+    // starting with a number are checked while they're sorted
+    if (!array.is_array()
+        || ((array.empty() || !array.front().is_number())
+            && !isComparableArray(array)))
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
+    sortArray(std::move(array));
+}
+
+void Interpreter::sortUnchecked(FunctionArgumentList &arguments)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
 
-    // sort the array and set the result
-    std::sort(std::begin(array), std::end(array));
+    // create a visitor which will sort the argument if it's an rvalue
+    // or create a copy of it's argument and sort the copy
+    auto visitor = makeMoveOnlyVisitor(
+        std::bind(&Interpreter::sortArray, this, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
+
+void Interpreter::sortArray(Json &&array)
+{
+    bool sorted = false;
+    // if the array contains numbers of the same type then sort their
+    // unboxed values
+    if (!array.empty() && array.front().is_number())
+    {
+        NumericArray numbers(array);
+        // throw an exception if not all items are numbers
+        if (!numbers.isNumeric())
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        if (numbers.type() == NumericArray::Type::Integer
+            || numbers.type() == NumericArray::Type::Float)
+        {
+            numbers.sort(array);
+            sorted = true;
+        }
+    }
+    // otherwise sort the items themselves
+    if (!sorted)
+    {
+        std::sort(std::begin(array), std::end(array));
+    }
+    // set the result
     m_context = std::move(array);
 }
 
@@ -1313,7 +2775,7 @@ void Interpreter::sortBy(FunctionArgumentList &arguments)
     ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
     // get the second argument
     const ast::ExpressionNode& expression
-            = getArgument<ast::ExpressionNode>(arguments[1]);
+            = *getArgument<const ast::ExpressionNode*>(arguments[1]);
 
     // create a visitor which will sort the argument if it's an rvalue
     // or create a copy of it's argument and sort the copy
@@ -1332,50 +2794,18 @@ void Interpreter::sortBy(const ast::ExpressionNode* expression, Json&& array)
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
 
-    // create an object for calculating array item hashes
-    std::hash<Json> hasher;
-    // create a map for storing the results of the evaluated expression by
-    // the hash value of the item
-    std::unordered_map<size_t, Json> expressionResultsMap;
-    auto firstItemType = Json::value_t::discarded;
-    // iterate over the items of the array
-    for (auto& item: array)
+    // evaluate the expression on every item only once and order the indices
+    // of the items by the results of the expression
+    auto keys = evaluateKeys(expression, array);
+    auto indices = orderedIndices(keys, keys.size(), std::less<Json>{});
+    // move the items into the result in the order of their indices
+    Json::array_t result;
+    result.reserve(indices.size());
+    for (auto index: indices)
     {
-        // visit the mapped expression with the item as the context
-        m_context = assignContextValue(item);
-        visit(expression);
-        const Json& resultValue = getJsonValue(m_context);
-        // throw an exception if the evaluated expression doesn't result
-        // in a number or string
-        if (!(resultValue.is_number() || resultValue.is_string()))
-        {
-            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
-        }
-        // store the type of the first expresion result
-        if (firstItemType == Json::value_t::discarded)
-        {
-            firstItemType = resultValue.type();
-        }
-        // if an expression result's type differs from the type of the first
-        // result then throw an exception
-        else if (resultValue.type() != firstItemType)
-        {
-            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
-        }
-        // store the result of the expression
-        expressionResultsMap[hasher(item)] = resultValue;
+        result.push_back(std::move(array[index]));
     }
-
-    // sort the items of the array based on the results of the expression
-    // evaluated on them
-    std::sort(std::begin(array), std::end(array),
-              [&](const auto& first, const auto& second) -> bool
-    {
-        return (expressionResultsMap[hasher(first)]
-                < expressionResultsMap[hasher(second)]);
-    });
-    // set the result
-    m_context = std::move(array);
+    m_context = Json(std::move(result));
 }
 
 void Interpreter::startsWith(FunctionArgumentList &arguments)
@@ -1392,44 +2822,25 @@ void Interpreter::startsWith(FunctionArgumentList &arguments)
     // check whether subject starts with the suffix
     const String& stringSubject = subject.get_ref<const String&>();
     const String& stringPrefix = prefix.get_ref<const String&>();
-    m_context = boost::starts_with(stringSubject, stringPrefix);
+    m_context = startsWithString(stringSubject, stringPrefix);
 }
 
 void Interpreter::sum(FunctionArgumentList &arguments)
 {
     // get the first argument
     const Json& items = getJsonArgument(arguments[0]);
-    // if the argument is an array
-    if (items.is_array())
+    // throw an exception if the argument is not an array of numbers
+    if (!items.is_array())
     {
-        // calculate the sum of the array's items
-        double itemsSum = std::accumulate(items.cbegin(),
-                                          items.cend(),
-                                          0.0,
-                                          [](double sum,
-                                             const Json& item) -> double
-        {
-            if (item.is_number_integer())
-            {
-                return sum + item.get<Json::number_integer_t>();
-            }
-            else if (item.is_number_float())
-            {
-                return sum + item.get<Json::number_float_t>();
-            }
-            else
-            {
-                BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
-            }
-        });
-        // set the result
-        m_context = itemsSum;
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
-    // otherwise throw an exception
-    else
+    NumericArray numbers(items);
+    if (!numbers.isNumeric())
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
+    // set the result
+    m_context = numbers.sum();
 }
 
 void Interpreter::toArray(FunctionArgumentList &arguments)
@@ -1491,7 +2902,9 @@ void Interpreter::toString(JsonT&& value)
     // otherwise convert the value to a string by serializing it
     else
     {
-        m_context = value.dump();
+        String result;
+        appendJson(result, value);
+        m_context = std::move(result);
     }
 }
 
@@ -1522,17 +2935,14 @@ void Interpreter::toNumber(JsonT&& value)
     // if it's a string
     else if (value.is_string())
     {
-        // try to convert the string to a number
-        try
+        // try to convert the string to a number, if it's not a valid number
+        // let the default case handle the problem
+        Json result;
+        if (parseNumber(value.template get_ref<const String&>(), result))
         {
-            m_context = std::stod(value.template get_ref<const String&>());
+            m_context = std::move(result);
             return;
         }
-        // ignore the possible conversion error and let the default case
-        // handle the problem
-        catch (std::exception&)
-        {
-        }
     }
     // otherwise evaluate to null
     m_context = {};
@@ -1563,6 +2973,44 @@ void Interpreter::type(FunctionArgumentList &arguments)
     m_context = std::move(result);
 }
 
+void Interpreter::unique(FunctionArgumentList &arguments)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
+
+    // remove the duplicates of either a const lvalue ref to the array or of
+    // an rvalue ref whose items can be moved
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::unique<const Json&>, this, _1),
+        std::bind(&Interpreter::unique<Json&&>, this, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
+
+template <typename JsonT>
+void Interpreter::unique(JsonT&& array)
+{
+    using ItemType = std::conditional_t<
+        std::is_const<std::remove_reference_t<JsonT>>::value,
+        const Json&,
+        Json&&>;
+    // throw an exception if the argument is not an array
+    if (!array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+
+    // insert the items into a table of distinct values, which keeps the
+    // first occurrence of every item in the order of insertion
+    JsonHashTable items(array.size());
+    for (auto& item: array)
+    {
+        items.insert(static_cast<ItemType>(item));
+    }
+    m_context = Json(std::move(items.values()));
+}
+
 void Interpreter::values(FunctionArgumentList &arguments)
 {
     using std::placeholders::_1;
@@ -1614,14 +3062,67 @@ void Interpreter::max(FunctionArgumentList &arguments,
 template <typename JsonT>
 void Interpreter::max(const JsonComparator* comparator, JsonT&& array)
 {
-    // throw an exception if the array is not homogenous
-    if (!isComparableArray(array))
+    // throw an exception if the array is not homogenous, arrays starting
+    // with a number are checked while their largest item is searched
+    if (!array.is_array()
+        || ((array.empty() || !array.front().is_number())
+            && !isComparableArray(array)))
     {
         BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
     }
+    maxElement(comparator, std::forward<JsonT>(array));
+}
+
+void Interpreter::maxUnchecked(FunctionArgumentList &arguments,
+                               const JsonComparator &comparator)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
+
+    // evaluate the max function with either const lvalue ref to the array
+    // or as an rvalue ref
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::maxElement<const Json&>,
+                  this, &comparator, _1),
+        std::bind(&Interpreter::maxElement<Json&&>,
+                  this, &comparator, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
 
-    // try to find the largest item in the array
-    auto it = rng::max_element(array, *comparator);
+template <typename JsonT>
+void Interpreter::maxElement(const JsonComparator* comparator, JsonT&& array)
+{
+    auto it = std::end(array);
+    bool found = false;
+    // if the array contains numbers of the same type then find the smallest
+    // and largest items using their unboxed values, and select the one which
+    // the comparator considers to be the largest
+    if (!array.empty() && array.front().is_number())
+    {
+        NumericArray numbers(array);
+        // throw an exception if not all items are numbers
+        if (!numbers.isNumeric())
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        if (numbers.type() == NumericArray::Type::Integer
+            || numbers.type() == NumericArray::Type::Float)
+        {
+            auto indices = numbers.extremeIndices();
+            auto minIt = std::begin(array) + indices.first;
+            auto maxIt = std::begin(array) + indices.second;
+            it = (*comparator)(*minIt, *maxIt) ? maxIt : minIt;
+            found = true;
+        }
+    }
+    // otherwise try to find the largest item in the array with the
+    // comparator
+    if (!found)
+    {
+        it = rng::max_element(array, *comparator);
+    }
     // if the item was found evaluate to that item
     if (it != std::end(array))
     {
@@ -1642,7 +3143,7 @@ void Interpreter::maxBy(FunctionArgumentList &arguments,
     ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
     // get the second argument
     const ast::ExpressionNode& expression
-            = getArgument<ast::ExpressionNode>(arguments[1]);
+            = *getArgument<const ast::ExpressionNode*>(arguments[1]);
 
     // evaluate the map function with either const lvalue ref to the array
     // or as an rvalue ref
@@ -1709,6 +3210,195 @@ void Interpreter::maxBy(const ast::ExpressionNode* expression,
     }
 }
 
+void Interpreter::topK(FunctionArgumentList &arguments,
+                        const JsonComparator &comparator)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
+    // get the second argument
+    std::size_t count = toItemCount(getJsonArgument(arguments[1]));
+
+    // select the items of either a const lvalue ref to the array or of an
+    // rvalue ref whose items can be moved
+    const ast::ExpressionNode* expression = nullptr;
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::topK<const Json&>,
+                  this, expression, count, &comparator, _1),
+        std::bind(&Interpreter::topK<Json&&>,
+                  this, expression, count, &comparator, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
+
+void Interpreter::topKBy(FunctionArgumentList &arguments,
+                          const JsonComparator &comparator)
+{
+    using std::placeholders::_1;
+    // get the first argument
+    ContextValue& contextValue = getArgument<ContextValue>(arguments[0]);
+    // get the second argument
+    const ast::ExpressionNode& expression
+            = *getArgument<const ast::ExpressionNode*>(arguments[1]);
+    // get the third argument
+    std::size_t count = toItemCount(getJsonArgument(arguments[2]));
+
+    // select the items of either a const lvalue ref to the array or of an
+    // rvalue ref whose items can be moved
+    auto visitor = makeVisitor(
+        std::bind(&Interpreter::topK<const Json&>,
+                  this, &expression, count, &comparator, _1),
+        std::bind(&Interpreter::topK<Json&&>,
+                  this, &expression, count, &comparator, _1)
+    );
+    boost::apply_visitor(visitor, contextValue);
+}
+
+template <typename JsonT>
+void Interpreter::topK(const ast::ExpressionNode* expression,
+                        std::size_t count,
+                        const JsonComparator* comparator,
+                        JsonT&& array)
+{
+    using ItemType = std::conditional_t<
+        std::is_const<std::remove_reference_t<JsonT>>::value,
+        const Json&,
+        Json&&>;
+    // throw an exception if the argument is not an array
+    if (!array.is_array())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+
+    // use either the results of the expression or the items themselves as
+    // the keys of the items
+    std::vector<ContextValue> keys;
+    if (expression)
+    {
+        keys = evaluateKeys(expression, array);
+    }
+    else
+    {
+        keys.reserve(array.size());
+        for (const auto& item: array)
+        {
+            keys.emplace_back(std::cref(item));
+        }
+    }
+
+    // select the indices of the first items and copy or move the items at
+    // the selected indices into the result
+    auto indices = orderedIndices(keys, count, *comparator);
+    Json::array_t result;
+    result.reserve(indices.size());
+    for (auto index: indices)
+    {
+        result.push_back(static_cast<ItemType>(array[index]));
+    }
+    m_context = Json(std::move(result));
+}
+
+std::vector<ContextValue> Interpreter::evaluateKeys(
+        const ast::ExpressionNode* expression,
+        const Json& array)
+{
+    std::vector<ContextValue> keys;
+    keys.reserve(array.size());
+    for (const auto& item: array)
+    {
+        // evaluate the expression on the current item
+        m_context = assignContextValue(item);
+        visit(expression);
+        const Json& key = getJsonValue(m_context);
+        // if the result of the expression is not a number or string then
+        // throw an exception
+        if (!(key.is_number() || key.is_string()))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+        keys.push_back(std::move(m_context));
+    }
+    return keys;
+}
+
+std::vector<std::size_t> Interpreter::orderedIndices(
+        const std::vector<ContextValue>& keys,
+        std::size_t count,
+        const JsonComparator& comparator)
+{
+    // resolve the keys only once instead of on every comparison
+    std::vector<const Json*> values;
+    values.reserve(keys.size());
+    for (const auto& key: keys)
+    {
+        values.push_back(&getJsonValue(key));
+    }
+    // throw an exception if the keys are not either all numbers or all
+    // strings
+    if (!values.empty())
+    {
+        bool numbers = values.front()->is_number();
+        bool comparable = alg::all_of(values, [&](const Json* value) {
+            return numbers ? value->is_number() : value->is_string();
+        });
+        if (!comparable || !(numbers || values.front()->is_string()))
+        {
+            BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+        }
+    }
+
+    // order only the first count indices, and use the indices to order the
+    // equal keys so that their original order is kept
+    std::vector<std::size_t> indices(values.size());
+    std::iota(std::begin(indices), std::end(indices), 0);
+    auto last = std::begin(indices) + std::min(count, indices.size());
+    std::partial_sort(std::begin(indices), last, std::end(indices),
+                      [&](std::size_t first, std::size_t second) {
+        if (comparator(*values[first], *values[second]))
+        {
+            return true;
+        }
+        if (comparator(*values[second], *values[first]))
+        {
+            return false;
+        }
+        return first < second;
+    });
+    indices.erase(last, std::end(indices));
+    return indices;
+}
+
+std::size_t Interpreter::toItemCount(const Json& value)
+{
+    // throw an exception if the value is not a number
+    if (!value.is_number())
+    {
+        BOOST_THROW_EXCEPTION(InvalidFunctionArgumentType());
+    }
+    // throw an exception if the value is not a non negative integer
+    if (value.is_number_float())
+    {
+        double number = value.get<double>();
+        if (number < 0 || std::floor(number) != number)
+        {
+            BOOST_THROW_EXCEPTION(InvalidValue{});
+        }
+        // counts larger than any array select every item
+        if (number >= static_cast<double>(
+                std::numeric_limits<std::size_t>::max()))
+        {
+            return std::numeric_limits<std::size_t>::max();
+        }
+        return static_cast<std::size_t>(number);
+    }
+    if (value.is_number_integer() && !value.is_number_unsigned()
+            && value.get<Json::number_integer_t>() < 0)
+    {
+        BOOST_THROW_EXCEPTION(InvalidValue{});
+    }
+    return value.get<std::size_t>();
+}
+
 bool Interpreter::isComparableArray(const Json &array) const
 {
     // the default result is false
@@ -29,12 +29,21 @@
 #define INTERPRETER_H
 #include "src/interpreter/abstractvisitor.h"
 #include "jmespath/types.h"
+#include "jmespath/functions.h"
 #include "src/ast/expressionnode.h"
 #include "src/ast/functionexpressionnode.h"
+#include "src/interpreter/regexcache.h"
+#include "src/interpreter/logicoperatorprofile.h"
+#include "src/interpreter/filterkernel.h"
+#include "src/interpreter/hashindex.h"
+#include <cstdint>
 #include <functional>
 #include <tuple>
 #include <unordered_map>
+#include <deque>
+#include <mutex>
 #include <boost/variant.hpp>
+#include <boost/container/small_vector.hpp>
 
 namespace jmespath { namespace ast {
 
@@ -87,6 +96,23 @@ inline const Json& getJsonValue(const ContextValue& contextValue)
     }, contextValue);
 }
 
+/**
+ * @brief Extract the @ref Json value held by the given @a contextValue as a
+ * standalone value.
+ * @param[in] contextValue A @ref ContextValue variable.
+ * @return Returns the @ref Json value moved out of @a contextValue if it owns
+ * the value, otherwise a copy of the referred value which shares its
+ * containers with the original.
+ */
+inline Json takeJsonValue(ContextValue&& contextValue)
+{
+    if (auto value = boost::get<Json>(&contextValue))
+    {
+        return std::move(*value);
+    }
+    return getJsonValue(contextValue);
+}
+
 /**
  * @brief The Interpreter class evaluates the AST structure on a @ref Json
  * context.
@@ -99,6 +125,38 @@ public:
      * @brief Constructs an Interpreter object.
      */
     Interpreter();
+    /**
+     * @brief Resolves the built in function called by the given @a node and
+     * stores its identifier in the node, so it doesn't have to be looked up
+     * by its name on every evaluation.
+     *
+     * Unknown functions are left unresolved and reported when they get
+     * evaluated. The constant pattern arguments of the functions taking a
+     * regular expression are compiled and stored in the node.
+     * @param[in] node The function expression node.
+     * @throws InvalidFunctionArgumentArity
+     * @throws InvalidValue If a constant pattern argument is not a valid
+     * regular expression.
+     */
+    static void resolveFunction(ast::FunctionExpressionNode& node);
+    /**
+     * @brief Checks whether the given @a node calls a resolved built in
+     * function, whose result depends only on its arguments.
+     * @param[in] node The function expression node.
+     * @return Returns true if the @a node calls a built in function,
+     * otherwise false if it calls a custom or an unknown function.
+     */
+    static bool isBuiltInFunction(const ast::FunctionExpressionNode& node);
+    /**
+     * @brief Registers a custom function under the given @a name.
+     * @param[in] name The function's name.
+     * @param[in] signature The function's signature.
+     * @param[in] function The function's implementation.
+     * @throws InvalidAgrument
+     */
+    static void registerFunction(const String& name,
+                                 const FunctionSignature& signature,
+                                 CustomFunction function);
     /**
      * @brief Sets the context of the evaluation.
      * @param[in] value Json document to be used as the context.
@@ -163,57 +221,366 @@ public:
     void visit(const ast::FilterExpressionNode* node) override;
     void visit(const ast::FunctionExpressionNode* node) override;
     void visit(const ast::ExpressionArgumentNode*) override;
+    void visit(const ast::VariableRefNode* node) override;
+    void visit(const ast::LetExpressionNode* node) override;
+    void visit(const ast::PathNode* node) override;
     /** @}*/
 
 private:
+    /**
+     * @brief Function argument whose evaluation is deferred until the
+     * function requests its value.
+     */
+    struct LazyArgument
+    {
+        /**
+         * @brief The argument's expression.
+         */
+        const ast::ExpressionNode* expression;
+        /**
+         * @brief The context on which the @ref expression is evaluated.
+         */
+        const ContextValue* context;
+    };
     /**
      * @brief Type of the arguments in @ref FunctionArgumentList.
      */
-    using FunctionArgument
-        = boost::variant<boost::blank, ContextValue, ast::ExpressionNode>;
+    using FunctionArgument = boost::variant<boost::blank,
+                                            ContextValue,
+                                            const ast::ExpressionNode*,
+                                            LazyArgument>;
+    /**
+     * @brief The number of arguments which can be stored in a
+     * @ref FunctionArgumentList without allocating memory on the heap.
+     */
+    static constexpr std::size_t s_inlineArgumentCount = 4;
     /**
      * @brief List of @ref FunctionArgument objects.
      */
-    using FunctionArgumentList = std::vector<FunctionArgument>;
+    using FunctionArgumentList
+        = boost::container::small_vector<FunctionArgument,
+                                         s_inlineArgumentCount>;
     /**
-     * @brief Function wrapper type to which JMESPath built in function
+     * @brief Pointer type to which JMESPath built in function
      * implementations should conform to.
      */
-    using Function = std::function<void(FunctionArgumentList&)>;
+    using Function = void(Interpreter::*)(FunctionArgumentList&);
     /**
      * @brief The type of comparator functions used for comparing @ref Json
      * values.
      */
     using JsonComparator = std::function<bool(const Json&, const Json&)>;
     /**
-     * @brief Function argument arity validator predicate.
+     * @brief Native signed integer type used for index arithmetic while
+     * selecting the items of arrays.
+     *
+     * Unlike @ref Index it can't hold every value of an index in the AST, so
+     * indices are clamped into the range of the array before conversion.
+     */
+    using NativeIndex = std::int64_t;
+    /**
+     * @brief The type of the index which maps the keys of an object to their
+     * positions in the object.
+     */
+    using KeyPositions = std::unordered_map<String, std::size_t>;
+    /**
+     * @brief Specifies how the arguments of a built in function are
+     * evaluated.
      */
-    using ArgumentArityValidator = std::function<bool(const size_t&)>;
+    enum class ArgumentEvaluation
+    {
+        /**
+         * @brief The function needs a single @ref ContextValue argument, which
+         * can be evaluated by consuming the current context.
+         */
+        SingleValue,
+        /**
+         * @brief The function needs more than one @ref ContextValue argument,
+         * every one of them is evaluated before the function is called.
+         */
+        MultipleValues,
+        /**
+         * @brief The arguments are passed as @ref LazyArgument objects and
+         * they are only evaluated when the function requests their values.
+         */
+        OnDemand
+    };
+    /**
+     * @brief Specifies how the items with the same key are combined by the
+     * grouping functions.
+     */
+    enum class Grouping
+    {
+        /**
+         * @brief The items are collected into an array.
+         */
+        Group,
+        /**
+         * @brief The items are counted.
+         */
+        Count,
+        /**
+         * @brief The last item is kept.
+         */
+        Index
+    };
     /**
      * @brief Describes a built in function implementation.
+     */
+    struct FunctionDescriptor
+    {
+        /**
+         * @brief The function's JMESPath name.
+         */
+        String name;
+        /**
+         * @brief The minimum number of arguments.
+         */
+        std::size_t minArity;
+        /**
+         * @brief The maximum number of arguments.
+         */
+        std::size_t maxArity;
+        /**
+         * @brief Specifies how the function's arguments should be evaluated.
+         */
+        ArgumentEvaluation argumentEvaluation;
+        /**
+         * @brief Pointer to the function's implementation.
+         */
+        Function function;
+        /**
+         * @brief Pointer to the implementation which doesn't check the types
+         * of the arguments, or nullptr if the function has no such variant.
+         *
+         * It's used if the types of the arguments were proven to be valid
+         * during parsing.
+         */
+        Function uncheckedFunction = nullptr;
+        /**
+         * @brief Specifies whether the function's second argument is a
+         * regular expression pattern, which gets compiled during parsing if
+         * it's a constant string.
+         */
+        bool hasPattern = false;
+    };
+    /**
+     * @brief Returns the list of built in function descriptors, where the
+     * index of every descriptor is the identifier of the function.
+     * @return Reference to the list of descriptors.
+     */
+    static const std::vector<FunctionDescriptor>& functionDescriptors();
+    /**
+     * @brief Finds the descriptor of the function called by the given
+     * @a node.
+     *
+     * If the @a node wasn't resolved during parsing, the function is looked
+     * up by its name and its arity is validated.
+     * @param[in] node The function expression node.
+     * @return Reference to the function's descriptor.
+     * @throws UnknownFunction
+     * @throws InvalidFunctionArgumentArity
+     */
+    static const FunctionDescriptor& findFunction(
+            const ast::FunctionExpressionNode* node);
+    /**
+     * @brief Returns the mapping of built in function names to their
+     * identifiers.
+     * @return Reference to the mapping.
+     */
+    static const std::unordered_map<String, std::size_t>& functionIds();
+    /**
+     * @brief Validates that a function which accepts from @a minArity to
+     * @a maxArity number of arguments can be called with @a argumentCount
+     * number of arguments.
+     * @param[in] minArity The minimum number of arguments.
+     * @param[in] maxArity The maximum number of arguments.
+     * @param[in] argumentCount The number of arguments.
+     * @throws InvalidFunctionArgumentArity
+     */
+    static void validateArity(std::size_t minArity,
+                              std::size_t maxArity,
+                              std::size_t argumentCount);
+    /**
+     * @brief Describes a custom function implementation.
+     */
+    struct CustomFunctionDescriptor
+    {
+        /**
+         * @brief The function's JMESPath name.
+         */
+        String name;
+        /**
+         * @brief The minimum number of arguments.
+         */
+        std::size_t minArity;
+        /**
+         * @brief The maximum number of arguments.
+         */
+        std::size_t maxArity;
+        /**
+         * @brief The function's signature.
+         */
+        FunctionSignature signature;
+        /**
+         * @brief The function's implementation.
+         */
+        CustomFunction function;
+    };
+    /**
+     * @brief Stores the registered custom functions.
+     *
+     * The identifier of a custom function is the number of built in functions
+     * plus the index of its descriptor. Descriptors are never removed and a
+     * deque never relocates its items when appending, so pointers to the
+     * descriptors stay valid after the @ref mutex is released.
+     */
+    struct CustomFunctionRegistry
+    {
+        /**
+         * @brief Protects the members of the registry.
+         */
+        std::mutex mutex;
+        /**
+         * @brief The descriptors of the registered functions.
+         */
+        std::deque<CustomFunctionDescriptor> descriptors;
+        /**
+         * @brief Maps the function names to their identifiers.
+         */
+        std::unordered_map<String, std::size_t> functionIds;
+    };
+    /**
+     * @brief Returns the registry of custom functions.
+     * @return Reference to the registry.
+     */
+    static CustomFunctionRegistry& customFunctionRegistry();
+    /**
+     * @brief Finds the descriptor of the custom function called by the given
+     * @a node.
      *
-     * The tuple's first item is the comparator function used for comparing the
-     * actual number of arguments with the expected argument count, the second
-     * item marks whether the funciton needs a single @ref ContextValue or more,
-     * while the third item stores the callable functions wrapper.
+     * The descriptors of resolved calls are cached by the interpreter, so the
+     * registry only has to be locked the first time a function is called.
+     * @param[in] node The function expression node.
+     * @return Pointer to the function's descriptor or nullptr if the
+     * @a node doesn't call a custom function.
+     * @throws InvalidFunctionArgumentArity
+     */
+    const CustomFunctionDescriptor* findCustomFunction(
+            const ast::FunctionExpressionNode* node);
+    /**
+     * @brief Validates the arguments of a custom function call with constant
+     * values.
+     * @param[in] node The function expression node.
+     * @param[in] descriptor The function's descriptor.
+     * @throws InvalidFunctionArgumentType
+     */
+    static void validateConstantArguments(
+            const ast::FunctionExpressionNode& node,
+            const CustomFunctionDescriptor& descriptor);
+    /**
+     * @brief Returns the declared type of the argument at the given
+     * @a index.
+     * @param[in] signature The function's signature.
+     * @param[in] index The argument's position.
+     * @return The argument's type.
+     */
+    static ArgumentType argumentType(const FunctionSignature& signature,
+                                     std::size_t index);
+    /**
+     * @brief Checks whether the @a value matches the given argument @a type.
+     * @param[in] value A @ref Json value.
+     * @param[in] type An argument type.
+     * @return Returns true if the @a value matches the @a type, otherwise
+     * false.
+     */
+    static bool matchesType(const Json& value, ArgumentType type);
+    /**
+     * @brief Evaluates the arguments of the custom function call @a node and
+     * calls the function.
+     * @param[in] node The function expression node.
+     * @param[in] descriptor The function's descriptor.
+     * @throws InvalidFunctionArgumentType
+     */
+    void callCustomFunction(const ast::FunctionExpressionNode* node,
+                            const CustomFunctionDescriptor& descriptor);
+    /**
+     * @brief Provides access to the arguments of a custom function call.
      */
-    using FunctionDescriptor = std::tuple<ArgumentArityValidator,
-                                          bool,
-                                          Function>;
+    class CustomFunctionArguments;
     /**
      * @brief List of unevaluated function arguments.
      */
     using FunctionExpressionArgumentList
-        = std::vector<ast::FunctionExpressionNode::ArgumentType>;    
+        = std::vector<ast::FunctionExpressionNode::ArgumentType>;
+    /**
+     * @brief Function wrapper type which receives the results of a lazily
+     * evaluated projection one at a time. It should return false if it
+     * doesn't need any further results.
+     */
+    using ProjectionConsumer = std::function<bool(ContextValue&&)>;
     /**
      * @brief Stores the evaluation context.
      */
     ContextValue m_context;
     /**
-     * @brief Maps the JMESPath built in function names to their
-     * implementations.
+     * @brief Caches the descriptors of the called custom functions by the
+     * offset of their identifiers.
+     */
+    std::vector<const CustomFunctionDescriptor*> m_customFunctions;
+    /**
+     * @brief The compiled constant pattern argument of the function being
+     * called, or nullptr if it doesn't have one.
+     */
+    const std::regex* m_constantPattern = nullptr;
+    /**
+     * @brief Caches the compiled regular expressions of the pattern arguments
+     * which are not constants.
+     */
+    RegexCache m_regexCache;
+    /**
+     * @brief Holds the last compiled regular expression returned from the
+     * @ref m_regexCache, so it stays valid even if it gets evicted.
+     */
+    RegexPtr m_pattern;
+    /**
+     * @brief The reused buffers of the filter kernels.
+     */
+    FilterKernel::Workspace m_filterWorkspace;
+    /**
+     * @brief Describes a variable bound by a let expression.
+     */
+    struct Variable
+    {
+        /**
+         * @brief The name of the variable.
+         */
+        const String* name;
+        /**
+         * @brief The value of the variable.
+         */
+        ContextValue value;
+        /**
+         * @brief The bound expression if its evaluation is deferred and it
+         * hasn't been evaluated yet, otherwise nullptr.
+         */
+        const ast::ExpressionNode* expression;
+        /**
+         * @brief The context of the let expression, on which the deferred
+         * @ref expression gets evaluated.
+         */
+        const ContextValue* context;
+    };
+    /**
+     * @brief The scope stack of the variables bound by the let expressions
+     * being evaluated, with the innermost bindings at the back.
+     *
+     * The values are either references to the evaluated document or values
+     * moved out of the results of the bound expressions. A deque is used
+     * since the values of inner bindings might refer to the values of outer
+     * ones, which shouldn't move when further variables get bound.
      */
-    std::unordered_map<String, FunctionDescriptor> m_functionMap;
+    std::deque<Variable> m_variables;
     /**
      * @brief Evaluates the given @a node on the evaluation @a context.
      * @param[in] node Pointer to the node.
@@ -226,10 +593,16 @@ private:
     void visit(const ast::IdentifierNode *node, JsonT&& context);
     template <typename JsonT>
     void visit(const ast::ArrayItemNode *node, JsonT&& context);
+    /**
+     * @brief Evaluates the steps of the path @a node on the given @a context
+     * and stores only the final value in the context.
+     * @param[in] node The path node.
+     * @param[in] context An lvalue const ref or an rvalue ref to the context.
+     */
     template <typename JsonT>
-    void visit(const ast::FlattenOperatorNode* node, JsonT&& context);
+    void visit(const ast::PathNode* node, JsonT&& context);
     template <typename JsonT>
-    void visit(const ast::SliceExpressionNode* node, JsonT&& context);
+    void visit(const ast::FlattenOperatorNode* node, JsonT&& context);
     template <typename JsonT>
     void visit(const ast::HashWildcardNode* node, JsonT&& context);
     template <typename JsonT>
@@ -243,9 +616,17 @@ private:
      * @param[in] step The slice's step variable value.
      * @return Returns the endpoint's new value.
      */
-    Index adjustSliceEndpoint(size_t length,
-                              Index endpoint,
-                              Index step) const;
+    NativeIndex adjustSliceEndpoint(NativeIndex length,
+                                    NativeIndex endpoint,
+                                    NativeIndex step) const;
+    /**
+     * @brief Converts the @a index into a native index clamped into the
+     * range of -limit ... limit.
+     * @param[in] index The index value.
+     * @param[in] limit The largest magnitude of the result.
+     * @return Returns the clamped index.
+     */
+    static NativeIndex toNativeIndex(const Index& index, NativeIndex limit);
     /**
      * @brief Converts the @a json value to a boolean.
      * @param[in] json The @ref Json value that needs to be converted.
@@ -253,6 +634,45 @@ private:
      * list, empty object, empty string, null), otherwise returns true.
      */
     bool toBoolean(const Json& json) const;
+    /**
+     * @brief Evaluates the filtering @a condition on the given @a item.
+     * @param[in] condition The expression of the filtering condition.
+     * @param[in] item The @ref Json value on which the condition is
+     * evaluated.
+     * @return Returns true if the condition evaluates to a true like value,
+     * otherwise false.
+     */
+    bool evaluateCondition(const ast::ExpressionNode* condition,
+                           const Json& item);
+    /**
+     * @brief Finds the registered index of the @a array which can select the
+     * items satisfying the filter of the given @a node.
+     *
+     * An index can be used if the filter's condition compares the key
+     * expression of the index with a constant.
+     * @param[in] node The filter expression node.
+     * @param[in] array The filtered @ref Json value.
+     * @param[out] value The constant which the key is compared to.
+     * @return The index, or nullptr if there is no such index.
+     */
+    std::shared_ptr<const HashIndex> findHashIndex(
+            const ast::FilterExpressionNode* node,
+            const Json& array,
+            Json& value) const;
+    /**
+     * @brief Finds the first item of the @a array on which the @a condition
+     * evaluates to the @a expected boolean value. The items after the found
+     * item are not evaluated.
+     * @param[in] condition The expression of the filtering condition.
+     * @param[in] array A @ref Json array.
+     * @param[in] expected The boolean value that should be found.
+     * @return Returns the index of the found item, or the size of the
+     * @a array if there is no such item.
+     * @throws InvalidFunctionArgumentType
+     */
+    std::size_t findItem(const ast::ExpressionNode* condition,
+                         const Json& array,
+                         bool expected);
     /**
      * @brief Evaluates the projection of the given @a expression with the
      * evaluation @a context.
@@ -264,6 +684,103 @@ private:
     template <typename JsonT>
     void evaluateProjection(const ast::ExpressionNode* expression,
                             JsonT&& context);
+    /**
+     * @brief Checks whether the given @a expression is a projection which
+     * can be evaluated with @ref evaluateLazyProjection.
+     * @param[in] expression The expression that should be tested.
+     * @return Returns true if @a expression is a list or hash projection,
+     * otherwise returns false.
+     */
+    bool isLazyProjection(const ast::ExpressionNode& expression) const;
+    /**
+     * @brief Evaluates the projection @a expression on the current context
+     * without materializing its results. The results are passed to the
+     * @a consumer one by one until it signals that it doesn't need any
+     * further results, and the rest of the items are left unevaluated.
+     * @param[in] expression A projection expression for which
+     * @ref isLazyProjection returns true.
+     * @param[in] consumer The function which receives the results.
+     * @return Returns true if the projection evaluates to an array, or false
+     * if it evaluates to null.
+     */
+    bool evaluateLazyProjection(const ast::ExpressionNode& expression,
+                                const ProjectionConsumer& consumer);
+    /**
+     * @brief Evaluates the list projection @a node lazily on the evaluation
+     * @a context.
+     * @param[in] node Pointer to the node.
+     * @param[in] consumer The function which receives the results.
+     * @param[in] context An const lvalue reference or an rvalue reference to
+     * the result of the @a node's left side expression.
+     * @tparam JsonT The type of the @a context.
+     * @return Returns true if the projection evaluates to an array, or false
+     * if it evaluates to null.
+     */
+    template <typename JsonT>
+    bool evaluateLazyProjection(const ast::IndexExpressionNode* node,
+                                const ProjectionConsumer& consumer,
+                                JsonT&& context);
+    /**
+     * @brief Evaluates the hash projection @a node lazily on the evaluation
+     * @a context.
+     * @param[in] node Pointer to the node.
+     * @param[in] consumer The function which receives the results.
+     * @param[in] context An const lvalue reference or an rvalue reference to
+     * the result of the @a node's left side expression.
+     * @tparam JsonT The type of the @a context.
+     * @return Returns true if the projection evaluates to an array, or false
+     * if it evaluates to null.
+     */
+    template <typename JsonT>
+    bool evaluateLazyProjection(const ast::HashWildcardNode* node,
+                                const ProjectionConsumer& consumer,
+                                JsonT&& context);
+    /**
+     * @brief Evaluates the projected @a expression on the given @a item and
+     * passes the result to the @a consumer if it's not null.
+     * @param[in] expression The expression that gets projected.
+     * @param[in] consumer The function which receives the result.
+     * @param[in] item The item on which the @a expression is evaluated.
+     * @return Returns false if the @a consumer doesn't need any further
+     * results, otherwise returns true.
+     */
+    bool projectLazily(const ast::ExpressionNode* expression,
+                       const ProjectionConsumer& consumer,
+                       ContextValue&& item);
+    /**
+     * @brief Evaluates the array item selection @a node on the result of the
+     * given @a expression, evaluating only as much of the @a expression as
+     * necessary if it's a projection.
+     * @param[in] expression The expression which produces the array.
+     * @param[in] node An index expression node with an array item bracket
+     * specifier.
+     * @return Returns true if the selection has been evaluated, or false
+     * if it should be evaluated without early termination.
+     */
+    bool evaluateLazyArrayItem(const ast::ExpressionNode& expression,
+                               const ast::IndexExpressionNode* node);
+    /**
+     * @brief Evaluates the function expression @a node by consuming its
+     * projection argument lazily, if the function supports it.
+     * @param[in] node Pointer to the node.
+     * @param[in] function The implementation of the called function.
+     * @return Returns true if the function has been evaluated, or false
+     * if it should be evaluated with materialized arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    bool evaluateLazyFunction(const ast::FunctionExpressionNode* node,
+                              Function function);
+    /**
+     * @brief Calculates the normalized start, stop and step values of the
+     * slice expression @a node for an array with the given @a length.
+     * @param[in] node Pointer to the node.
+     * @param[in] length The length of the array that should be sliced.
+     * @return Returns the start, stop and step values in this order.
+     * @throws InvalidValue
+     */
+    std::tuple<NativeIndex, NativeIndex, NativeIndex> sliceIndices(
+            const ast::SliceExpressionNode* node,
+            size_t length) const;
     /**
      * @brief Evaluates a binary logic operator to the result of the left
      * side expression if it's binary value equals to @a shortCircuitValue
@@ -272,9 +789,42 @@ private:
      * @param[in] node Pointer to the node.
      * @param[in] shortCircuitValue Specifies what should be the boolean value
      * of the left side expression's result to do short circuit evaluation.
+     * @param[in] profile The profile of the operands if they can be
+     * evaluated in either order, otherwise nullptr.
      */
     void evaluateLogicOperator(const ast::BinaryExpressionNode* node,
-                               bool shortCircuitValue);
+                               bool shortCircuitValue,
+                               LogicOperatorProfile* profile);
+    /**
+     * @brief Evaluates a profiled binary logic operator by evaluating both
+     * of its operands, and adds their costs and results to the @a profile.
+     *
+     * The error of the right side expression is only raised if the left
+     * side expression doesn't short circuit the operator. The result is the
+     * boolean value of the operator's result.
+     * @param[in] node Pointer to the node.
+     * @param[in] shortCircuitValue Specifies what should be the boolean value
+     * of the left side expression's result to do short circuit evaluation.
+     * @param[in] profile The profile of the operands.
+     */
+    void evaluateSampledLogicOperator(const ast::BinaryExpressionNode* node,
+                                      bool shortCircuitValue,
+                                      LogicOperatorProfile* profile);
+    /**
+     * @brief Evaluates a profiled binary logic operator by evaluating its
+     * right side expression first.
+     *
+     * The left side expression is evaluated only if the result of the right
+     * side expression doesn't short circuit the operator, or if it raises an
+     * error, which is only propagated if the left side expression doesn't
+     * short circuit the operator either. The result is the boolean value of
+     * the operator's result.
+     * @param[in] node Pointer to the node.
+     * @param[in] shortCircuitValue Specifies what should be the boolean value
+     * of an operand's result to do short circuit evaluation.
+     */
+    void evaluateSwappedLogicOperator(const ast::BinaryExpressionNode* node,
+                                      bool shortCircuitValue);
     /**
      * @brief Evaluate the given function expression @a arguments.
      *
@@ -283,12 +833,16 @@ private:
      * child @ref ast::ExpressionNode.
      * @param[in] arguments List of arguments.
      * @param[in] contextValue A context used for evaluating the arguments.
+     * @param[in] evaluation Specifies how the arguments should be evaluated.
+     * @ref ast::ExpressionNode arguments are only wrapped into
+     * @ref LazyArgument objects if it's @ref ArgumentEvaluation::OnDemand.
      * @return List of evaluated function arguments, suitable for passing to
      * built in functions.
      */
     FunctionArgumentList evaluateArguments(
             const FunctionExpressionArgumentList& arguments,
-            const std::shared_ptr<ContextValue> &contextValue);
+            const ContextValue* contextValue,
+            ArgumentEvaluation evaluation);
     /**
      * @brief Converts the given function @a argument to the requsted type.
      * @param[in] argument A funciton argument value.
@@ -300,11 +854,14 @@ private:
     T& getArgument(FunctionArgument& argument) const;
     /**
      * @brief Creates a reference to the Json value held by the @a argument.
+     *
+     * If the @a argument is a @ref LazyArgument then it's evaluated first and
+     * its result is stored in the @a argument.
      * @param argument A funciton argument value.
      * @return Rreference to the Json value held by the @a argument.
      * @throws InvalidFunctionArgumentType
      */
-    const Json& getJsonArgument(FunctionArgument& argument) const;
+    const Json& getJsonArgument(FunctionArgument& argument);
     /**
      * @brief Calculates the absolute value of the first item in the given list
      * of @a arguments. The first item must be a number @ref Json value.
@@ -312,6 +869,28 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void abs(FunctionArgumentList& arguments);
+    /**
+     * @brief Checks whether the expression provided as the second item in
+     * @a arguments evaluates to a true like value on every item of the array
+     * provided as the first item in @a arguments. The evaluation stops at
+     * the first item which doesn't satisfy it.
+     *
+     * It's an extension which implements the all function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    void all(FunctionArgumentList& arguments);
+    /**
+     * @brief Checks whether the expression provided as the second item in
+     * @a arguments evaluates to a true like value on any of the items of the
+     * array provided as the first item in @a arguments. The evaluation stops
+     * at the first item which satisfies it.
+     *
+     * It's an extension which implements the any function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    void any(FunctionArgumentList& arguments);
     /**
      * @brief Calculates the average value of the items in the first item of the
      * given @a arguments. The first item must be an @ref Json array and every
@@ -335,6 +914,16 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void ceil(FunctionArgumentList& arguments);
+    /**
+     * @brief Counts the items of the array provided as the first item in
+     * @a arguments on which the expression provided as the second item in
+     * @a arguments evaluates to a true like value.
+     *
+     * It's an extension which implements the count_if function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    void countIf(FunctionArgumentList& arguments);
     /**
      * @brief Checks whether the first item of the given @a arguments ends with
      * the second item. The first and second item of @a arguments must be a
@@ -343,6 +932,17 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void endsWith(FunctionArgumentList& arguments);
+    /**
+     * @brief Finds the first item of the array provided as the first item in
+     * @a arguments on which the expression provided as the second item in
+     * @a arguments evaluates to a true like value, or evaluates to null if
+     * there is no such item. The evaluation stops at the found item.
+     *
+     * It's an extension which implements the find_first function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    void findFirst(FunctionArgumentList& arguments);
     /**
      * @brief Rounds down the first item of the given @a arguments to the next
      * lowest integer value. The first item should be a @ref Json number.
@@ -350,6 +950,37 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void floor(FunctionArgumentList& arguments);
+    /**
+     * @brief Groups the items of the array provided as the first item in the
+     * given @a arguments by the key which the expression provided as the
+     * second item in @a arguments evaluates to on them.
+     *
+     * It's an extension which implements the group_by, count_by and index_by
+     * functions.
+     * @param[in] arguments The list of the function's arguments.
+     * @tparam grouping Specifies how the items with the same key are
+     * combined.
+     * @throws InvalidFunctionArgumentType
+     */
+    template <Grouping grouping>
+    void groupBy(FunctionArgumentList& arguments);
+    /**
+     * @brief Groups the items of the @a array by the key which the
+     * @a expression evaluates to on them.
+     *
+     * The result is an object whose keys are in the order in which they were
+     * first seen. The key must be a string, items whose key is null are
+     * skipped.
+     * @param[in] expression The expression which evaluates to the key of the
+     * items.
+     * @param[in] array A @ref Json array.
+     * @tparam grouping Specifies how the items with the same key are
+     * combined.
+     * @tparam JsonT The type of the @a array.
+     * @throws InvalidFunctionArgumentType
+     */
+    template <Grouping grouping, typename JsonT>
+    void groupBy(const ast::ExpressionNode* expression, JsonT&& array);
     /**
      * @brief Joins every item in the array provided as the second item of the
      * given @a arguments with the first item as a separator. The first item
@@ -358,6 +989,62 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void join(FunctionArgumentList& arguments);
+    /**
+     * @brief Checks whether the regular expression provided as the second
+     * item of the given @a arguments matches any part of the string provided
+     * as the first item.
+     *
+     * It's an extension which implements the matches function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     * @throws InvalidValue
+     */
+    void matches(FunctionArgumentList& arguments);
+    /**
+     * @brief Extracts the first match of the regular expression provided as
+     * the second item of the given @a arguments from the string provided as
+     * the first item. If the expression contains a capturing group, then it
+     * evaluates to the text matched by the first group instead of the whole
+     * match, and it evaluates to null if there's no match.
+     *
+     * It's an extension which implements the regex_extract function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     * @throws InvalidValue
+     */
+    void regexExtract(FunctionArgumentList& arguments);
+    /**
+     * @brief Replaces every match of the regular expression provided as the
+     * second item of the given @a arguments in the string provided as the
+     * first item with the format string provided as the third item.
+     *
+     * It's an extension which implements the regex_replace function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     * @throws InvalidValue
+     */
+    void regexReplace(FunctionArgumentList& arguments);
+    /**
+     * @brief Returns the compiled regular expression of the @a pattern
+     * argument of the function being called, which is either the constant
+     * pattern compiled during parsing, or the one stored in the cache.
+     * @param[in] pattern The pattern argument.
+     * @return Reference to the compiled regular expression, which is valid
+     * until the next function call.
+     * @throws InvalidFunctionArgumentType If the @a pattern is not a string.
+     * @throws InvalidValue If the @a pattern is not a valid regular
+     * expression.
+     */
+    const std::regex& patternArgument(const Json& pattern);
+    /**
+     * @brief Compiles the pattern @a argument if it's a constant string.
+     * @param[in] argument The pattern argument of a function expression.
+     * @return Returns the compiled regular expression, or nullptr if the
+     * @a argument is not a constant string.
+     * @throws InvalidValue If the pattern is not a valid regular expression.
+     */
+    static RegexPtr compileConstantPattern(
+            const ast::FunctionExpressionNode::ArgumentType& argument);
     /**
      * @brief Extracts the keys from the object provided as the first item of
      * the given @a arguments.
@@ -403,15 +1090,20 @@ private:
      * @brief Merges the items of the @a sourceObject into @a object.
      * @param[in,out] object The object into which the items of the
      * @a sourceObject should be added.
+     * @param[in,out] positions The positions of the keys of @a object, which
+     * gets updated with the positions of the added keys.
      * @param[in] sourceObject ither an lvalue or rvalue reference to a
      * @ref Json object.
      * @tparam JsonT JsonT The type of the @a sourceObject.
      */
     template <typename JsonT>
-    void mergeObject(Json* object, JsonT&& sourceObject);
+    void mergeObject(Json::object_t& object,
+                     KeyPositions& positions,
+                     JsonT&& sourceObject);
     /**
      * @brief Accepts one or more items in @a arguments, and will evaluate them
-     * in order until a non null argument is encounted.
+     * in order until a non null argument is encounted. The arguments after
+     * the first non null argument are not evaluated.
      * @param[in] arguments The list of the function's arguments.
      * @throws InvalidFunctionArgumentType
      */
@@ -425,11 +1117,14 @@ private:
     void reverse(FunctionArgumentList& arguments);
     /**
      * @brief Reverses the order of the @a subject. It must either be
-     * an array or a string.
+     * an array or a string. Arrays are reversed in constant time by creating
+     * a reversed view of their items.
      * @param[in] subject A @ref Json array or string.
+     * @tparam JsonT The type of @a subject.
      * @throws InvalidFunctionArgumentType
      */
-    void reverse(Json&& subject);
+    template <typename JsonT>
+    void reverse(JsonT&& subject);
     /**
      * @brief Sorts the first item in the given @a arguments, which must either
      * be an array of numbers or an array of strings.
@@ -444,6 +1139,24 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void sort(Json&& array);
+    /**
+     * @brief Sorts the first item in the given @a arguments without checking
+     * its type, which must be proven to be either an array of numbers or an
+     * array of strings.
+     * @param[in] arguments The list of the function's arguments.
+     */
+    void sortUnchecked(FunctionArgumentList& arguments);
+    /**
+     * @brief Sorts the @a array without checking the types of its items,
+     * unless it starts with a number.
+     *
+     * Arrays of integers or of floating point numbers are sorted by their
+     * unboxed values, which also checks that all items are numbers.
+     * @param[in] array A @ref Json array of number or strings.
+     * @throws InvalidFunctionArgumentType If the @a array starts with a
+     * number and contains other items than numbers.
+     */
+    void sortArray(Json&& array);
     /**
      * @brief Sorts the first item in the given @a arguments, which must either
      * be an array of numbers or an array of strings. It uses the expression
@@ -529,6 +1242,24 @@ private:
      * @throws InvalidFunctionArgumentType
      */
     void type(FunctionArgumentList& arguments);
+    /**
+     * @brief Removes the duplicate items from the array provided as the first
+     * item in the given @a arguments.
+     *
+     * It's an extension which implements the unique function.
+     * @param[in] arguments The list of the function's arguments.
+     * @throws InvalidFunctionArgumentType
+     */
+    void unique(FunctionArgumentList& arguments);
+    /**
+     * @brief Removes the duplicate items from the @a array, keeping the first
+     * occurrence of every item in its original order.
+     * @param[in] array A @ref Json array.
+     * @tparam JsonT The type of @a array.
+     * @throws InvalidFunctionArgumentType
+     */
+    template <typename JsonT>
+    void unique(JsonT&& array);
     /**
      * @brief Extracts the values from the object provided as the first item of
      * the given @a arguments.
@@ -567,6 +1298,33 @@ private:
      */
     template <typename JsonT>
     void max(const JsonComparator* comparator, JsonT&& array);
+    /**
+     * @brief Finds the largest item in the array provided as the first item
+     * in the @a arguments without checking its type, which must be proven to
+     * be either an array of numbers or an array of strings.
+     * @param[in] arguments The list of the function's arguments.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values. It should return true if its first argument is less
+     * then its second argument.
+     */
+    void maxUnchecked(FunctionArgumentList& arguments,
+                      const JsonComparator& comparator);
+    /**
+     * @brief Finds the largest item in the @a array without checking the
+     * types of its items, unless it starts with a number.
+     *
+     * Arrays of integers or of floating point numbers are searched using the
+     * values of their items, which also checks that all items are numbers.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values. It should return true if its first argument is less
+     * then its second argument.
+     * @param[in] array A @ref Json array.
+     * @tparam JsonT The type of @a array.
+     * @throws InvalidFunctionArgumentType If the @a array starts with a
+     * number and contains other items than numbers.
+     */
+    template <typename JsonT>
+    void maxElement(const JsonComparator* comparator, JsonT&& array);
     /**
      * @brief Finds the largest item in the array provided as the first item
      * in the @a arguments, which must either be an array of numbers or an array
@@ -597,6 +1355,110 @@ private:
     void maxBy(const ast::ExpressionNode* expression,
                const JsonComparator* comparator,
                JsonT&& array);
+    /**
+     * @brief Selects the given number of items from the array provided as
+     * the first item in @a arguments, which come first in the order defined
+     * by the @a comparator. The number of items is provided as the second
+     * item in @a arguments. The array must either be an array of numbers or
+     * an array of strings.
+     *
+     * It's an extension which implements the top_k and bottom_k functions.
+     * @param[in] arguments The list of the function's arguments.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values. It should return true if its first argument should
+     * come before its second argument.
+     * @throws InvalidFunctionArgumentType
+     * @throws InvalidValue
+     */
+    void topK(FunctionArgumentList& arguments,
+              const JsonComparator& comparator);
+    /**
+     * @brief Selects the given number of items from the array provided as
+     * the first item in @a arguments, whose keys come first in the order
+     * defined by the @a comparator. The keys are the results of the
+     * expression provided as the second item in @a arguments evaluated on
+     * the items, and the number of items is provided as the third item.
+     *
+     * It's an extension which implements the top_k_by and bottom_k_by
+     * functions.
+     * @param[in] arguments The list of the function's arguments.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values. It should return true if its first argument should
+     * come before its second argument.
+     * @throws InvalidFunctionArgumentType
+     * @throws InvalidValue
+     */
+    void topKBy(FunctionArgumentList& arguments,
+                const JsonComparator& comparator);
+    /**
+     * @brief Selects @a count items from the @a array which come first in
+     * the order defined by the @a comparator.
+     * @param[in] expression The expression which evaluates to the key of the
+     * items, or nullptr if the items should be compared directly.
+     * @param[in] count The number of items that should be selected.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values.
+     * @param[in] array A @ref Json array.
+     * @tparam JsonT The type of the @a array.
+     * @throws InvalidFunctionArgumentType
+     */
+    template <typename JsonT>
+    void topK(const ast::ExpressionNode* expression,
+              std::size_t count,
+              const JsonComparator* comparator,
+              JsonT&& array);
+    /**
+     * @brief Evaluates the @a expression on every item of the @a array.
+     * @param[in] expression The expression which evaluates to the key of the
+     * items.
+     * @param[in] array A @ref Json array.
+     * @return Returns the list of the keys, which must either be numbers or
+     * strings.
+     * @throws InvalidFunctionArgumentType
+     */
+    std::vector<ContextValue> evaluateKeys(const ast::ExpressionNode* expression,
+                                           const Json& array);
+    /**
+     * @brief Orders the indices of the @a keys in the order of the keys
+     * defined by the @a comparator, keeping the original order of the equal
+     * keys.
+     *
+     * Only the first @a count indices are ordered with a partial sort, so it
+     * takes O(n log count) time.
+     * @param[in] keys The list of the keys, which must either be all numbers
+     * or all strings.
+     * @param[in] count The number of indices that should be returned.
+     * @param[in] comparator The comparator function used for comparing
+     * @ref Json values. It should return true if its first argument should
+     * come before its second argument.
+     * @return Returns the indices of the first @a count keys.
+     * @throws InvalidFunctionArgumentType
+     */
+    static std::vector<std::size_t> orderedIndices(
+            const std::vector<ContextValue>& keys,
+            std::size_t count,
+            const JsonComparator& comparator);
+    /**
+     * @brief Converts the @a value to the number of items that should be
+     * selected.
+     * @param[in] value A @ref Json value.
+     * @return Returns the number of items.
+     * @throws InvalidFunctionArgumentType If the @a value is not a number.
+     * @throws InvalidValue If the @a value is not a non negative integer.
+     */
+    static std::size_t toItemCount(const Json& value);
+    /**
+     * @brief Calls the given @a function with the @a arguments and a
+     * default constructed @a Comparator.
+     * @param[in] arguments The list of the function's arguments.
+     * @tparam function A function which takes a comparator argument.
+     * @tparam Comparator The comparator type used for comparing @ref Json
+     * values.
+     */
+    template <void(Interpreter::*function)(FunctionArgumentList&,
+                                            const JsonComparator&),
+              typename Comparator>
+    void callWithComparator(FunctionArgumentList& arguments);
     /**
      * @brief Checks whether @a array is a homogeneous array which contains
      * comparable types like strings and numbers.
@@ -0,0 +1,187 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/jsonhashtable.h"
+#include <functional>
+#include <boost/functional/hash.hpp>
+
+namespace jmespath { namespace interpreter {
+
+constexpr std::size_t JsonHashTable::s_emptySlot;
+
+std::size_t hashJson(const Json &value)
+{
+    std::size_t hash = static_cast<std::size_t>(value.type());
+    switch (value.type())
+    {
+    case Json::value_t::boolean:
+        boost::hash_combine(hash, value.get<bool>());
+        break;
+    case Json::value_t::number_integer:
+    case Json::value_t::number_unsigned:
+    case Json::value_t::number_float:
+    {
+        // every number type is hashed as a floating point number, since
+        // integers are equal to floating point numbers with the same value,
+        // and positive and negative zero are equal too
+        double number = value.get<double>();
+        hash = static_cast<std::size_t>(Json::value_t::number_float);
+        boost::hash_combine(hash, (number == 0) ? 0.0 : number);
+        break;
+    }
+    case Json::value_t::string:
+        boost::hash_combine(hash, value.get_ref<const String&>());
+        break;
+    case Json::value_t::array:
+        for (const auto& item: value.get_ref<const Json::array_t&>())
+        {
+            boost::hash_combine(hash, hashJson(item));
+        }
+        break;
+    case Json::value_t::object:
+    {
+        // the hashes of the key-value pairs are summed, so the hash doesn't
+        // depend on the order of the keys
+        std::size_t itemsHash = 0;
+        for (const auto& item: value.get_ref<const Json::object_t&>())
+        {
+            std::size_t itemHash = std::hash<String>{}(item.first);
+            boost::hash_combine(itemHash, hashJson(item.second));
+            itemsHash += itemHash;
+        }
+        boost::hash_combine(hash, itemsHash);
+        break;
+    }
+    default:
+        break;
+    }
+    return hash;
+}
+
+JsonHashTable::JsonHashTable(std::size_t expectedSize)
+{
+    // allocate a power of two number of slots which is at least twice the
+    // expected size
+    std::size_t slotCount = 8;
+    while (slotCount < expectedSize * 2)
+    {
+        slotCount *= 2;
+    }
+    m_slots.resize(slotCount, s_emptySlot);
+    m_values.reserve(expectedSize);
+    m_hashes.reserve(expectedSize);
+}
+
+std::pair<std::size_t, bool> JsonHashTable::insert(const Json &value)
+{
+    return insertValue(value);
+}
+
+std::pair<std::size_t, bool> JsonHashTable::insert(Json &&value)
+{
+    return insertValue(std::move(value));
+}
+
+std::pair<std::size_t, bool> JsonHashTable::find(const Json &value) const
+{
+    std::size_t slot = findSlot(value, hashJson(value));
+    if (m_slots[slot] == s_emptySlot)
+    {
+        return {0, false};
+    }
+    return {m_slots[slot] - 1, true};
+}
+
+std::size_t JsonHashTable::size() const
+{
+    return m_values.size();
+}
+
+Json::array_t &JsonHashTable::values()
+{
+    return m_values;
+}
+
+template <typename JsonT>
+std::pair<std::size_t, bool> JsonHashTable::insertValue(JsonT &&value)
+{
+    std::size_t hash = hashJson(value);
+    std::size_t slot = findSlot(value, hash);
+    // return the position of the equal value if it's already in the table
+    if (m_slots[slot] != s_emptySlot)
+    {
+        return {m_slots[slot] - 1, false};
+    }
+    // otherwise append the value and store its position in a free slot,
+    // looking up the slot again if the table had to grow
+    if ((m_values.size() + 1) * 2 > m_slots.size())
+    {
+        grow();
+        slot = findSlot(value, hash);
+    }
+    m_values.push_back(std::forward<JsonT>(value));
+    m_hashes.push_back(hash);
+    m_slots[slot] = m_values.size();
+    return {m_values.size() - 1, true};
+}
+
+std::size_t JsonHashTable::findSlot(const Json &value, std::size_t hash) const
+{
+    // probe the slots linearly starting from the slot selected by the hash
+    // until an empty slot or a slot with an equal value is found
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = hash & mask;
+    while (m_slots[slot] != s_emptySlot)
+    {
+        std::size_t position = m_slots[slot] - 1;
+        if ((m_hashes[position] == hash) && (m_values[position] == value))
+        {
+            break;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+void JsonHashTable::grow()
+{
+    // double the number of slots and reinsert the positions of the values
+    // into the slots selected by their hashes
+    std::vector<std::size_t> slots(m_slots.size() * 2, s_emptySlot);
+    const std::size_t mask = slots.size() - 1;
+    for (std::size_t position = 0; position < m_hashes.size(); ++position)
+    {
+        std::size_t slot = m_hashes[position] & mask;
+        while (slots[slot] != s_emptySlot)
+        {
+            slot = (slot + 1) & mask;
+        }
+        slots[slot] = position + 1;
+    }
+    m_slots = std::move(slots);
+}
+}} // namespace jmespath::interpreter
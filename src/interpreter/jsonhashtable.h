@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef JSONHASHTABLE_H
+#define JSONHASHTABLE_H
+#include "jmespath/types.h"
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief Calculates the structural hash of the given @a value.
+ *
+ * Values which are equal according to the equality comparison of @ref Json
+ * have the same hash. Numbers are hashed by their floating point value, so
+ * integers and equal floating point numbers have the same hash, and the hash
+ * of objects doesn't depend on the order of their keys.
+ * @param[in] value A @ref Json value.
+ * @return Returns the hash of @a value.
+ */
+std::size_t hashJson(const Json& value);
+
+/**
+ * @brief The JsonHashTable class is a set of distinct @ref Json values, which
+ * stores the values in the order of their insertion.
+ *
+ * The values are looked up with open addressing using their structural hash,
+ * so inserting a value takes amortized constant time.
+ */
+class JsonHashTable
+{
+public:
+    /**
+     * @brief Constructs an empty JsonHashTable object.
+     * @param[in] expectedSize The number of values the table should be able
+     * to store without growing.
+     */
+    explicit JsonHashTable(std::size_t expectedSize = 0);
+    /**
+     * @brief Inserts the @a value into the table if it doesn't contain an
+     * equal value yet.
+     * @param[in] value A @ref Json value.
+     * @return Returns the position of the equal value in the order of
+     * insertion, and true if the @a value was inserted.
+     */
+    std::pair<std::size_t, bool> insert(const Json& value);
+    /**
+     * @brief Overload for rvalue references, the @a value is only moved into
+     * the table if it gets inserted.
+     */
+    std::pair<std::size_t, bool> insert(Json&& value);
+    /**
+     * @brief Finds the value which is equal to the given @a value.
+     * @param[in] value A @ref Json value.
+     * @return Returns the position of the equal value in the order of
+     * insertion, and true if the table contains an equal value.
+     */
+    std::pair<std::size_t, bool> find(const Json& value) const;
+    /**
+     * @brief Returns the number of values in the table.
+     */
+    std::size_t size() const;
+    /**
+     * @brief Returns the values of the table in the order of their insertion.
+     */
+    Json::array_t& values();
+
+private:
+    /**
+     * @brief Marks the empty slots of the table.
+     */
+    static constexpr std::size_t s_emptySlot = 0;
+    /**
+     * @brief The values in the order of their insertion.
+     */
+    Json::array_t m_values;
+    /**
+     * @brief The hashes of the values in @ref m_values.
+     */
+    std::vector<std::size_t> m_hashes;
+    /**
+     * @brief The slots of the table, which store the position of the values
+     * plus one, or @ref s_emptySlot.
+     */
+    std::vector<std::size_t> m_slots;
+
+    /**
+     * @brief Finds the slot of the value which is equal to @a value, or the
+     * empty slot where it should be inserted.
+     * @param[in] value A @ref Json value.
+     * @param[in] hash The hash of @a value.
+     * @return Returns the index of the slot.
+     */
+    std::size_t findSlot(const Json& value, std::size_t hash) const;
+    /**
+     * @brief Doubles the number of slots, so the table stays at most half
+     * full.
+     */
+    void grow();
+    /**
+     * @brief Inserts the @a value into the table if it doesn't contain an
+     * equal value yet.
+     * @param[in] value Either an lvalue or rvalue reference to a @ref Json
+     * value.
+     * @tparam JsonT The type of the @a value.
+     * @return Returns the position of the equal value in the order of
+     * insertion, and true if the @a value was inserted.
+     */
+    template <typename JsonT>
+    std::pair<std::size_t, bool> insertValue(JsonT&& value);
+};
+}} // namespace jmespath::interpreter
+#endif // JSONHASHTABLE_H
@@ -0,0 +1,218 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/jsonserializer.h"
+#include "src/interpreter/numberconversion.h"
+#include "jmespath/exceptions.h"
+
+namespace jmespath { namespace interpreter {
+
+namespace {
+
+/**
+ * @brief Returns the length of the UTF-8 encoded multi byte sequence which
+ * starts at @a first.
+ * @param[in] first The position of the sequence's first byte.
+ * @param[in] last The end of the string.
+ * @return Returns the number of bytes in the sequence or 0 if it's not a
+ * valid sequence.
+ */
+std::size_t multiByteSequenceLength(const unsigned char* first,
+                                    const unsigned char* last)
+{
+    const unsigned char lead = *first;
+    std::size_t length = 0;
+    // the valid range of the second byte is restricted for some of the lead
+    // bytes to reject overlong encodings, surrogates and code points above
+    // U+10FFFF
+    unsigned char secondMin = 0x80;
+    unsigned char secondMax = 0xbf;
+    if (lead >= 0xc2 && lead <= 0xdf)
+    {
+        length = 2;
+    }
+    else if (lead >= 0xe0 && lead <= 0xef)
+    {
+        length = 3;
+        if (lead == 0xe0)
+        {
+            secondMin = 0xa0;
+        }
+        else if (lead == 0xed)
+        {
+            secondMax = 0x9f;
+        }
+    }
+    else if (lead >= 0xf0 && lead <= 0xf4)
+    {
+        length = 4;
+        if (lead == 0xf0)
+        {
+            secondMin = 0x90;
+        }
+        else if (lead == 0xf4)
+        {
+            secondMax = 0x8f;
+        }
+    }
+    if (length == 0 || static_cast<std::size_t>(last - first) < length
+        || first[1] < secondMin || first[1] > secondMax)
+    {
+        return 0;
+    }
+    for (std::size_t i = 2; i < length; ++i)
+    {
+        if ((first[i] & 0xc0) != 0x80)
+        {
+            return 0;
+        }
+    }
+    return length;
+}
+
+/**
+ * @brief Appends the @a string as a quoted and escaped JSON string to the
+ * @a output.
+ * @param[in,out] output The string to which the JSON string is appended.
+ * @param[in] string A UTF-8 encoded string.
+ * @throws InvalidValue If the @a string is not valid UTF-8.
+ */
+void appendString(String& output, const String& string)
+{
+    constexpr char hexDigits[] = "0123456789abcdef";
+    const auto* const first = reinterpret_cast<const unsigned char*>(
+        string.data());
+    const auto* const last = first + string.size();
+    output.push_back('"');
+    const auto* runFirst = first;
+    const auto* it = first;
+    while (it != last)
+    {
+        const unsigned char character = *it;
+        // extend the current run with the characters which are copied
+        // verbatim
+        if (character >= 0x20 && character < 0x80
+            && character != '"' && character != '\\')
+        {
+            ++it;
+            continue;
+        }
+        if (character >= 0x80)
+        {
+            const std::size_t length = multiByteSequenceLength(it, last);
+            if (length == 0)
+            {
+                BOOST_THROW_EXCEPTION(InvalidValue{});
+            }
+            it += length;
+            continue;
+        }
+        // append the current run and the escaped character
+        output.append(reinterpret_cast<const char*>(runFirst),
+                      static_cast<std::size_t>(it - runFirst));
+        switch (character)
+        {
+        case '"': output.append("\\\""); break;
+        case '\\': output.append("\\\\"); break;
+        case '\b': output.append("\\b"); break;
+        case '\f': output.append("\\f"); break;
+        case '\n': output.append("\\n"); break;
+        case '\r': output.append("\\r"); break;
+        case '\t': output.append("\\t"); break;
+        default:
+            output.append("\\u00");
+            output.push_back(hexDigits[character >> 4]);
+            output.push_back(hexDigits[character & 0xf]);
+            break;
+        }
+        runFirst = ++it;
+    }
+    output.append(reinterpret_cast<const char*>(runFirst),
+                  static_cast<std::size_t>(last - runFirst));
+    output.push_back('"');
+}
+} // anonymous namespace
+
+void appendJson(String &output, const Json &value)
+{
+    switch (value.type())
+    {
+    case Json::value_t::null:
+        output.append("null");
+        break;
+    case Json::value_t::boolean:
+        output.append(value.get<bool>() ? "true" : "false");
+        break;
+    case Json::value_t::number_integer:
+    case Json::value_t::number_unsigned:
+    case Json::value_t::number_float:
+        appendNumber(output, value);
+        break;
+    case Json::value_t::string:
+        appendString(output, value.get_ref<const String&>());
+        break;
+    case Json::value_t::array:
+    {
+        output.push_back('[');
+        bool first = true;
+        for (const auto& item: value)
+        {
+            if (!first)
+            {
+                output.push_back(',');
+            }
+            first = false;
+            appendJson(output, item);
+        }
+        output.push_back(']');
+        break;
+    }
+    case Json::value_t::object:
+    {
+        output.push_back('{');
+        bool first = true;
+        for (const auto& item: value.get_ref<const Json::object_t&>())
+        {
+            if (!first)
+            {
+                output.push_back(',');
+            }
+            first = false;
+            appendString(output, item.first);
+            output.push_back(':');
+            appendJson(output, item.second);
+        }
+        output.push_back('}');
+        break;
+    }
+    // binary and discarded values are left to Json::dump
+    default:
+        output.append(value.dump());
+        break;
+    }
+}
+}} // namespace jmespath::interpreter
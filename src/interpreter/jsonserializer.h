@@ -0,0 +1,47 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef JSONSERIALIZER_H
+#define JSONSERIALIZER_H
+#include "jmespath/types.h"
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief Appends the compact JSON text of the @a value to the @a output.
+ *
+ * The result is the same as the output of Json::dump, but numbers are
+ * formatted with @ref appendNumber and the runs of characters in strings
+ * which don't have to be escaped are appended at once, instead of writing
+ * the text through an output adapter character by character.
+ * @param[in,out] output The string to which the JSON text is appended.
+ * @param[in] value The @ref Json value which should be serialized.
+ * @throws InvalidValue If a string in the @a value is not valid UTF-8.
+ */
+void appendJson(String& output, const Json& value);
+}} // namespace jmespath::interpreter
+#endif // JSONSERIALIZER_H
@@ -0,0 +1,129 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/logicoperatorprofile.h"
+
+namespace jmespath { namespace interpreter {
+
+namespace {
+
+/**
+ * @brief The ratio of the expected costs of the current and the other order
+ * of the operands, above which the order gets changed.
+ */
+constexpr double s_switchRatio = 1.25;
+
+/**
+ * @brief Converts the given @a duration into nanoseconds.
+ * @param[in] duration The duration.
+ * @return The number of nanoseconds, which is never negative.
+ */
+std::uint64_t toNanoseconds(LogicOperatorProfile::Clock::duration duration)
+{
+    auto count = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                duration).count();
+    return count > 0 ? static_cast<std::uint64_t>(count) : 0;
+}
+} // anonymous namespace
+
+LogicOperatorProfile::LogicOperatorProfile(std::size_t warmupSamples,
+                                           std::size_t sampleInterval)
+    : m_warmupSamples{warmupSamples},
+      m_sampleInterval{sampleInterval > 0 ? sampleInterval : 1}
+{
+}
+
+bool LogicOperatorProfile::beginEvaluation()
+{
+    std::uint64_t index = m_evaluationCount.fetch_add(
+                1, std::memory_order_relaxed);
+    if (index < m_warmupSamples)
+    {
+        return true;
+    }
+    return (index - m_warmupSamples) % m_sampleInterval == 0;
+}
+
+void LogicOperatorProfile::addSample(Clock::duration leftCost,
+                                     bool leftShortCircuits,
+                                     Clock::duration rightCost,
+                                     bool rightShortCircuits)
+{
+    std::uint64_t samples = m_sampleCount.fetch_add(
+                1, std::memory_order_relaxed) + 1;
+    auto leftTotal = m_leftCost.fetch_add(
+                toNanoseconds(leftCost), std::memory_order_relaxed)
+            + toNanoseconds(leftCost);
+    auto rightTotal = m_rightCost.fetch_add(
+                toNanoseconds(rightCost), std::memory_order_relaxed)
+            + toNanoseconds(rightCost);
+    auto leftShortCircuitTotal = m_leftShortCircuits.fetch_add(
+                leftShortCircuits ? 1 : 0, std::memory_order_relaxed)
+            + (leftShortCircuits ? 1 : 0);
+    auto rightShortCircuitTotal = m_rightShortCircuits.fetch_add(
+                rightShortCircuits ? 1 : 0, std::memory_order_relaxed)
+            + (rightShortCircuits ? 1 : 0);
+    if (samples < m_warmupSamples)
+    {
+        return;
+    }
+
+    // the expected cost of an order is the cost of its first operand plus
+    // the cost of its second operand weighted by the rate of the evaluations
+    // where the first operand doesn't short circuit, both multiplied by the
+    // square of the sample count
+    auto n = static_cast<double>(samples);
+    double writtenCost = static_cast<double>(leftTotal) * n
+            + (n - static_cast<double>(leftShortCircuitTotal))
+            * static_cast<double>(rightTotal);
+    double swappedCost = static_cast<double>(rightTotal) * n
+            + (n - static_cast<double>(rightShortCircuitTotal))
+            * static_cast<double>(leftTotal);
+    if (m_swapped.load(std::memory_order_relaxed))
+    {
+        if (swappedCost > writtenCost * s_switchRatio)
+        {
+            m_swapped.store(false, std::memory_order_relaxed);
+        }
+    }
+    else if (writtenCost > swappedCost * s_switchRatio)
+    {
+        m_swapped.store(true, std::memory_order_relaxed);
+    }
+}
+
+bool LogicOperatorProfile::isSwapped() const
+{
+    return m_swapped.load(std::memory_order_relaxed);
+}
+
+std::size_t LogicOperatorProfile::sampleCount() const
+{
+    return static_cast<std::size_t>(
+                m_sampleCount.load(std::memory_order_relaxed));
+}
+}} // namespace jmespath::interpreter
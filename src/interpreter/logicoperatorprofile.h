@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef LOGICOPERATORPROFILE_H
+#define LOGICOPERATORPROFILE_H
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The LogicOperatorProfile class collects the cost and the short
+ * circuiting rate of the operands of a logic operator, and decides which of
+ * them should be evaluated first.
+ *
+ * The first evaluations of the operator are sampled, and after them only
+ * every n-th evaluation is. Both operands are evaluated and timed in a
+ * sampled evaluation, and the order with the lower expected cost is chosen
+ * once all the warm up samples are collected. The order is only changed
+ * later if the other order is expected to be considerably cheaper, so it
+ * doesn't flip between orders with similar costs.
+ * @note The member functions of the class are thread safe.
+ */
+class LogicOperatorProfile
+{
+public:
+    /**
+     * @brief The clock used for measuring the cost of the operands.
+     */
+    using Clock = std::chrono::steady_clock;
+    /**
+     * @brief Constructs a LogicOperatorProfile object without samples, which
+     * evaluates the operands in their written order.
+     * @param[in] warmupSamples The number of evaluations sampled before the
+     * order is first decided.
+     * @param[in] sampleInterval After the warm up, every @a sampleInterval-th
+     * evaluation is sampled.
+     */
+    explicit LogicOperatorProfile(std::size_t warmupSamples = 32,
+                                  std::size_t sampleInterval = 64);
+    /**
+     * @brief Registers the start of an evaluation of the operator.
+     * @return Returns true if the evaluation should be sampled, otherwise
+     * false.
+     */
+    bool beginEvaluation();
+    /**
+     * @brief Adds the sample of an evaluation and updates the order of the
+     * operands.
+     * @param[in] leftCost The time it took to evaluate the left operand.
+     * @param[in] leftShortCircuits Whether the result of the left operand
+     * short circuited the operator.
+     * @param[in] rightCost The time it took to evaluate the right operand.
+     * @param[in] rightShortCircuits Whether the result of the right operand
+     * would have short circuited the operator if it was evaluated first.
+     */
+    void addSample(Clock::duration leftCost,
+                   bool leftShortCircuits,
+                   Clock::duration rightCost,
+                   bool rightShortCircuits);
+    /**
+     * @brief Returns whether the right operand should be evaluated first.
+     * @return Returns true if the operands should be evaluated in reverse
+     * order, otherwise false.
+     */
+    bool isSwapped() const;
+    /**
+     * @brief Returns the number of sampled evaluations.
+     */
+    std::size_t sampleCount() const;
+
+private:
+    /**
+     * @brief The number of evaluations sampled before the order is first
+     * decided.
+     */
+    const std::size_t m_warmupSamples;
+    /**
+     * @brief The interval of the sampled evaluations after the warm up.
+     */
+    const std::size_t m_sampleInterval;
+    /**
+     * @brief The number of evaluations started.
+     */
+    std::atomic<std::uint64_t> m_evaluationCount{0};
+    /**
+     * @brief The number of sampled evaluations.
+     */
+    std::atomic<std::uint64_t> m_sampleCount{0};
+    /**
+     * @brief The total cost of the sampled left operands in nanoseconds.
+     */
+    std::atomic<std::uint64_t> m_leftCost{0};
+    /**
+     * @brief The total cost of the sampled right operands in nanoseconds.
+     */
+    std::atomic<std::uint64_t> m_rightCost{0};
+    /**
+     * @brief The number of samples where the left operand short circuited.
+     */
+    std::atomic<std::uint64_t> m_leftShortCircuits{0};
+    /**
+     * @brief The number of samples where the right operand would have
+     * short circuited.
+     */
+    std::atomic<std::uint64_t> m_rightShortCircuits{0};
+    /**
+     * @brief Whether the right operand should be evaluated first.
+     */
+    std::atomic<bool> m_swapped{false};
+};
+}} // namespace jmespath::interpreter
+#endif // LOGICOPERATORPROFILE_H
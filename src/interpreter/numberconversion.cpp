@@ -0,0 +1,348 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/numberconversion.h"
+#include <nlohmann/detail/conversions/to_chars.hpp>
+#include <cerrno>
+#include <clocale>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+
+namespace jmespath { namespace interpreter {
+
+namespace {
+
+/**
+ * @brief The two digit decimal representations of the numbers 0 ... 99.
+ */
+constexpr char digitPairs[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/**
+ * @brief The powers of 10 which can be represented exactly as a double.
+ */
+constexpr double exactPowersOfTen[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11, 1e12,
+    1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/**
+ * @brief The largest integer below which every integer can be represented
+ * exactly as a double.
+ */
+constexpr std::uint64_t maxExactInteger = std::uint64_t{1} << 53;
+
+/**
+ * @brief The magnitude of the smallest signed 64 bit integer.
+ */
+constexpr std::uint64_t minIntegerMagnitude = std::uint64_t{1} << 63;
+
+/**
+ * @brief Writes the decimal digits of the @a value backwards, ending at
+ * @a last.
+ * @param[in] value The number which should be written.
+ * @param[in] last The end of the output buffer.
+ * @return Returns the position of the first written character.
+ */
+char* formatUnsigned(std::uint64_t value, char* last)
+{
+    // write two digits at a time to halve the number of divisions
+    while (value >= 100)
+    {
+        const auto index = static_cast<std::size_t>(value % 100) * 2;
+        value /= 100;
+        *--last = digitPairs[index + 1];
+        *--last = digitPairs[index];
+    }
+    if (value >= 10)
+    {
+        const auto index = static_cast<std::size_t>(value) * 2;
+        *--last = digitPairs[index + 1];
+        *--last = digitPairs[index];
+    }
+    else
+    {
+        *--last = static_cast<char>('0' + value);
+    }
+    return last;
+}
+
+/**
+ * @brief Checks whether the @a character is a decimal digit.
+ * @param[in] character A character.
+ * @return Returns true if the @a character is a decimal digit.
+ */
+inline bool isDigit(char character)
+{
+    return character >= '0' && character <= '9';
+}
+
+/**
+ * @brief Converts the validated JSON number @a text to a double with strtod.
+ *
+ * The decimal point is replaced with the decimal point of the current locale
+ * since strtod expects that one.
+ * @param[in] text A valid JSON number.
+ * @param[out] result The parsed number.
+ * @return Returns false if the number is out of the range of a double.
+ */
+bool parseDouble(String text, double& result)
+{
+    const char decimalPoint = *std::localeconv()->decimal_point;
+    if (decimalPoint != '.')
+    {
+        const auto position = text.find('.');
+        if (position != String::npos)
+        {
+            text[position] = decimalPoint;
+        }
+    }
+    errno = 0;
+    result = std::strtod(text.c_str(), nullptr);
+    return errno != ERANGE;
+}
+} // anonymous namespace
+
+void appendNumber(String &output, const Json &number)
+{
+    char buffer[64];
+    char* last = buffer + sizeof(buffer);
+    char* first = last;
+    switch (number.type())
+    {
+    case Json::value_t::number_unsigned:
+        first = formatUnsigned(number.get<Json::number_unsigned_t>(), last);
+        break;
+    case Json::value_t::number_integer:
+    {
+        const auto value = number.get<Json::number_integer_t>();
+        // negate the value as an unsigned number, so the magnitude of the
+        // smallest integer doesn't overflow
+        auto magnitude = static_cast<std::uint64_t>(value);
+        if (value < 0)
+        {
+            magnitude = 0 - magnitude;
+        }
+        first = formatUnsigned(magnitude, last);
+        if (value < 0)
+        {
+            *--first = '-';
+        }
+        break;
+    }
+    case Json::value_t::number_float:
+    {
+        const auto value = number.get<Json::number_float_t>();
+        // NaN and infinity are serialized as null by Json::dump
+        if (!std::isfinite(value))
+        {
+            output.append("null");
+            return;
+        }
+        // produce the shortest representation with the same Grisu2
+        // implementation that Json::dump uses
+        first = buffer;
+        last = nlohmann::detail::to_chars(first, last, value);
+        break;
+    }
+    default:
+        output.append(number.dump());
+        return;
+    }
+    output.append(first, last);
+}
+
+String formatNumber(const Json &number)
+{
+    String result;
+    appendNumber(result, number);
+    return result;
+}
+
+bool parseNumber(const String &text, Json &result)
+{
+    const char* it = text.data();
+    const char* const last = it + text.size();
+    const bool negative = it != last && *it == '-';
+    if (negative)
+    {
+        ++it;
+    }
+    // the integer part is either a single zero or digits without leading
+    // zeros
+    const char* const integerFirst = it;
+    if (it == last || !isDigit(*it))
+    {
+        return false;
+    }
+    if (*it++ != '0')
+    {
+        while (it != last && isDigit(*it))
+        {
+            ++it;
+        }
+    }
+    const char* const integerLast = it;
+    // the optional fraction should contain at least one digit
+    const char* fractionFirst = it;
+    if (it != last && *it == '.')
+    {
+        fractionFirst = ++it;
+        if (it == last || !isDigit(*it))
+        {
+            return false;
+        }
+        while (it != last && isDigit(*it))
+        {
+            ++it;
+        }
+    }
+    const char* const fractionLast = it;
+    // the optional exponent should contain at least one digit, its value is
+    // saturated, since the result is zero or out of range anyway
+    long exponent = 0;
+    const bool hasExponent = it != last && (*it == 'e' || *it == 'E');
+    if (hasExponent)
+    {
+        ++it;
+        const bool negativeExponent = it != last && *it == '-';
+        if (it != last && (*it == '-' || *it == '+'))
+        {
+            ++it;
+        }
+        if (it == last || !isDigit(*it))
+        {
+            return false;
+        }
+        for (; it != last && isDigit(*it); ++it)
+        {
+            if (exponent < 100000)
+            {
+                exponent = exponent * 10 + (*it - '0');
+            }
+        }
+        if (negativeExponent)
+        {
+            exponent = -exponent;
+        }
+    }
+    // trailing characters are not allowed
+    if (it != last)
+    {
+        return false;
+    }
+
+    // numbers without fraction and exponent are integers if their magnitude
+    // fits into 64 bits, positive integers are unsigned like the integers
+    // parsed by Json::parse
+    if (fractionFirst == fractionLast && !hasExponent)
+    {
+        constexpr auto maxUnsigned = std::numeric_limits<std::uint64_t>::max();
+        std::uint64_t magnitude = 0;
+        bool overflow = false;
+        for (const char* digit = integerFirst; digit != integerLast; ++digit)
+        {
+            const auto value = static_cast<std::uint64_t>(*digit - '0');
+            if (magnitude > (maxUnsigned - value) / 10)
+            {
+                overflow = true;
+                break;
+            }
+            magnitude = magnitude * 10 + value;
+        }
+        if (!overflow && !negative)
+        {
+            result = static_cast<Json::number_unsigned_t>(magnitude);
+            return true;
+        }
+        if (!overflow && magnitude <= minIntegerMagnitude)
+        {
+            // the magnitude is at most 2^63, so subtracting one before the
+            // negation can't overflow
+            result = -static_cast<Json::number_integer_t>(magnitude - 1) - 1;
+            return true;
+        }
+    }
+
+    // collect the significant digits of the integer and fraction parts, if
+    // they fit into 53 bits and the power of 10 is exact, the result of a
+    // single multiplication or division is correctly rounded
+    std::uint64_t significand = 0;
+    int digitCount = 0;
+    auto collectDigits = [&](const char* first, const char* lastDigit) {
+        // stop after the 20th digit, since the significand can't be
+        // represented exactly anymore
+        for (; first != lastDigit && digitCount <= 19; ++first)
+        {
+            if (significand != 0 || *first != '0')
+            {
+                significand = significand * 10
+                    + static_cast<std::uint64_t>(*first - '0');
+                ++digitCount;
+            }
+        }
+    };
+    collectDigits(integerFirst, integerLast);
+    collectDigits(fractionFirst, fractionLast);
+    const long powerOfTen = exponent - (fractionLast - fractionFirst);
+    if (digitCount <= 19 && significand <= maxExactInteger
+        && powerOfTen >= -22 && powerOfTen <= 22)
+    {
+        auto value = static_cast<double>(significand);
+        if (powerOfTen < 0)
+        {
+            value /= exactPowersOfTen[-powerOfTen];
+        }
+        else
+        {
+            value *= exactPowersOfTen[powerOfTen];
+        }
+        result = negative ? -value : value;
+        return true;
+    }
+
+    // fall back to strtod for the rest of the numbers
+    double value;
+    if (!parseDouble(text, value))
+    {
+        return false;
+    }
+    result = value;
+    return true;
+}
+}} // namespace jmespath::interpreter
@@ -0,0 +1,71 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef NUMBERCONVERSION_H
+#define NUMBERCONVERSION_H
+#include "jmespath/types.h"
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief Appends the textual representation of the @a number to the
+ * @a output.
+ *
+ * Integers are written digit pairs at a time, floating point numbers are
+ * written with the shortest representation which parses back to the same
+ * value, and the result is the same as the output of Json::dump, but without
+ * creating a serializer object for every number.
+ * @param[in,out] output The string to which the number is appended.
+ * @param[in] number A @ref Json number.
+ */
+void appendNumber(String& output, const Json& number);
+
+/**
+ * @brief Converts the @a number to its textual representation.
+ * @param[in] number A @ref Json number.
+ * @return Returns the same string as Json::dump.
+ * @sa appendNumber
+ */
+String formatNumber(const Json& number);
+
+/**
+ * @brief Parses the @a text as a JSON number.
+ *
+ * Unlike std::stod, the parsing doesn't depend on the current locale, it
+ * doesn't skip whitespace and it doesn't accept trailing characters. Integers
+ * which fit into 64 bits are parsed as integers, and floating point numbers
+ * whose significant digits fit into 53 bits and whose power of ten can be
+ * represented exactly are computed without calling strtod.
+ * @param[in] text The string which should be parsed.
+ * @param[out] result The parsed number.
+ * @return Returns true if the whole @a text is a valid JSON number whose value
+ * is in the range of a double, otherwise returns false and leaves the
+ * @a result unchanged.
+ */
+bool parseNumber(const String& text, Json& result);
+}} // namespace jmespath::interpreter
+#endif // NUMBERCONVERSION_H
@@ -0,0 +1,200 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/numericarray.h"
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace jmespath { namespace interpreter {
+
+NumericArray::NumericArray(const Json &array)
+{
+    constexpr std::int64_t lowMask = 0xffffffff;
+    constexpr auto maxSigned = static_cast<Json::number_unsigned_t>(
+        std::numeric_limits<std::int64_t>::max());
+    const auto& items = array.get_ref<const Json::array_t&>();
+    m_size = items.size();
+    bool hasIntegers = false;
+    bool hasFloats = false;
+    std::int64_t minInteger = 0;
+    std::int64_t maxInteger = 0;
+    double minFloat = 0.0;
+    double maxFloat = 0.0;
+    // classify and aggregate the items in a single pass, since the loop is
+    // bound by reading the items from memory
+    for (std::size_t i = 0; i < m_size; ++i)
+    {
+        const Json& item = items[i];
+        std::int64_t integer = 0;
+        double number = 0.0;
+        switch (item.type())
+        {
+        case Json::value_t::number_integer:
+            integer = *item.get_ptr<const Json::number_integer_t*>();
+            break;
+        case Json::value_t::number_unsigned:
+        {
+            auto value = *item.get_ptr<const Json::number_unsigned_t*>();
+            // unsigned integers which don't fit into a signed integer can
+            // only be summed as floating point numbers, and they can't be
+            // compared with the other integers as floating point numbers
+            if (value > maxSigned)
+            {
+                hasIntegers = true;
+                hasFloats = true;
+                m_floatSum += static_cast<double>(value);
+                continue;
+            }
+            integer = static_cast<std::int64_t>(value);
+            break;
+        }
+        case Json::value_t::number_float:
+            number = *item.get_ptr<const Json::number_float_t*>();
+            m_floatSum += number;
+            // keep the index of the first smallest and largest number
+            if (!hasFloats || number < minFloat)
+            {
+                minFloat = number;
+                m_floatExtremes.first = i;
+            }
+            if (!hasFloats || maxFloat < number)
+            {
+                maxFloat = number;
+                m_floatExtremes.second = i;
+            }
+            hasFloats = true;
+            continue;
+        default:
+            m_type = Type::NotNumeric;
+            return;
+        }
+        // sum the upper and lower 32 bits of the integers separately, which
+        // can't overflow for less than 2^31 items, and add the integer to the
+        // floating point sum in case the exact sum overflows
+        m_highSum += integer >> 32;
+        m_lowSum += integer & lowMask;
+        m_floatSum += static_cast<double>(integer);
+        // keep the index of the first smallest and largest integer
+        if (!hasIntegers || integer < minInteger)
+        {
+            minInteger = integer;
+            m_integerExtremes.first = i;
+        }
+        if (!hasIntegers || maxInteger < integer)
+        {
+            maxInteger = integer;
+            m_integerExtremes.second = i;
+        }
+        hasIntegers = true;
+    }
+    if (hasFloats)
+    {
+        m_type = hasIntegers ? Type::Mixed : Type::Float;
+    }
+}
+
+NumericArray::Type NumericArray::type() const
+{
+    return m_type;
+}
+
+bool NumericArray::isNumeric() const
+{
+    return m_type != Type::NotNumeric;
+}
+
+std::size_t NumericArray::size() const
+{
+    return m_size;
+}
+
+Json NumericArray::sum() const
+{
+    constexpr std::int64_t lowMask = 0xffffffff;
+    constexpr std::size_t maxItems = std::size_t{1} << 31;
+    // carry the overflow of the lower bits into the upper bits, and evaluate
+    // to the exact sum of the integers if it fits into an integer
+    if (m_type == Type::Integer && m_size < maxItems)
+    {
+        std::int64_t highSum = m_highSum + (m_lowSum >> 32);
+        std::int64_t lowSum = m_lowSum & lowMask;
+        if (highSum >= std::numeric_limits<std::int32_t>::min()
+            && highSum <= std::numeric_limits<std::int32_t>::max())
+        {
+            return static_cast<std::int64_t>(
+                static_cast<std::uint64_t>(highSum) << 32
+                | static_cast<std::uint64_t>(lowSum));
+        }
+    }
+    // otherwise evaluate to the sum of the items calculated in their
+    // original order as floating point numbers
+    return m_floatSum;
+}
+
+double NumericArray::average() const
+{
+    return sum().get<double>() / m_size;
+}
+
+std::pair<std::size_t, std::size_t> NumericArray::extremeIndices() const
+{
+    return m_type == Type::Integer ? m_integerExtremes : m_floatExtremes;
+}
+void NumericArray::sort(Json &array) const
+{
+    if (m_type == Type::Integer)
+    {
+        sortValues<std::int64_t>(array);
+    }
+    else
+    {
+        sortValues<double>(array);
+    }
+}
+
+template <typename T>
+void NumericArray::sortValues(Json &array)
+{
+    // sort a packed copy of the values, which is faster than sorting the
+    // items themselves, since the values don't have to be compared by their
+    // types and they take half as much memory as the items
+    auto& items = array.get_ref<Json::array_t&>();
+    std::vector<T> values;
+    values.reserve(items.size());
+    for (const auto& item: items)
+    {
+        values.push_back(item.get<T>());
+    }
+    std::sort(values.begin(), values.end());
+    // store the sorted values in the items
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+        items[i] = values[i];
+    }
+}
+}} // namespace jmespath::interpreter
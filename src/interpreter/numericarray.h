@@ -0,0 +1,152 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef NUMERICARRAY_H
+#define NUMERICARRAY_H
+#include "jmespath/types.h"
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The NumericArray class classifies the items of a @ref Json array
+ * and calculates the aggregates of its numbers.
+ *
+ * The items are classified and aggregated in a single pass over the
+ * underlying container of the array, reading the values of the items without
+ * converting them to @ref Json values first.
+ */
+class NumericArray
+{
+public:
+    /**
+     * @brief The Type enum describes the types of the items of the array.
+     */
+    enum class Type
+    {
+        Integer,    ///< All items are integers.
+        Float,      ///< All items are floating point numbers.
+        Mixed,      ///< The items can only be handled as floating point
+                    ///< numbers, but they are not compared as such.
+        NotNumeric  ///< Some of the items are not numbers.
+    };
+
+    /**
+     * @brief Constructs a NumericArray object from the items of @a array.
+     *
+     * If some of the items are not numbers, then the aggregates are not
+     * calculated.
+     * @param[in] array A @ref Json array.
+     */
+    explicit NumericArray(const Json& array);
+    /**
+     * @brief Returns the type of the items of the array.
+     */
+    Type type() const;
+    /**
+     * @brief Returns true if all the items of the array are numbers.
+     */
+    bool isNumeric() const;
+    /**
+     * @brief Returns the number of items.
+     */
+    std::size_t size() const;
+    /**
+     * @brief Returns the sum of the items.
+     *
+     * The sum of integers is exact and results in an integer, unless it
+     * overflows. Otherwise the items are summed as floating point numbers in
+     * the order of the items.
+     */
+    Json sum() const;
+    /**
+     * @brief Returns the average of the items of a non empty array.
+     */
+    double average() const;
+    /**
+     * @brief Returns the index of the first occurrence of the smallest and
+     * of the largest item.
+     *
+     * It can only be used if the type of the array is @ref Type::Integer or
+     * @ref Type::Float, since integers and floating point numbers are
+     * compared differently, and the array must not be empty.
+     */
+    std::pair<std::size_t, std::size_t> extremeIndices() const;
+    /**
+     * @brief Sorts the items of the @a array in ascending order by sorting
+     * their unboxed values.
+     *
+     * It can only be used if the type of the array is @ref Type::Integer or
+     * @ref Type::Float, and the @a array must be the one the object was
+     * constructed from.
+     * @param[in] array A @ref Json array.
+     */
+    void sort(Json& array) const;
+
+private:
+    /**
+     * @brief The type of the items.
+     */
+    Type m_type = Type::Integer;
+    /**
+     * @brief The number of items.
+     */
+    std::size_t m_size = 0;
+    /**
+     * @brief The sum of the upper 32 bits of the integers.
+     */
+    std::int64_t m_highSum = 0;
+    /**
+     * @brief The sum of the lower 32 bits of the integers.
+     */
+    std::int64_t m_lowSum = 0;
+    /**
+     * @brief The sum of the items as floating point numbers.
+     */
+    double m_floatSum = 0.0;
+    /**
+     * @brief The indices of the first smallest and largest integer.
+     */
+    std::pair<std::size_t, std::size_t> m_integerExtremes;
+    /**
+     * @brief The indices of the first smallest and largest floating point
+     * number.
+     */
+    std::pair<std::size_t, std::size_t> m_floatExtremes;
+
+    /**
+     * @brief Sorts the items of the @a array by their values read as @a T.
+     * @param[in] array A @ref Json array.
+     * @tparam T The type of the values.
+     */
+    template <typename T>
+    static void sortValues(Json& array);
+};
+}} // namespace jmespath::interpreter
+#endif // NUMERICARRAY_H
@@ -0,0 +1,81 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/regexcache.h"
+#include "jmespath/exceptions.h"
+
+namespace jmespath { namespace interpreter {
+
+RegexPtr compileRegex(const String &pattern)
+{
+    try
+    {
+        return std::make_shared<const std::regex>(pattern);
+    }
+    catch (const std::regex_error&)
+    {
+        BOOST_THROW_EXCEPTION(InvalidValue{});
+    }
+}
+
+RegexCache::RegexCache(std::size_t capacity)
+    : m_capacity{capacity}
+{
+}
+
+RegexPtr RegexCache::get(const String &pattern)
+{
+    // if the pattern is already compiled then mark it as the most recently
+    // used one and return it
+    auto it = m_positions.find(pattern);
+    if (it != m_positions.end())
+    {
+        m_entries.splice(m_entries.begin(), m_entries, it->second);
+        return it->second->second;
+    }
+    // compile the pattern before changing the cache, so invalid patterns
+    // leave it intact
+    RegexPtr regex = compileRegex(pattern);
+    // evict the least recently used expression if the cache is full
+    if (m_entries.size() >= m_capacity && !m_entries.empty())
+    {
+        m_positions.erase(m_entries.back().first);
+        m_entries.pop_back();
+    }
+    if (m_capacity != 0)
+    {
+        m_entries.emplace_front(pattern, regex);
+        m_positions.emplace(pattern, m_entries.begin());
+    }
+    return regex;
+}
+
+std::size_t RegexCache::size() const
+{
+    return m_entries.size();
+}
+}} // namespace jmespath::interpreter
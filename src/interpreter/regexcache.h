@@ -0,0 +1,100 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef REGEXCACHE_H
+#define REGEXCACHE_H
+#include "jmespath/types.h"
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <regex>
+#include <unordered_map>
+#include <utility>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief Shared pointer to a compiled regular expression.
+ */
+using RegexPtr = std::shared_ptr<const std::regex>;
+
+/**
+ * @brief Compiles the given regular expression @a pattern, which uses the
+ * ECMAScript syntax.
+ * @param[in] pattern The regular expression.
+ * @return Returns the compiled regular expression.
+ * @throws InvalidValue If the @a pattern is not a valid regular expression.
+ */
+RegexPtr compileRegex(const String& pattern);
+
+/**
+ * @brief The RegexCache class is a bounded cache of compiled regular
+ * expressions, which evicts the least recently used expression when it's full.
+ */
+class RegexCache
+{
+public:
+    /**
+     * @brief Constructs an empty RegexCache object.
+     * @param[in] capacity The maximum number of stored expressions.
+     */
+    explicit RegexCache(std::size_t capacity = 64);
+    /**
+     * @brief Returns the compiled regular expression of the @a pattern,
+     * which is compiled if it's not in the cache yet.
+     * @param[in] pattern The regular expression.
+     * @return Returns the compiled regular expression.
+     * @throws InvalidValue If the @a pattern is not a valid regular
+     * expression.
+     */
+    RegexPtr get(const String& pattern);
+    /**
+     * @brief Returns the number of stored expressions.
+     */
+    std::size_t size() const;
+
+private:
+    /**
+     * @brief The type of the list of patterns and their compiled expressions.
+     */
+    using EntryList = std::list<std::pair<String, RegexPtr>>;
+    /**
+     * @brief The maximum number of stored expressions.
+     */
+    std::size_t m_capacity;
+    /**
+     * @brief The stored expressions from the most recently used to the least
+     * recently used.
+     */
+    EntryList m_entries;
+    /**
+     * @brief The positions of the stored expressions by their patterns.
+     */
+    std::unordered_map<String, EntryList::iterator> m_positions;
+};
+}} // namespace jmespath::interpreter
+#endif // REGEXCACHE_H
@@ -0,0 +1,114 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/stringkernels.h"
+#include <bitset>
+#include <cstdint>
+#include <cstring>
+
+namespace jmespath { namespace interpreter {
+
+std::size_t codePointCount(const String &string)
+{
+    constexpr std::uint64_t highBits = 0x8080808080808080;
+    const char* data = string.data();
+    const std::size_t size = string.size();
+    std::size_t continuationBytes = 0;
+    std::size_t i = 0;
+    // count the continuation bytes (10xxxxxx) in words of 8 bytes, the
+    // highest bit of a byte in the mask is set if the byte's highest bit is
+    // set and its second highest bit is not
+    for (; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t))
+    {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, sizeof(word));
+        // skip the words which contain only ASCII characters
+        if ((word & highBits) != 0)
+        {
+            std::bitset<64> mask{word & ~(word << 1) & highBits};
+            continuationBytes += mask.count();
+        }
+    }
+    // count the continuation bytes at the end of the string
+    for (; i < size; ++i)
+    {
+        if ((static_cast<unsigned char>(data[i]) & 0xc0) == 0x80)
+        {
+            ++continuationBytes;
+        }
+    }
+    // every code point is encoded with exactly one non continuation byte
+    return size - continuationBytes;
+}
+
+bool containsString(const String &subject, const String &substring)
+{
+    // the standard library searches for the first character of the
+    // substring with memchr, which is vectorized
+    return subject.find(substring) != String::npos;
+}
+
+bool startsWithString(const String &subject, const String &prefix)
+{
+    return subject.size() >= prefix.size()
+        && std::memcmp(subject.data(), prefix.data(), prefix.size()) == 0;
+}
+
+bool endsWithString(const String &subject, const String &suffix)
+{
+    return subject.size() >= suffix.size()
+        && std::memcmp(subject.data() + subject.size() - suffix.size(),
+                       suffix.data(), suffix.size()) == 0;
+}
+
+String joinStrings(const Json &array, const String &glue)
+{
+    const auto& items = array.get_ref<const Json::array_t&>();
+    // calculate the length of the result
+    std::size_t length = 0;
+    for (const auto& item: items)
+    {
+        length += item.get_ref<const String&>().size();
+    }
+    if (!items.empty())
+    {
+        length += glue.size() * (items.size() - 1);
+    }
+    // append the items and the glue strings to the result
+    String result;
+    result.reserve(length);
+    for (std::size_t i = 0; i < items.size(); ++i)
+    {
+        if (i != 0)
+        {
+            result.append(glue);
+        }
+        result.append(items[i].get_ref<const String&>());
+    }
+    return result;
+}
+}} // namespace jmespath::interpreter
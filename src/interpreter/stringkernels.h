@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef STRINGKERNELS_H
+#define STRINGKERNELS_H
+#include "jmespath/types.h"
+#include <cstddef>
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief Counts the code points of the UTF-8 encoded @a string.
+ *
+ * The bytes of the string are processed in words of 8 bytes, counting the
+ * continuation bytes of the multi byte sequences with bitwise operations, and
+ * words which contain only ASCII characters are skipped.
+ * @param[in] string A valid UTF-8 encoded string.
+ * @return Returns the number of code points.
+ */
+std::size_t codePointCount(const String& string);
+
+/**
+ * @brief Checks whether the @a subject contains the @a substring.
+ * @param[in] subject The string which should be searched.
+ * @param[in] substring The string which should be found.
+ * @return Returns true if the @a substring is empty or if it's found in the
+ * @a subject.
+ */
+bool containsString(const String& subject, const String& substring);
+
+/**
+ * @brief Checks whether the @a subject starts with the @a prefix.
+ * @param[in] subject A string.
+ * @param[in] prefix A string.
+ * @return Returns true if the @a subject starts with the @a prefix.
+ */
+bool startsWithString(const String& subject, const String& prefix);
+
+/**
+ * @brief Checks whether the @a subject ends with the @a suffix.
+ * @param[in] subject A string.
+ * @param[in] suffix A string.
+ * @return Returns true if the @a subject ends with the @a suffix.
+ */
+bool endsWithString(const String& subject, const String& suffix);
+
+/**
+ * @brief Joins the strings of the @a array with the @a glue string between
+ * them.
+ *
+ * The length of the result is calculated in advance, so the strings are
+ * copied only once, into a single allocation.
+ * @param[in] array A @ref Json array of strings.
+ * @param[in] glue The string which is placed between the items.
+ * @return Returns the joined string.
+ */
+String joinStrings(const Json& array, const String& glue);
+}} // namespace jmespath::interpreter
+#endif // STRINGKERNELS_H
@@ -0,0 +1,546 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/interpreter/typeinferrer.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace interpreter {
+
+bool InferredType::isComparableArray() const
+{
+    // the value must be an array whose items are either all numbers or all
+    // strings, or which is known to be empty
+    return (types == Array)
+            && ((itemTypes == Number) || (itemTypes == String)
+                || (itemTypes == 0));
+}
+
+InferredType TypeInferrer::infer(const ast::ExpressionNode &expression,
+                                 const InferredType &context)
+{
+    m_type = context;
+    visit(&expression);
+    return m_type;
+}
+
+void TypeInferrer::visit(const ast::AbstractNode *node)
+{
+    node->accept(this);
+}
+
+void TypeInferrer::visit(const ast::ExpressionNode *node)
+{
+    node->accept(this);
+}
+
+void TypeInferrer::visit(const ast::IdentifierNode *)
+{
+    // an identifier can only evaluate to a value if the context can be an
+    // object, otherwise it evaluates to null
+    if (m_type.types & InferredType::Object)
+    {
+        m_type = makeType(InferredType::Any);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Null);
+    }
+}
+
+void TypeInferrer::visit(const ast::RawStringNode *)
+{
+    m_type = makeType(InferredType::String);
+}
+
+void TypeInferrer::visit(const ast::LiteralNode *node)
+{
+    // parse the literal without throwing exceptions, since invalid literals
+    // are reported when the expression gets evaluated
+    Json value = Json::parse(node->literal, nullptr, false);
+    if (value.is_discarded())
+    {
+        m_type = makeType(InferredType::Any);
+    }
+    else
+    {
+        m_type = typeOf(value);
+    }
+}
+
+void TypeInferrer::visit(const ast::SubexpressionNode *node)
+{
+    // evaluate the left followed by the right expression
+    visit(&node->leftExpression);
+    visit(&node->rightExpression);
+}
+
+void TypeInferrer::visit(const ast::IndexExpressionNode *node)
+{
+    // infer the type of the left side expression
+    visit(&node->leftExpression);
+    // the index expression evaluates to null if the context isn't an array
+    bool canBeNull = (m_type.types & ~InferredType::Array) != 0;
+    if (!(m_type.types & InferredType::Array))
+    {
+        m_type = makeType(InferredType::Null);
+        return;
+    }
+    // infer the type of the bracket specifier on an array context
+    m_type = makeType(InferredType::Array, m_type.itemTypes);
+    visit(&node->bracketSpecifier);
+    // if the index expression also defines a projection then infer its type
+    if (node->isProjection())
+    {
+        inferProjection(&node->rightExpression);
+    }
+    if (canBeNull)
+    {
+        m_type.types |= InferredType::Null;
+    }
+}
+
+void TypeInferrer::visit(const ast::ArrayItemNode *)
+{
+    // the item might be out of range or the context might not be an array
+    if (m_type.types & InferredType::Array)
+    {
+        m_type = makeType(m_type.itemTypes | InferredType::Null);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Null);
+    }
+}
+
+void TypeInferrer::visit(const ast::FlattenOperatorNode *)
+{
+    if (m_type.types & InferredType::Array)
+    {
+        unsigned itemTypes = m_type.itemTypes;
+        // the items of nested arrays are unknown, so only the types of items
+        // which are not arrays can be inferred
+        if (itemTypes & InferredType::Array)
+        {
+            itemTypes = InferredType::Any;
+        }
+        unsigned types = InferredType::Array;
+        if (m_type.types & ~InferredType::Array)
+        {
+            types |= InferredType::Null;
+        }
+        m_type = makeType(types, itemTypes);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Null);
+    }
+}
+
+void TypeInferrer::visit(const ast::BracketSpecifierNode *node)
+{
+    node->accept(this);
+}
+
+void TypeInferrer::visit(const ast::SliceExpressionNode *)
+{
+    // slicing keeps the types of the items
+    keepArrayItems();
+}
+
+void TypeInferrer::visit(const ast::ListWildcardNode *)
+{
+    keepArrayItems();
+}
+
+void TypeInferrer::visit(const ast::HashWildcardNode *node)
+{
+    // infer the type of the left side expression
+    visit(&node->leftExpression);
+    // the hash wildcard evaluates to null if the context isn't an object
+    if (!(m_type.types & InferredType::Object))
+    {
+        m_type = makeType(InferredType::Null);
+        return;
+    }
+    bool canBeNull = (m_type.types & ~InferredType::Object) != 0;
+    // the values of the object are unknown
+    m_type = makeType(InferredType::Array);
+    inferProjection(&node->rightExpression);
+    if (canBeNull)
+    {
+        m_type.types |= InferredType::Null;
+    }
+}
+
+void TypeInferrer::visit(const ast::MultiselectListNode *node)
+{
+    // a multiselect list evaluates to null if the context is null
+    unsigned types = InferredType::Array
+            | (m_type.types & InferredType::Null);
+    InferredType context = m_type;
+    unsigned itemTypes = 0;
+    // the types of the items are the union of the expressions' types
+    for (const auto& expression: node->expressions)
+    {
+        m_type = context;
+        visit(&expression);
+        itemTypes |= m_type.types;
+    }
+    m_type = makeType(types, itemTypes);
+}
+
+void TypeInferrer::visit(const ast::MultiselectHashNode *node)
+{
+    // a multiselect hash evaluates to null if the context is null
+    unsigned types = InferredType::Object
+            | (m_type.types & InferredType::Null);
+    InferredType context = m_type;
+    // infer the types of subexpressions to make sure that the types of
+    // function arguments in them get inferred as well
+    for (const auto& keyValuePair: node->expressions)
+    {
+        m_type = context;
+        visit(&keyValuePair.second);
+    }
+    m_type = makeType(types);
+}
+
+void TypeInferrer::visit(const ast::NotExpressionNode *)
+{
+    m_type = makeType(InferredType::Boolean);
+}
+
+void TypeInferrer::visit(const ast::ComparatorExpressionNode *node)
+{
+    using Comparator = ast::ComparatorExpressionNode::Comparator;
+
+    // equality comparisons always evaluate to a boolean value, while
+    // ordering comparisons evaluate to null if a non number is involved
+    if ((node->comparator == Comparator::Equal)
+        || (node->comparator == Comparator::NotEqual))
+    {
+        m_type = makeType(InferredType::Boolean);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Boolean | InferredType::Null);
+    }
+}
+
+void TypeInferrer::visit(const ast::OrExpressionNode *node)
+{
+    inferLogicOperator(node);
+}
+
+void TypeInferrer::visit(const ast::AndExpressionNode *node)
+{
+    inferLogicOperator(node);
+}
+
+void TypeInferrer::visit(const ast::ParenExpressionNode *node)
+{
+    visit(&node->expression);
+}
+
+void TypeInferrer::visit(const ast::PipeExpressionNode *node)
+{
+    visit(&node->leftExpression);
+    visit(&node->rightExpression);
+}
+
+void TypeInferrer::visit(const ast::CurrentNode *)
+{
+}
+
+void TypeInferrer::visit(const ast::FilterExpressionNode *)
+{
+    // filtering keeps the types of the items
+    keepArrayItems();
+}
+
+void TypeInferrer::visit(const ast::FunctionExpressionNode *node)
+{
+    using Type = InferredType;
+    const String& name = node->functionName;
+    // the arguments are evaluated in the context of the function
+    InferredType context = m_type;
+    // custom functions and unresolved functions can return anything
+    if (!node->functionId)
+    {
+        m_type = makeType(Type::Any);
+        return;
+    }
+    // infer the type of the first argument if it's an expression
+    InferredType argumentType = makeType(Type::Any);
+    if (!node->arguments.empty())
+    {
+        argumentType = inferArgument(node->arguments.front(), context);
+    }
+
+    if ((name == "abs") || (name == "ceil") || (name == "floor")
+        || (name == "length") || (name == "sum") || (name == "count_if"))
+    {
+        m_type = makeType(Type::Number);
+    }
+    else if ((name == "avg") || (name == "to_number"))
+    {
+        m_type = makeType(Type::Number | Type::Null);
+    }
+    else if ((name == "contains") || (name == "starts_with")
+             || (name == "ends_with") || (name == "any") || (name == "all")
+             || (name == "matches"))
+    {
+        m_type = makeType(Type::Boolean);
+    }
+    else if ((name == "join") || (name == "to_string") || (name == "type")
+             || (name == "regex_replace"))
+    {
+        m_type = makeType(Type::String);
+    }
+    else if (name == "regex_extract")
+    {
+        m_type = makeType(Type::String | Type::Null);
+    }
+    else if (name == "keys")
+    {
+        m_type = makeType(Type::Array, Type::String);
+    }
+    else if (name == "values")
+    {
+        m_type = makeType(Type::Array);
+    }
+    else if ((name == "merge") || (name == "group_by")
+             || (name == "count_by") || (name == "index_by"))
+    {
+        m_type = makeType(Type::Object);
+    }
+    else if (name == "map")
+    {
+        // the result contains the results of the expression evaluated on
+        // the items of the array
+        InferredType arrayType = inferArgument(node->arguments.back(),
+                                               context);
+        m_type = makeType(Type::Array, inferArgument(
+            node->arguments.front(),
+            makeType(arrayType.itemTypes)).types);
+    }
+    else if ((name == "sort") || (name == "sort_by") || (name == "unique")
+             || (name == "top_k") || (name == "top_k_by")
+             || (name == "bottom_k") || (name == "bottom_k_by"))
+    {
+        m_type = makeType(Type::Array, argumentType.itemTypes);
+    }
+    else if ((name == "max") || (name == "min"))
+    {
+        // the function evaluates to null if the array is empty
+        m_type = makeType((argumentType.itemTypes
+                           & (Type::Number | Type::String)) | Type::Null);
+    }
+    else if ((name == "max_by") || (name == "min_by")
+             || (name == "find_first"))
+    {
+        m_type = makeType(argumentType.itemTypes | Type::Null);
+    }
+    else if (name == "reverse")
+    {
+        unsigned types = argumentType.types & (Type::Array | Type::String);
+        if (types == 0)
+        {
+            types = Type::Array | Type::String;
+        }
+        m_type = makeType(types, argumentType.itemTypes);
+    }
+    else if (name == "to_array")
+    {
+        // arrays are returned unchanged, while other values are wrapped in
+        // an array
+        unsigned itemTypes = argumentType.types & ~Type::Array;
+        if (argumentType.types & Type::Array)
+        {
+            itemTypes |= argumentType.itemTypes;
+        }
+        m_type = makeType(Type::Array, itemTypes);
+    }
+    else if (name == "not_null")
+    {
+        // the result is the first non null argument or null
+        unsigned types = Type::Null;
+        for (const auto& argument: node->arguments)
+        {
+            types |= inferArgument(argument, context).types;
+        }
+        m_type = makeType(types);
+    }
+    else
+    {
+        m_type = makeType(Type::Any);
+    }
+}
+
+void TypeInferrer::visit(const ast::ExpressionArgumentNode *node)
+{
+    visit(&node->expression);
+}
+
+void TypeInferrer::visit(const ast::VariableRefNode *)
+{
+    // the types of the bound values are not tracked, so a variable can
+    // evaluate to anything
+    m_type = makeType(InferredType::Any);
+}
+
+void TypeInferrer::visit(const ast::LetExpressionNode *node)
+{
+    // the child expression is evaluated in the context of the let expression
+    visit(&node->expression);
+}
+
+void TypeInferrer::visit(const ast::PathNode *node)
+{
+    // the path can only evaluate to a value if the context can hold the type
+    // of value which is required by its first step, but the later steps
+    // might still evaluate to null
+    unsigned requiredType = InferredType::Array;
+    if (!node->segments.empty()
+        && boost::get<String>(&node->segments.front()))
+    {
+        requiredType = InferredType::Object;
+    }
+    if (m_type.types & requiredType)
+    {
+        m_type = makeType(InferredType::Any);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Null);
+    }
+}
+
+InferredType TypeInferrer::makeType(unsigned types, unsigned itemTypes)
+{
+    InferredType type;
+    type.types = types;
+    // the types of the items are only relevant if the value can be an array
+    type.itemTypes = (types & InferredType::Array) ? itemTypes
+                                                   : InferredType::Any;
+    return type;
+}
+
+InferredType TypeInferrer::typeOf(const Json &value)
+{
+    switch (value.type())
+    {
+    case Json::value_t::null: return makeType(InferredType::Null);
+    case Json::value_t::boolean: return makeType(InferredType::Boolean);
+    case Json::value_t::number_integer:
+    case Json::value_t::number_unsigned:
+    case Json::value_t::number_float: return makeType(InferredType::Number);
+    case Json::value_t::string: return makeType(InferredType::String);
+    case Json::value_t::object: return makeType(InferredType::Object);
+    case Json::value_t::array:
+    {
+        // the item types are the union of the types of all items
+        unsigned itemTypes = 0;
+        for (const auto& item: value)
+        {
+            itemTypes |= typeOf(item).types;
+        }
+        return makeType(InferredType::Array, itemTypes);
+    }
+    default: return makeType(InferredType::Any);
+    }
+}
+
+InferredType TypeInferrer::inferArgument(
+        const ast::FunctionExpressionNode::ArgumentType &argument,
+        const InferredType &context)
+{
+    // only the types of expressions and expression arguments can be inferred
+    const auto* expression = boost::get<ast::ExpressionNode>(&argument);
+    const auto* expressionArgument
+            = boost::get<ast::ExpressionArgumentNode>(&argument);
+    TypeInferrer inferrer;
+    if (expression)
+    {
+        return inferrer.infer(*expression, context);
+    }
+    else if (expressionArgument)
+    {
+        return inferrer.infer(expressionArgument->expression, context);
+    }
+    return makeType(InferredType::Any);
+}
+
+void TypeInferrer::inferProjection(const ast::ExpressionNode *expression)
+{
+    // infer the type of the expression on the items of the array, the
+    // results which are null are not part of the projection's result
+    InferredType itemType = infer(*expression, makeType(m_type.itemTypes));
+    m_type = makeType(InferredType::Array,
+                      itemType.types & ~InferredType::Null);
+}
+
+void TypeInferrer::inferLogicOperator(const ast::BinaryExpressionNode *node)
+{
+    // the logic operator evaluates to either the left or the right side
+    // result
+    InferredType context = m_type;
+    visit(&node->leftExpression);
+    InferredType leftType = m_type;
+    m_type = context;
+    visit(&node->rightExpression);
+    unsigned itemTypes = 0;
+    if (leftType.types & InferredType::Array)
+    {
+        itemTypes |= leftType.itemTypes;
+    }
+    if (m_type.types & InferredType::Array)
+    {
+        itemTypes |= m_type.itemTypes;
+    }
+    m_type = makeType(leftType.types | m_type.types, itemTypes);
+}
+
+void TypeInferrer::keepArrayItems()
+{
+    // the operation evaluates to an array with the same items if the context
+    // is an array, otherwise to null
+    if (m_type.types & InferredType::Array)
+    {
+        unsigned types = InferredType::Array;
+        if (m_type.types & ~InferredType::Array)
+        {
+            types |= InferredType::Null;
+        }
+        m_type = makeType(types, m_type.itemTypes);
+    }
+    else
+    {
+        m_type = makeType(InferredType::Null);
+    }
+}
+}} // namespace jmespath::interpreter
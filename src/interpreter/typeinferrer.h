@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef TYPEINFERRER_H
+#define TYPEINFERRER_H
+#include "src/interpreter/abstractvisitor.h"
+#include "src/ast/functionexpressionnode.h"
+#include "jmespath/types.h"
+
+namespace jmespath { namespace ast {
+
+class ExpressionNode;
+class BinaryExpressionNode;
+}} // namespace jmespath::ast
+
+namespace jmespath { namespace interpreter {
+
+/**
+ * @brief The InferredType struct describes the set of types an expression
+ * can evaluate to.
+ */
+struct InferredType
+{
+    /**
+     * @brief Flags of the JSON value types.
+     */
+    enum Flag : unsigned
+    {
+        Null = 1u << 0,
+        Boolean = 1u << 1,
+        Number = 1u << 2,
+        String = 1u << 3,
+        Array = 1u << 4,
+        Object = 1u << 5,
+        Any = Null | Boolean | Number | String | Array | Object
+    };
+    /**
+     * @brief The possible types of the value.
+     */
+    unsigned types = Any;
+    /**
+     * @brief The possible types of the items if the value is an array.
+     */
+    unsigned itemTypes = Any;
+    /**
+     * @brief Checks whether the value is proven to be an array which contains
+     * only numbers or only strings.
+     * @return Returns true if the value is a comparable array, otherwise
+     * false.
+     */
+    bool isComparableArray() const;
+    /**
+     * @brief Equality compares this object to the @a other
+     * @param[in] other The object that should be compared.
+     * @return Returns true if this object is equal to the @a other, otherwise
+     * false
+     */
+    bool operator==(const InferredType& other) const
+    {
+        return (types == other.types) && (itemTypes == other.itemTypes);
+    }
+};
+
+/**
+ * @brief The TypeInferrer class infers the types an expression can evaluate
+ * to without evaluating it.
+ *
+ * The inference is conservative, it only excludes types that the expression
+ * can't evaluate to, based on literals, the return types of built in
+ * functions and the semantics of the expressions.
+ */
+class TypeInferrer : public AbstractVisitor
+{
+public:
+    /**
+     * @brief Infers the types the @a expression can evaluate to.
+     * @param[in] expression The expression whose type should be inferred.
+     * @param[in] context The type of the evaluation context.
+     * @return The inferred type.
+     */
+    InferredType infer(const ast::ExpressionNode& expression,
+                       const InferredType& context = {});
+    /**
+     * @brief Infers the type of the given function @a argument.
+     * @param[in] argument The argument of a function expression.
+     * @param[in] context The type of the evaluation context.
+     * @return The inferred type, which is @ref InferredType::Any if the
+     * @a argument is not an expression.
+     */
+    static InferredType inferArgument(
+            const ast::FunctionExpressionNode::ArgumentType& argument,
+            const InferredType& context = {});
+
+    /**
+     * @brief Infers the type of the given @a node in the current context.
+     * @param[in] node Pointer to the node
+     * @{
+     */
+    void visit(const ast::AbstractNode *node) override;
+    void visit(const ast::ExpressionNode *node) override;
+    void visit(const ast::IdentifierNode *node) override;
+    void visit(const ast::RawStringNode *node) override;
+    void visit(const ast::LiteralNode* node) override;
+    void visit(const ast::SubexpressionNode* node) override;
+    void visit(const ast::IndexExpressionNode* node) override;
+    void visit(const ast::ArrayItemNode* node) override;
+    void visit(const ast::FlattenOperatorNode*) override;
+    void visit(const ast::BracketSpecifierNode* node) override;
+    void visit(const ast::SliceExpressionNode* node) override;
+    void visit(const ast::ListWildcardNode*) override;
+    void visit(const ast::HashWildcardNode* node) override;
+    void visit(const ast::MultiselectListNode* node) override;
+    void visit(const ast::MultiselectHashNode* node) override;
+    void visit(const ast::NotExpressionNode* node) override;
+    void visit(const ast::ComparatorExpressionNode* node) override;
+    void visit(const ast::OrExpressionNode* node) override;
+    void visit(const ast::AndExpressionNode* node) override;
+    void visit(const ast::ParenExpressionNode* node) override;
+    void visit(const ast::PipeExpressionNode* node) override;
+    void visit(const ast::CurrentNode*) override;
+    void visit(const ast::FilterExpressionNode* node) override;
+    void visit(const ast::FunctionExpressionNode* node) override;
+    void visit(const ast::ExpressionArgumentNode*) override;
+    void visit(const ast::VariableRefNode*) override;
+    void visit(const ast::LetExpressionNode* node) override;
+    void visit(const ast::PathNode* node) override;
+    /** @}*/
+
+private:
+    /**
+     * @brief The type of the current context.
+     */
+    InferredType m_type;
+    /**
+     * @brief Creates a type which contains only the given @a types.
+     * @param[in] types The possible types of the value.
+     * @param[in] itemTypes The possible types of the items.
+     * @return The created type.
+     */
+    static InferredType makeType(unsigned types,
+                                 unsigned itemTypes = InferredType::Any);
+    /**
+     * @brief Infers the type of the given @a value.
+     * @param[in] value A @ref Json value.
+     * @return The type of the @a value.
+     */
+    static InferredType typeOf(const Json& value);
+    /**
+     * @brief Infers the type of projecting the @a expression on the items of
+     * the current context.
+     * @param[in] expression The projected expression.
+     */
+    void inferProjection(const ast::ExpressionNode* expression);
+    /**
+     * @brief Infers the type of the or and and expressions which evaluate
+     * to the result of either of their subexpressions.
+     * @param[in] node Pointer to the node.
+     */
+    void inferLogicOperator(const ast::BinaryExpressionNode* node);
+    /**
+     * @brief Infers the type of operations which select a subset of the items
+     * in the current context if it's an array.
+     */
+    void keepArrayItems();
+};
+}} // namespace jmespath::interpreter
+#endif // TYPEINFERRER_H
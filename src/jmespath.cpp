@@ -27,6 +27,7 @@
 ****************************************************************************/
 #include "jmespath/jmespath.h"
 #include "src/interpreter/interpreter.h"
+#include "src/interpreter/jsonserializer.h"
 #include <boost/hana.hpp>
 
 namespace jmespath {
@@ -72,4 +73,16 @@ search(const Expression &expression, JsonT&& document)
 template Json search<const Json&>(const Expression&, const Json&);
 template Json search<Json&>(const Expression&, Json&);
 template Json search<Json>(const Expression&, Json&&);
+
+String dump(const Json &value)
+{
+    String result;
+    interpreter::appendJson(result, value);
+    return result;
+}
+
+void dump(const Json &value, String &output)
+{
+    interpreter::appendJson(output, value);
+}
 } // namespace jmespath
@@ -0,0 +1,66 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef ABSTRACTPASS_H
+#define ABSTRACTPASS_H
+
+namespace jmespath { namespace ast {
+
+class ExpressionNode;
+}} // namespace jmespath::ast
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The AbstractPass class is the interface of the optimization passes
+ * which are run by the @ref Optimizer.
+ *
+ * A pass rewrites the AST in place into an equivalent one, which evaluates to
+ * the same result or throws the same exception for every document. The same
+ * pass object can be run on any number of ASTs.
+ */
+class AbstractPass
+{
+public:
+    /**
+     * @brief Destroys the AbstractPass object.
+     */
+    virtual ~AbstractPass();
+    /**
+     * @brief Returns the name of the pass, which identifies it in the
+     * @ref Optimizer.
+     * @return The name of the pass.
+     */
+    virtual const char* name() const = 0;
+    /**
+     * @brief Rewrites the given @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    virtual void run(ast::ExpressionNode& expression) = 0;
+};
+}} // namespace jmespath::optimizer
+#endif // ABSTRACTPASS_H
@@ -0,0 +1,283 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/adaptivelogicorderer.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/interpreter/interpreter.h"
+#include "src/ast/allnodes.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Whether the expressions get profiled.
+ */
+std::atomic<bool> s_enabled{false};
+} // anonymous namespace
+
+AdaptiveLogicOrderer::AdaptiveLogicOrderer(std::size_t warmupSamples,
+                                           std::size_t sampleInterval)
+    : m_warmupSamples{warmupSamples},
+      m_sampleInterval{sampleInterval}
+{
+}
+
+const char *AdaptiveLogicOrderer::name() const
+{
+    return "adaptive-logic-ordering";
+}
+
+void AdaptiveLogicOrderer::run(ast::ExpressionNode &expression)
+{
+    m_profiledOperators.clear();
+    m_variables.clear();
+    profileExpression(expression);
+}
+
+const std::vector<ProfiledOperator> &
+AdaptiveLogicOrderer::profiledOperators() const
+{
+    return m_profiledOperators;
+}
+
+void AdaptiveLogicOrderer::setEnabled(bool enabled)
+{
+    s_enabled.store(enabled);
+}
+
+bool AdaptiveLogicOrderer::isEnabled()
+{
+    return s_enabled.load();
+}
+
+void AdaptiveLogicOrderer::profileExpression(ast::ExpressionNode &node)
+{
+    // the operands of not expressions and the conditions of filters are
+    // only tested for their truthiness
+    if (auto* notNode = match<ast::NotExpressionNode>(node))
+    {
+        profileCondition(notNode->expression);
+    }
+    else if (auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        profileExpression(indexNode->leftExpression);
+        if (auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                &indexNode->bracketSpecifier.value))
+        {
+            profileCondition(filterNode->expression);
+        }
+        profileExpression(indexNode->rightExpression);
+    }
+    else if (auto* letNode = match<ast::LetExpressionNode>(node))
+    {
+        profileLetExpression(*letNode,
+                             &AdaptiveLogicOrderer::profileExpression);
+    }
+    else
+    {
+        forEachChild(node, [this](ast::ExpressionNode& child) {
+            profileExpression(child);
+        });
+    }
+}
+
+void AdaptiveLogicOrderer::profileCondition(ast::ExpressionNode &condition)
+{
+    ast::BinaryExpressionNode* operatorNode = nullptr;
+    std::shared_ptr<interpreter::LogicOperatorProfile>* profile = nullptr;
+    if (auto* andNode = match<ast::AndExpressionNode>(condition))
+    {
+        operatorNode = andNode;
+        profile = &andNode->profile;
+    }
+    else if (auto* orNode = match<ast::OrExpressionNode>(condition))
+    {
+        operatorNode = orNode;
+        profile = &orNode->profile;
+    }
+
+    if (operatorNode)
+    {
+        // profile the operator if evaluating its right operand first can't
+        // change the result of the evaluation
+        profile->reset();
+        if (isInfallible(operatorNode->leftExpression)
+            && isPure(operatorNode->rightExpression))
+        {
+            *profile = std::make_shared<interpreter::LogicOperatorProfile>(
+                        m_warmupSamples, m_sampleInterval);
+            m_profiledOperators.push_back({m_formatter.format(condition),
+                                           *profile});
+        }
+        // the operands of the operator are tested for their truthiness
+        // when the result of the operator is
+        profileCondition(operatorNode->leftExpression);
+        profileCondition(operatorNode->rightExpression);
+    }
+    else if (auto* parenNode = match<ast::ParenExpressionNode>(condition))
+    {
+        profileCondition(parenNode->expression);
+    }
+    else if (auto* letNode = match<ast::LetExpressionNode>(condition))
+    {
+        profileLetExpression(*letNode,
+                             &AdaptiveLogicOrderer::profileCondition);
+    }
+    else
+    {
+        profileExpression(condition);
+    }
+}
+
+void AdaptiveLogicOrderer::profileLetExpression(
+        ast::LetExpressionNode &node,
+        void (AdaptiveLogicOrderer::*profileChild)(ast::ExpressionNode&))
+{
+    // the bound expressions are evaluated in the enclosing scope
+    std::vector<VariableInfo> variables;
+    for (auto& binding: node.bindings)
+    {
+        profileExpression(binding.second);
+        // the errors of eagerly bound expressions are raised before the
+        // evaluation of the child expression
+        variables.push_back({&binding.first.name,
+                             !node.deferred || isInfallible(binding.second),
+                             isPure(binding.second)});
+    }
+    const std::size_t scopeBegin = m_variables.size();
+    m_variables.insert(m_variables.end(), variables.begin(), variables.end());
+    (this->*profileChild)(node.expression);
+    m_variables.erase(m_variables.begin()
+                      + static_cast<std::ptrdiff_t>(scopeBegin),
+                      m_variables.end());
+}
+
+bool AdaptiveLogicOrderer::isInfallible(ast::ExpressionNode &node)
+{
+    // functions can raise errors for the types or values of their arguments
+    if (match<ast::FunctionExpressionNode>(node))
+    {
+        return false;
+    }
+    if (const auto* variableNode = match<ast::VariableRefNode>(node))
+    {
+        const VariableInfo* variable = findVariable(variableNode->name);
+        return variable && variable->infallible;
+    }
+    if (auto* letNode = match<ast::LetExpressionNode>(node))
+    {
+        bool result = true;
+        std::vector<VariableInfo> variables;
+        for (auto& binding: letNode->bindings)
+        {
+            bool infallible = isInfallible(binding.second);
+            result = result && (letNode->deferred || infallible);
+            variables.push_back({&binding.first.name, infallible, true});
+        }
+        const std::size_t scopeBegin = m_variables.size();
+        m_variables.insert(m_variables.end(),
+                           variables.begin(),
+                           variables.end());
+        result = result && isInfallible(letNode->expression);
+        m_variables.erase(m_variables.begin()
+                          + static_cast<std::ptrdiff_t>(scopeBegin),
+                          m_variables.end());
+        return result;
+    }
+    if (const auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        // slices with zero steps are invalid
+        const auto* sliceNode = boost::get<ast::SliceExpressionNode>(
+                    &indexNode->bracketSpecifier.value);
+        if (sliceNode && sliceNode->step && *sliceNode->step == 0)
+        {
+            return false;
+        }
+    }
+    bool result = true;
+    forEachChild(node, [this, &result](ast::ExpressionNode& child) {
+        result = result && isInfallible(child);
+    });
+    return result;
+}
+
+bool AdaptiveLogicOrderer::isPure(ast::ExpressionNode &node)
+{
+    // custom functions might have side effects
+    if (const auto* functionNode = match<ast::FunctionExpressionNode>(node))
+    {
+        if (!interpreter::Interpreter::isBuiltInFunction(*functionNode))
+        {
+            return false;
+        }
+    }
+    else if (const auto* variableNode = match<ast::VariableRefNode>(node))
+    {
+        const VariableInfo* variable = findVariable(variableNode->name);
+        return !variable || variable->pure;
+    }
+    else if (auto* letNode = match<ast::LetExpressionNode>(node))
+    {
+        bool result = true;
+        std::vector<VariableInfo> variables;
+        for (auto& binding: letNode->bindings)
+        {
+            bool pure = isPure(binding.second);
+            result = result && pure;
+            variables.push_back({&binding.first.name, false, pure});
+        }
+        const std::size_t scopeBegin = m_variables.size();
+        m_variables.insert(m_variables.end(),
+                           variables.begin(),
+                           variables.end());
+        result = result && isPure(letNode->expression);
+        m_variables.erase(m_variables.begin()
+                          + static_cast<std::ptrdiff_t>(scopeBegin),
+                          m_variables.end());
+        return result;
+    }
+    bool result = true;
+    forEachChild(node, [this, &result](ast::ExpressionNode& child) {
+        result = result && isPure(child);
+    });
+    return result;
+}
+
+const AdaptiveLogicOrderer::VariableInfo *
+AdaptiveLogicOrderer::findVariable(const String &name) const
+{
+    auto it = std::find_if(m_variables.rbegin(), m_variables.rend(),
+                           [&name](const VariableInfo& variable) {
+        return *variable.name == name;
+    });
+    return it != m_variables.rend() ? &*it : nullptr;
+}
+}} // namespace jmespath::optimizer
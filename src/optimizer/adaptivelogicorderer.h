@@ -0,0 +1,206 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef ADAPTIVELOGICORDERER_H
+#define ADAPTIVELOGICORDERER_H
+#include "jmespath/types.h"
+#include "src/optimizer/abstractpass.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/interpreter/logicoperatorprofile.h"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The ProfiledOperator struct describes a logic operator whose
+ * operands are evaluated in the order chosen by its profile.
+ */
+struct ProfiledOperator
+{
+    /**
+     * @brief The text of the operator's expression.
+     */
+    String expression;
+    /**
+     * @brief The profile of the operator, shared with its node.
+     */
+    std::shared_ptr<interpreter::LogicOperatorProfile> profile;
+};
+
+/**
+ * @brief The AdaptiveLogicOrderer class attaches profiles to the `&&` and
+ * `||` operators whose operands can be evaluated in either order, so their
+ * operands get evaluated in the order which is observed to be cheaper.
+ *
+ * Only the operators whose result is tested just for its truthiness are
+ * profiled, like the operators in the conditions of filters and in the
+ * operands of not expressions, since the value of an operator's result
+ * depends on the order of its operands. Reordering can't change the result
+ * of the evaluation either, since the left operand of a profiled operator
+ * can't raise errors, because it doesn't call functions, doesn't contain
+ * slices with zero steps and refers only to variables bound to such
+ * expressions, while its right operand doesn't call custom functions, which
+ * might have side effects.
+ *
+ * The pass is opt-in, the expressions are only profiled if it's enabled.
+ */
+class AdaptiveLogicOrderer : public AbstractPass
+{
+public:
+    /**
+     * @brief Constructs an AdaptiveLogicOrderer object.
+     * @param[in] warmupSamples The number of evaluations sampled by the
+     * profiles before they first decide the order of the operands.
+     * @param[in] sampleInterval After the warm up, every
+     * @a sampleInterval-th evaluation is sampled by the profiles.
+     */
+    explicit AdaptiveLogicOrderer(std::size_t warmupSamples = 32,
+                                  std::size_t sampleInterval = 64);
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Attaches profiles to the logic operators of the given
+     * @a expression whose operands can be evaluated in either order.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+    /**
+     * @brief Returns the operators profiled by the last run of the pass.
+     * @return The profiled operators in the order they were found.
+     */
+    const std::vector<ProfiledOperator>& profiledOperators() const;
+    /**
+     * @brief Enables or disables the profiling of the expressions which
+     * are parsed after the call.
+     * @param[in] enabled If true the expressions are profiled.
+     * @note This function is thread safe.
+     */
+    static void setEnabled(bool enabled);
+    /**
+     * @brief Returns whether the expressions get profiled.
+     * @return Returns true if the profiling is enabled, otherwise false.
+     * @note This function is thread safe.
+     */
+    static bool isEnabled();
+
+private:
+    /**
+     * @brief The VariableInfo struct describes a variable visible at a node.
+     */
+    struct VariableInfo
+    {
+        /**
+         * @brief The name of the variable.
+         */
+        const String* name;
+        /**
+         * @brief Whether references to the variable can't raise errors.
+         */
+        bool infallible;
+        /**
+         * @brief Whether references to the variable don't call custom
+         * functions.
+         */
+        bool pure;
+    };
+    /**
+     * @brief The number of evaluations sampled by the profiles before they
+     * first decide the order of the operands.
+     */
+    std::size_t m_warmupSamples;
+    /**
+     * @brief The interval of the evaluations sampled by the profiles after
+     * the warm up.
+     */
+    std::size_t m_sampleInterval;
+    /**
+     * @brief The operators profiled so far.
+     */
+    std::vector<ProfiledOperator> m_profiledOperators;
+    /**
+     * @brief The variables visible at the currently visited node, from the
+     * outermost to the innermost.
+     */
+    std::vector<VariableInfo> m_variables;
+    /**
+     * @brief Formatter used for describing the profiled operators.
+     */
+    interpreter::ExpressionFormatter m_formatter;
+    /**
+     * @brief Profiles the operators in the AST rooted at the given @a node,
+     * whose result is not only tested for its truthiness.
+     * @param[in,out] node The root of the AST.
+     */
+    void profileExpression(ast::ExpressionNode& node);
+    /**
+     * @brief Profiles the operators of the given @a condition, whose result
+     * is only tested for its truthiness.
+     * @param[in,out] condition The condition.
+     */
+    void profileCondition(ast::ExpressionNode& condition);
+    /**
+     * @brief Profiles the bindings of the given let expression @a node and
+     * calls the @a profileChild function with its child expression, while
+     * its variables are visible.
+     * @param[in,out] node The let expression.
+     * @param[in] profileChild The member function which should profile the
+     * child expression.
+     */
+    void profileLetExpression(
+            ast::LetExpressionNode& node,
+            void (AdaptiveLogicOrderer::*profileChild)(ast::ExpressionNode&));
+    /**
+     * @brief Checks whether the evaluation of the given @a node can't raise
+     * errors.
+     * @param[in] node The node which should be checked.
+     * @return Returns true if the evaluation can't raise errors, otherwise
+     * false.
+     */
+    bool isInfallible(ast::ExpressionNode& node);
+    /**
+     * @brief Checks whether the evaluation of the given @a node doesn't call
+     * custom functions.
+     * @param[in] node The node which should be checked.
+     * @return Returns true if the node doesn't call custom functions,
+     * otherwise false.
+     */
+    bool isPure(ast::ExpressionNode& node);
+    /**
+     * @brief Finds the innermost visible variable with the given @a name.
+     * @param[in] name The name of the variable.
+     * @return Returns a pointer to the variable or nullptr if it's not
+     * visible.
+     */
+    const VariableInfo* findVariable(const String& name) const;
+};
+}} // namespace jmespath::optimizer
+#endif // ADAPTIVELOGICORDERER_H
@@ -0,0 +1,443 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/commonsubexpressioneliminator.h"
+#include "src/interpreter/interpreter.h"
+#include "src/ast/allnodes.h"
+#include <algorithm>
+#include <map>
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Checks whether the @a name of a variable was generated by the
+ * optimizer, which is the case if it starts with a digit.
+ * @param[in] name The name of the variable.
+ * @return Returns true if the variable was generated, otherwise false.
+ */
+bool isGeneratedVariable(const String& name)
+{
+    return !name.empty() && (name.front() >= '0') && (name.front() <= '9');
+}
+
+/**
+ * @brief The ScopeCollector class collects the nodes of a scope which are
+ * evaluated on the same context as the root of the scope, and the roots of
+ * the nested scopes which are evaluated on other contexts.
+ */
+class ScopeCollector : public boost::static_visitor<>
+{
+public:
+    /**
+     * @brief Constructs a ScopeCollector object which stores the nodes in
+     * the given containers.
+     * @param[out] nodes The nodes evaluated on the context of the scope.
+     * @param[out] nestedScopes The roots of the nested scopes.
+     */
+    ScopeCollector(std::vector<ast::ExpressionNode*>& nodes,
+                   std::vector<ast::ExpressionNode*>& nestedScopes)
+        : m_nodes(nodes),
+          m_nestedScopes(nestedScopes)
+    {
+    }
+    /**
+     * @brief Collects the given @a node and its children.
+     * @param[in] node The node which should be collected.
+     * @{
+     */
+    void operator()(ast::ExpressionNode& node) const
+    {
+        if (!node.isNull())
+        {
+            m_nodes.push_back(&node);
+            boost::apply_visitor(*this, node.value);
+        }
+    }
+
+    template <typename T>
+    void operator()(T&) const
+    {
+    }
+
+    void operator()(ast::SubexpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        addNestedScope(node.rightExpression);
+    }
+
+    void operator()(ast::IndexExpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        if (auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                &node.bracketSpecifier.value))
+        {
+            addNestedScope(filterNode->expression);
+        }
+        addNestedScope(node.rightExpression);
+    }
+
+    void operator()(ast::HashWildcardNode& node) const
+    {
+        (*this)(node.leftExpression);
+        addNestedScope(node.rightExpression);
+    }
+
+    void operator()(ast::PipeExpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        addNestedScope(node.rightExpression);
+    }
+
+    void operator()(ast::ComparatorExpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        (*this)(node.rightExpression);
+    }
+
+    void operator()(ast::OrExpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        (*this)(node.rightExpression);
+    }
+
+    void operator()(ast::AndExpressionNode& node) const
+    {
+        (*this)(node.leftExpression);
+        (*this)(node.rightExpression);
+    }
+
+    void operator()(ast::NotExpressionNode& node) const
+    {
+        (*this)(node.expression);
+    }
+
+    void operator()(ast::ParenExpressionNode& node) const
+    {
+        (*this)(node.expression);
+    }
+
+    void operator()(ast::MultiselectListNode& node) const
+    {
+        for (auto& expression: node.expressions)
+        {
+            (*this)(expression);
+        }
+    }
+
+    void operator()(ast::MultiselectHashNode& node) const
+    {
+        for (auto& keyValuePair: node.expressions)
+        {
+            (*this)(keyValuePair.second);
+        }
+    }
+
+    void operator()(ast::FunctionExpressionNode& node) const
+    {
+        // the arguments are evaluated on the context of the function, while
+        // expression arguments are evaluated on other values
+        for (auto& argument: node.arguments)
+        {
+            if (auto* expression = boost::get<ast::ExpressionNode>(
+                    &argument))
+            {
+                (*this)(*expression);
+            }
+            else if (auto* expressionArgument
+                     = boost::get<ast::ExpressionArgumentNode>(&argument))
+            {
+                addNestedScope(expressionArgument->expression);
+            }
+        }
+    }
+
+    void operator()(ast::LetExpressionNode& node) const
+    {
+        for (auto& binding: node.bindings)
+        {
+            (*this)(binding.second);
+        }
+        (*this)(node.expression);
+    }
+    /** @}*/
+
+private:
+    /**
+     * @brief The nodes evaluated on the context of the scope.
+     */
+    std::vector<ast::ExpressionNode*>& m_nodes;
+    /**
+     * @brief The roots of the nested scopes.
+     */
+    std::vector<ast::ExpressionNode*>& m_nestedScopes;
+    /**
+     * @brief Adds the given @a node to the roots of the nested scopes.
+     * @param[in] node The root of a nested scope.
+     */
+    void addNestedScope(ast::ExpressionNode& node) const
+    {
+        if (!node.isNull())
+        {
+            m_nestedScopes.push_back(&node);
+        }
+    }
+};
+
+/**
+ * @brief The ShareabilityChecker class checks whether the result of an
+ * expression depends only on its context, so it can be evaluated in any
+ * scope and its result can be reused.
+ */
+class ShareabilityChecker : public boost::static_visitor<bool>
+{
+public:
+    /**
+     * @brief Checks whether the given @a node and its children can be shared.
+     * @param[in] node The node which should be checked.
+     * @return Returns true if the @a node can be shared, otherwise false.
+     * @{
+     */
+    bool operator()(const ast::ExpressionNode& node) const
+    {
+        return boost::apply_visitor(*this, node.value);
+    }
+
+    template <typename T, typename
+        std::enable_if<
+            !std::is_base_of<ast::BinaryExpressionNode,
+                             T>::value, int>::type = 0>
+    bool operator()(const T&) const
+    {
+        return true;
+    }
+
+    template <typename T, typename
+        std::enable_if<
+            std::is_base_of<ast::BinaryExpressionNode,
+                            T>::value, int>::type = 0>
+    bool operator()(const T& node) const
+    {
+        return (*this)(node.leftExpression)
+                && (*this)(node.rightExpression);
+    }
+
+    bool operator()(const ast::IndexExpressionNode& node) const
+    {
+        const auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                    &node.bracketSpecifier.value);
+        return (*this)(node.leftExpression)
+                && (!filterNode || (*this)(filterNode->expression))
+                && (*this)(node.rightExpression);
+    }
+
+    bool operator()(const ast::NotExpressionNode& node) const
+    {
+        return (*this)(node.expression);
+    }
+
+    bool operator()(const ast::ParenExpressionNode& node) const
+    {
+        return (*this)(node.expression);
+    }
+
+    bool operator()(const ast::MultiselectListNode& node) const
+    {
+        return std::all_of(node.expressions.cbegin(),
+                           node.expressions.cend(),
+                           [this](const ast::ExpressionNode& expression) {
+            return (*this)(expression);
+        });
+    }
+
+    bool operator()(const ast::MultiselectHashNode& node) const
+    {
+        return std::all_of(node.expressions.cbegin(),
+                           node.expressions.cend(),
+                           [this](const auto& keyValuePair) {
+            return (*this)(keyValuePair.second);
+        });
+    }
+
+    bool operator()(const ast::FunctionExpressionNode& node) const
+    {
+        // custom functions might not return the same result for the same
+        // arguments
+        if (!interpreter::Interpreter::isBuiltInFunction(node))
+        {
+            return false;
+        }
+        return std::all_of(node.arguments.cbegin(),
+                           node.arguments.cend(),
+                           [this](const auto& argument) {
+            if (const auto* expression = boost::get<ast::ExpressionNode>(
+                    &argument))
+            {
+                return (*this)(*expression);
+            }
+            if (const auto* expressionArgument
+                    = boost::get<ast::ExpressionArgumentNode>(&argument))
+            {
+                return (*this)(expressionArgument->expression);
+            }
+            return true;
+        });
+    }
+
+    bool operator()(const ast::VariableRefNode& node) const
+    {
+        // the variables of the expression might be shadowed at some of the
+        // occurrences, while the generated variables are unique
+        return isGeneratedVariable(node.name);
+    }
+
+    bool operator()(const ast::LetExpressionNode&) const
+    {
+        return false;
+    }
+    /** @}*/
+};
+
+/**
+ * @brief Checks whether it's worth to share the given @a node, which is the
+ * case if it can be shared and evaluating it involves more than a single
+ * lookup or constant.
+ * @param[in] node The node which should be checked.
+ * @return Returns true if the @a node should be shared, otherwise false.
+ */
+bool isSharingCandidate(const ast::ExpressionNode& node)
+{
+    const auto& value = node.value;
+    if (boost::get<ast::IdentifierNode>(&value)
+        || boost::get<ast::RawStringNode>(&value)
+        || boost::get<ast::LiteralNode>(&value)
+        || boost::get<ast::CurrentNode>(&value)
+        || boost::get<ast::VariableRefNode>(&value))
+    {
+        return false;
+    }
+    return ShareabilityChecker{}(node);
+}
+} // anonymous namespace
+
+const char *CommonSubexpressionEliminator::name() const
+{
+    return "common-subexpression-elimination";
+}
+
+void CommonSubexpressionEliminator::run(ast::ExpressionNode &expression)
+{
+    eliminate(expression);
+}
+
+const std::vector<SharedSubexpression>&
+CommonSubexpressionEliminator::eliminate(ast::ExpressionNode &expression)
+{
+    m_variableCount = 0;
+    m_report.clear();
+    eliminateInScope(expression);
+    return m_report;
+}
+
+const std::vector<SharedSubexpression>&
+CommonSubexpressionEliminator::sharedSubexpressions() const
+{
+    return m_report;
+}
+
+void CommonSubexpressionEliminator::eliminateInScope(ast::ExpressionNode &root)
+{
+    std::vector<ast::ExpressionNode*> nodes;
+    std::vector<ast::ExpressionNode*> nestedScopes;
+    while (true)
+    {
+        nodes.clear();
+        nestedScopes.clear();
+        ScopeCollector{nodes, nestedScopes}(root);
+        // group the candidates of the scope by their text, since equal
+        // texts describe equal ASTs
+        std::map<String, std::vector<ast::ExpressionNode*>> occurrences;
+        for (auto* node: nodes)
+        {
+            if (isSharingCandidate(*node))
+            {
+                occurrences[m_formatter.format(*node)].push_back(node);
+            }
+        }
+        // find the longest repeated subexpression, since sharing it also
+        // removes the repetitions of its subexpressions
+        auto sharedIt = occurrences.end();
+        for (auto it = occurrences.begin(); it != occurrences.end(); ++it)
+        {
+            if ((it->second.size() > 1)
+                && ((sharedIt == occurrences.end())
+                    || (it->first.size() > sharedIt->first.size())))
+            {
+                sharedIt = it;
+            }
+        }
+        if (sharedIt == occurrences.end())
+        {
+            break;
+        }
+        m_report.push_back({sharedIt->first, sharedIt->second.size()});
+        share(root, sharedIt->second);
+    }
+    // continue with the nested scopes, including the ones in the bound
+    // expressions
+    for (auto* nestedScope: nestedScopes)
+    {
+        eliminateInScope(*nestedScope);
+    }
+}
+
+void CommonSubexpressionEliminator::share(
+        ast::ExpressionNode &root,
+        const std::vector<ast::ExpressionNode*> &occurrences)
+{
+    ast::VariableRefNode variable{std::to_string(m_variableCount++)};
+    ast::ExpressionNode expression = *occurrences.front();
+    for (auto* node: occurrences)
+    {
+        *node = variable;
+    }
+    // add the variable to the deferred let expression of the scope if it
+    // already has one, otherwise wrap the root into a new one
+    auto* letNode = boost::get<ast::LetExpressionNode>(&root.value);
+    if (letNode && letNode->deferred)
+    {
+        letNode->bindings.emplace_back(variable, expression);
+    }
+    else
+    {
+        ast::LetExpressionNode newLetNode{{{variable, expression}}, root};
+        newLetNode.deferred = true;
+        root = newLetNode;
+    }
+}
+}} // namespace jmespath::optimizer
@@ -0,0 +1,124 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef COMMONSUBEXPRESSIONELIMINATOR_H
+#define COMMONSUBEXPRESSIONELIMINATOR_H
+#include "jmespath/expression.h"
+#include "src/optimizer/abstractpass.h"
+#include "src/interpreter/expressionformatter.h"
+#include <vector>
+
+/**
+ * @namespace jmespath::optimizer
+ * @brief Classes for transforming the AST of the JMESPath expression into an
+ * equivalent one which can be evaluated faster.
+ */
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The CommonSubexpressionEliminator class rewrites an AST so that
+ * structurally equal subexpressions which are evaluated on the same context
+ * are evaluated only once.
+ *
+ * The nodes of an AST are partitioned into scopes. The nodes of a scope are
+ * evaluated on the same context as its root, like the items of a multiselect
+ * expression or the left side of a subexpression, while the right side of
+ * a subexpression, the projected expressions, filter conditions and
+ * expression arguments are the roots of nested scopes.
+ *
+ * Repeated subexpressions of a scope get bound to variables of a deferred
+ * @ref ast::LetExpressionNode which wraps the root of the scope, and their
+ * occurrences are replaced with references to the variables. The bound
+ * expressions are evaluated on the first reference, so expressions which
+ * wouldn't be evaluated at all, because of short circuiting operators for
+ * example, are not evaluated either after the rewrite. The names of the
+ * variables start with a digit, so they can't collide with the variables of
+ * the expression.
+ *
+ * Only subexpressions which don't refer to the variables of the expression
+ * and don't call custom functions are shared, and the largest repeated
+ * subexpressions are shared first.
+ */
+class CommonSubexpressionEliminator : public AbstractPass
+{
+public:
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Shares the repeated subexpressions of the given @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+    /**
+     * @brief Shares the repeated subexpressions of the given @a expression.
+     * @param[in,out] expression The root of the AST.
+     * @return The report of the shared subexpressions.
+     */
+    const std::vector<SharedSubexpression>& eliminate(
+            ast::ExpressionNode& expression);
+    /**
+     * @brief Returns the report of the subexpressions shared by the last
+     * run of the pass.
+     * @return The shared subexpressions and their number of occurrences.
+     */
+    const std::vector<SharedSubexpression>& sharedSubexpressions() const;
+
+private:
+    /**
+     * @brief The number of variables bound so far, which is used for
+     * generating unique variable names.
+     */
+    std::size_t m_variableCount = 0;
+    /**
+     * @brief The subexpressions shared so far.
+     */
+    std::vector<SharedSubexpression> m_report;
+    /**
+     * @brief Formatter used for finding equal subexpressions by their text.
+     */
+    interpreter::ExpressionFormatter m_formatter;
+    /**
+     * @brief Shares the repeated subexpressions of the scope with the given
+     * @a root and of its nested scopes.
+     * @param[in,out] root The root of the scope.
+     */
+    void eliminateInScope(ast::ExpressionNode& root);
+    /**
+     * @brief Binds the first of the @a occurrences to a new deferred
+     * variable in the scope with the given @a root, and replaces all of
+     * them with references to the variable.
+     * @param[in,out] root The root of the scope.
+     * @param[in] occurrences The equal subexpressions of the scope.
+     */
+    void share(ast::ExpressionNode& root,
+               const std::vector<ast::ExpressionNode*>& occurrences);
+};
+}} // namespace jmespath::optimizer
+#endif // COMMONSUBEXPRESSIONELIMINATOR_H
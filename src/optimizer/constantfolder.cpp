@@ -0,0 +1,110 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/constantfolder.h"
+#include "src/optimizer/nodepatterns.h"
+#include "jmespath/exceptions.h"
+#include "src/interpreter/interpreter.h"
+#include "src/interpreter/jsonserializer.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Checks whether the given @a node can be replaced with its result,
+ * which is the case if the result doesn't depend on the context and the
+ * operands of the node are all constants.
+ * @param[in] node The node which should be checked.
+ * @return Returns true if the @a node can be folded, otherwise false.
+ */
+bool isFoldable(ast::ExpressionNode& node)
+{
+    if (const auto* functionNode = match<ast::FunctionExpressionNode>(node))
+    {
+        // custom functions might not return the same result for the same
+        // arguments
+        if (!interpreter::Interpreter::isBuiltInFunction(*functionNode))
+        {
+            return false;
+        }
+    }
+    else if (!matchesAny<ast::NotExpressionNode,
+                         ast::ComparatorExpressionNode,
+                         ast::OrExpressionNode,
+                         ast::AndExpressionNode,
+                         ast::ParenExpressionNode>(node))
+    {
+        return false;
+    }
+    bool constantOperands = true;
+    forEachChild(node, [&constantOperands](ast::ExpressionNode& child) {
+        constantOperands = constantOperands
+                && matchesAny<ast::LiteralNode, ast::RawStringNode>(child);
+    });
+    return constantOperands;
+}
+} // anonymous namespace
+
+const char *ConstantFolder::name() const
+{
+    return "constant-folding";
+}
+
+void ConstantFolder::run(ast::ExpressionNode &expression)
+{
+    transformBottomUp(expression, [](ast::ExpressionNode& node) {
+        if (!isFoldable(node))
+        {
+            return;
+        }
+        // evaluate the node on a null context, and leave it unchanged if its
+        // evaluation fails
+        interpreter::Interpreter interpreter;
+        try
+        {
+            interpreter.visit(&node);
+        }
+        catch (const Exception&)
+        {
+            return;
+        }
+        const Json& result = interpreter.currentContext();
+        if (result.is_string())
+        {
+            node = ast::RawStringNode{result.get<String>()};
+        }
+        else
+        {
+            String literal;
+            interpreter::appendJson(literal, result);
+            node = ast::LiteralNode{literal};
+        }
+    });
+}
+}} // namespace jmespath::optimizer
@@ -0,0 +1,127 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/doublenegationeliminator.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Returns the negated operand of the given @a node if it's a not
+ * expression, looking through the parentheses around the operand.
+ * @param[in] node The node which should be checked.
+ * @return Returns the operand of the not expression or nullptr.
+ */
+const ast::ExpressionNode* negatedOperand(const ast::ExpressionNode& node)
+{
+    const auto* notNode = match<ast::NotExpressionNode>(node);
+    if (!notNode)
+    {
+        return nullptr;
+    }
+    const ast::ExpressionNode* operand = &notNode->expression;
+    while (const auto* parenNode = match<ast::ParenExpressionNode>(*operand))
+    {
+        operand = &parenNode->expression;
+    }
+    return operand;
+}
+
+/**
+ * @brief Removes the double negations from the given @a condition, whose
+ * result is only tested for its truthiness.
+ * @param[in,out] condition The condition.
+ */
+void simplifyCondition(ast::ExpressionNode& condition)
+{
+    // replace the double negations with their operands
+    const ast::ExpressionNode* operand = negatedOperand(condition);
+    while (operand)
+    {
+        const ast::ExpressionNode* innerOperand = negatedOperand(*operand);
+        if (!innerOperand)
+        {
+            break;
+        }
+        // copy the operand before replacing the node which owns it
+        ast::ExpressionNode simplified = *innerOperand;
+        condition = simplified;
+        operand = negatedOperand(condition);
+    }
+    // the operands of logical operators are tested for their truthiness
+    // when the result of the operator is
+    if (auto* andNode = match<ast::AndExpressionNode>(condition))
+    {
+        simplifyCondition(andNode->leftExpression);
+        simplifyCondition(andNode->rightExpression);
+    }
+    else if (auto* orNode = match<ast::OrExpressionNode>(condition))
+    {
+        simplifyCondition(orNode->leftExpression);
+        simplifyCondition(orNode->rightExpression);
+    }
+    else if (auto* parenNode = match<ast::ParenExpressionNode>(condition))
+    {
+        simplifyCondition(parenNode->expression);
+    }
+}
+
+/**
+ * @brief Simplifies the conditions in the AST rooted at the given @a node.
+ * @param[in,out] node The root of the AST.
+ */
+void eliminateDoubleNegations(ast::ExpressionNode& node)
+{
+    if (auto* notNode = match<ast::NotExpressionNode>(node))
+    {
+        simplifyCondition(notNode->expression);
+    }
+    else if (auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        if (auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                &indexNode->bracketSpecifier.value))
+        {
+            simplifyCondition(filterNode->expression);
+        }
+    }
+    forEachChild(node, eliminateDoubleNegations);
+}
+} // anonymous namespace
+
+const char *DoubleNegationEliminator::name() const
+{
+    return "double-negation-elimination";
+}
+
+void DoubleNegationEliminator::run(ast::ExpressionNode &expression)
+{
+    eliminateDoubleNegations(expression);
+}
+}} // namespace jmespath::optimizer
@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef DOUBLENEGATIONELIMINATOR_H
+#define DOUBLENEGATIONELIMINATOR_H
+#include "src/optimizer/abstractpass.h"
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The DoubleNegationEliminator class removes the double negations from
+ * the expressions whose result is only tested for its truthiness.
+ *
+ * A double negation like `!!a` converts its operand to a boolean, so it can't
+ * be removed in general, but the conditions of filters and the operands of
+ * not expressions are only tested for their truthiness, which is the same with
+ * or without the double negation. The operands of `&&` and `||` operators in
+ * such a condition are only tested for their truthiness too.
+ */
+class DoubleNegationEliminator : public AbstractPass
+{
+public:
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Removes the redundant double negations of the given
+     * @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+};
+}} // namespace jmespath::optimizer
+#endif // DOUBLENEGATIONELIMINATOR_H
@@ -0,0 +1,235 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/filterkernelcompiler.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/interpreter/filterkernel.h"
+#include "src/ast/allnodes.h"
+#include <cstdint>
+#include <limits>
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+using Comparator = interpreter::FilterKernel::Comparator;
+
+/**
+ * @brief Collects the keys and indices of the field of the items selected
+ * by the given @a node.
+ * @param[in] node The node which should be checked.
+ * @param[out] path The keys and indices in the order of their evaluation.
+ * @return Returns true if the @a node selects a field of the items,
+ * otherwise false.
+ */
+bool collectPath(const ast::ExpressionNode& node,
+                 interpreter::FilterKernel::PathType& path)
+{
+    // empty and current nodes refer to the item itself
+    if (node.isNull() || match<ast::CurrentNode>(node))
+    {
+        return true;
+    }
+    if (const auto* identifierNode = match<ast::IdentifierNode>(node))
+    {
+        path.push_back(identifierNode->identifier);
+        return true;
+    }
+    if (const auto* pathNode = match<ast::PathNode>(node))
+    {
+        path.insert(path.end(),
+                    pathNode->segments.begin(),
+                    pathNode->segments.end());
+        return true;
+    }
+    if (const auto* subexpressionNode = match<ast::SubexpressionNode>(node))
+    {
+        return collectPath(subexpressionNode->leftExpression, path)
+                && collectPath(subexpressionNode->rightExpression, path);
+    }
+    if (const auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        const auto* arrayItemNode = boost::get<ast::ArrayItemNode>(
+                    &indexNode->bracketSpecifier.value);
+        if (!arrayItemNode || !indexNode->rightExpression.isNull()
+            || !collectPath(indexNode->leftExpression, path))
+        {
+            return false;
+        }
+        // an array can't have more items than this limit, so clamping the
+        // index into this range doesn't change which item it selects
+        constexpr std::int64_t limit
+                = std::numeric_limits<std::int64_t>::max() / 4;
+        std::int64_t index = limit;
+        if (arrayItemNode->index < -limit)
+        {
+            index = -limit;
+        }
+        else if (arrayItemNode->index < limit)
+        {
+            index = arrayItemNode->index.convert_to<std::int64_t>();
+        }
+        path.push_back(index);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Converts the given @a node into a constant if it's a literal or a
+ * raw string.
+ * @param[in] node The node which should be converted.
+ * @param[out] constant The value of the node.
+ * @return Returns true if the @a node is a constant, otherwise false.
+ */
+bool convertConstant(const ast::ExpressionNode& node, Json& constant)
+{
+    if (const auto* literalNode = match<ast::LiteralNode>(node))
+    {
+        constant = Json::parse(literalNode->literal);
+        return true;
+    }
+    if (const auto* rawStringNode = match<ast::RawStringNode>(node))
+    {
+        constant = rawStringNode->rawString;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Returns the comparator which gives the same result as the given
+ * @a comparator when its operands are swapped.
+ * @param[in] comparator A comparison operator.
+ * @return The mirrored comparison operator.
+ */
+Comparator mirror(Comparator comparator)
+{
+    switch (comparator)
+    {
+    case Comparator::Less:
+        return Comparator::Greater;
+    case Comparator::LessOrEqual:
+        return Comparator::GreaterOrEqual;
+    case Comparator::GreaterOrEqual:
+        return Comparator::LessOrEqual;
+    case Comparator::Greater:
+        return Comparator::Less;
+    default:
+        return comparator;
+    }
+}
+
+/**
+ * @brief Collects the predicates of the given filter @a condition.
+ * @param[in] condition The condition of a filter expression.
+ * @param[out] predicates The comparisons whose conjunction is equivalent to
+ * the @a condition.
+ * @return Returns true if the @a condition can be evaluated by a kernel,
+ * otherwise false.
+ */
+bool collectPredicates(
+        const ast::ExpressionNode& condition,
+        std::vector<interpreter::FilterKernel::Predicate>& predicates)
+{
+    if (const auto* andNode = match<ast::AndExpressionNode>(condition))
+    {
+        return collectPredicates(andNode->leftExpression, predicates)
+                && collectPredicates(andNode->rightExpression, predicates);
+    }
+    if (const auto* parenNode = match<ast::ParenExpressionNode>(condition))
+    {
+        return collectPredicates(parenNode->expression, predicates);
+    }
+    const auto* comparatorNode = match<ast::ComparatorExpressionNode>(
+                condition);
+    if (!comparatorNode)
+    {
+        return false;
+    }
+    // the field can be on either side of the comparison
+    interpreter::FilterKernel::Predicate predicate;
+    predicate.comparator = comparatorNode->comparator;
+    if (!convertConstant(comparatorNode->rightExpression, predicate.constant)
+        || !collectPath(comparatorNode->leftExpression, predicate.path))
+    {
+        predicate.path.clear();
+        predicate.comparator = mirror(comparatorNode->comparator);
+        if (!convertConstant(comparatorNode->leftExpression,
+                             predicate.constant)
+            || !collectPath(comparatorNode->rightExpression, predicate.path))
+        {
+            return false;
+        }
+    }
+    if (!interpreter::FilterKernel::isSupported(predicate))
+    {
+        return false;
+    }
+    predicates.push_back(std::move(predicate));
+    return true;
+}
+} // anonymous namespace
+
+const char *FilterKernelCompiler::name() const
+{
+    return "filter-kernel-compilation";
+}
+
+void FilterKernelCompiler::run(ast::ExpressionNode &expression)
+{
+    compile(expression);
+}
+
+std::size_t FilterKernelCompiler::compile(ast::ExpressionNode &expression)
+{
+    std::size_t count = 0;
+    transformBottomUp(expression, [&count](ast::ExpressionNode& node) {
+        auto* indexNode = match<ast::IndexExpressionNode>(node);
+        if (!indexNode)
+        {
+            return;
+        }
+        auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                    &indexNode->bracketSpecifier.value);
+        if (!filterNode)
+        {
+            return;
+        }
+        filterNode->kernel.reset();
+        std::vector<interpreter::FilterKernel::Predicate> predicates;
+        if (collectPredicates(filterNode->expression, predicates))
+        {
+            filterNode->kernel
+                    = std::make_shared<const interpreter::FilterKernel>(
+                        std::move(predicates));
+            ++count;
+        }
+    });
+    return count;
+}
+}} // namespace jmespath::optimizer
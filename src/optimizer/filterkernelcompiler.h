@@ -0,0 +1,70 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef FILTERKERNELCOMPILER_H
+#define FILTERKERNELCOMPILER_H
+#include "src/optimizer/abstractpass.h"
+#include <cstddef>
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The FilterKernelCompiler class attaches an
+ * @ref interpreter::FilterKernel to the filter expressions whose condition
+ * is a conjunction of comparisons between a field of the items and a
+ * constant, like `[?price > \`10\` && category == 'books']`.
+ *
+ * The kernel evaluates such conditions on whole arrays column by column,
+ * instead of evaluating the condition's AST separately on every item. The
+ * fields can be identifiers, chains of identifiers and array items or the
+ * current node, and the constants can be literals or raw strings. The
+ * conditions of the other filters are evaluated as before.
+ */
+class FilterKernelCompiler : public AbstractPass
+{
+public:
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Attaches kernels to the supported filter expressions in the
+     * given @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+    /**
+     * @brief Attaches kernels to the supported filter expressions in the
+     * given @a expression.
+     * @param[in,out] expression The root of the AST.
+     * @return The number of kernels attached.
+     */
+    std::size_t compile(ast::ExpressionNode& expression);
+};
+}} // namespace jmespath::optimizer
+#endif // FILTERKERNELCOMPILER_H
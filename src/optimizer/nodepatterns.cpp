@@ -0,0 +1,174 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief The ChildVisitor class calls a function with the child expressions
+ * of the visited node.
+ */
+class ChildVisitor : public boost::static_visitor<>
+{
+public:
+    /**
+     * @brief Constructs a ChildVisitor object which calls the given
+     * @a function with the children.
+     * @param[in] function The function called with every non empty child.
+     */
+    ChildVisitor(const NodeFunction& function)
+        : m_function(function)
+    {
+    }
+    /**
+     * @brief Calls the function with the children of the given @a node.
+     * @param[in] node The node whose children should be visited.
+     * @{
+     */
+    template <typename T, typename
+        std::enable_if<
+            !std::is_base_of<ast::BinaryExpressionNode,
+                             T>::value, int>::type = 0>
+    void operator()(T&) const
+    {
+    }
+
+    template <typename T, typename
+        std::enable_if<
+            std::is_base_of<ast::BinaryExpressionNode,
+                            T>::value, int>::type = 0>
+    void operator()(T& node) const
+    {
+        call(node.leftExpression);
+        call(node.rightExpression);
+    }
+
+    void operator()(ast::IndexExpressionNode& node) const
+    {
+        call(node.leftExpression);
+        if (auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                &node.bracketSpecifier.value))
+        {
+            call(filterNode->expression);
+        }
+        call(node.rightExpression);
+    }
+
+    void operator()(ast::NotExpressionNode& node) const
+    {
+        call(node.expression);
+    }
+
+    void operator()(ast::ParenExpressionNode& node) const
+    {
+        call(node.expression);
+    }
+
+    void operator()(ast::MultiselectListNode& node) const
+    {
+        for (auto& expression: node.expressions)
+        {
+            call(expression);
+        }
+    }
+
+    void operator()(ast::MultiselectHashNode& node) const
+    {
+        for (auto& keyValuePair: node.expressions)
+        {
+            call(keyValuePair.second);
+        }
+    }
+
+    void operator()(ast::FunctionExpressionNode& node) const
+    {
+        for (auto& argument: node.arguments)
+        {
+            if (auto* expression = boost::get<ast::ExpressionNode>(
+                    &argument))
+            {
+                call(*expression);
+            }
+            else if (auto* expressionArgument
+                     = boost::get<ast::ExpressionArgumentNode>(&argument))
+            {
+                call(expressionArgument->expression);
+            }
+        }
+    }
+
+    void operator()(ast::LetExpressionNode& node) const
+    {
+        for (auto& binding: node.bindings)
+        {
+            call(binding.second);
+        }
+        call(node.expression);
+    }
+    /** @}*/
+
+private:
+    /**
+     * @brief The function called with every non empty child.
+     */
+    const NodeFunction& m_function;
+    /**
+     * @brief Calls the function with the given @a child if it's not empty.
+     * @param[in] child The child expression.
+     */
+    void call(ast::ExpressionNode& child) const
+    {
+        if (!child.isNull())
+        {
+            m_function(child);
+        }
+    }
+};
+} // anonymous namespace
+
+void forEachChild(ast::ExpressionNode &node, const NodeFunction &function)
+{
+    boost::apply_visitor(ChildVisitor{function}, node.value);
+}
+
+void transformBottomUp(ast::ExpressionNode &node,
+                       const NodeFunction &transform)
+{
+    if (node.isNull())
+    {
+        return;
+    }
+    forEachChild(node, [&transform](ast::ExpressionNode& child) {
+        transformBottomUp(child, transform);
+    });
+    transform(node);
+}
+}} // namespace jmespath::optimizer
@@ -0,0 +1,103 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef NODEPATTERNS_H
+#define NODEPATTERNS_H
+#include "src/ast/expressionnode.h"
+#include <functional>
+#include <initializer_list>
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The type of the functions which are called with the nodes of an
+ * AST.
+ */
+using NodeFunction = std::function<void(ast::ExpressionNode&)>;
+
+/**
+ * @brief Returns the node of type @a NodeT stored in the given @a node.
+ * @tparam NodeT The type of the node which should be matched.
+ * @param[in] node The node which should be checked.
+ * @return Returns a pointer to the stored node if it's of type @a NodeT,
+ * otherwise nullptr.
+ * @{
+ */
+template <typename NodeT>
+NodeT* match(ast::ExpressionNode& node)
+{
+    return boost::get<NodeT>(&node.value);
+}
+
+template <typename NodeT>
+const NodeT* match(const ast::ExpressionNode& node)
+{
+    return boost::get<NodeT>(&node.value);
+}
+/** @}*/
+
+/**
+ * @brief Checks whether the given @a node stores a node of any of the given
+ * types.
+ * @tparam NodeTs The types of the nodes which should be matched.
+ * @param[in] node The node which should be checked.
+ * @return Returns true if the @a node stores any of the @a NodeTs, otherwise
+ * false.
+ */
+template <typename... NodeTs>
+bool matchesAny(const ast::ExpressionNode& node)
+{
+    bool result = false;
+    static_cast<void>(std::initializer_list<int>{
+        (result = result || match<NodeTs>(node), 0)...});
+    return result;
+}
+
+/**
+ * @brief Calls the given @a function with the child expressions of the
+ * @a node, in the order of their evaluation.
+ *
+ * The children include the conditions of filters, the arguments of
+ * functions, the referred expressions of expression arguments and the bound
+ * expressions of let expressions.
+ * @param[in] node The node whose children should be visited.
+ * @param[in] function The function called with every non empty child.
+ */
+void forEachChild(ast::ExpressionNode& node, const NodeFunction& function);
+
+/**
+ * @brief Calls the given @a transform with every node of the AST rooted at
+ * @a node, visiting the children of the nodes before the nodes themselves.
+ *
+ * The @a transform can replace the node it's called with, since the children
+ * of the node are already transformed at that point.
+ * @param[in,out] node The root of the AST.
+ * @param[in] transform The function called with every non empty node.
+ */
+void transformBottomUp(ast::ExpressionNode& node, const NodeFunction& transform);
+}} // namespace jmespath::optimizer
+#endif // NODEPATTERNS_H
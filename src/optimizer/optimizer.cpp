@@ -0,0 +1,99 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/optimizer.h"
+#include "src/optimizer/pipesimplifier.h"
+#include "src/optimizer/parenthesiseliminator.h"
+#include "src/optimizer/doublenegationeliminator.h"
+#include "src/optimizer/constantfolder.h"
+#include "src/optimizer/filterkernelcompiler.h"
+#include "src/optimizer/commonsubexpressioneliminator.h"
+#include "src/optimizer/pathfuser.h"
+#include "src/ast/expressionnode.h"
+#include <atomic>
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Whether the expressions get optimized.
+ */
+std::atomic<bool> s_enabled{true};
+} // anonymous namespace
+
+Optimizer::Optimizer()
+    : m_passes(defaultPasses())
+{
+}
+
+Optimizer::Optimizer(std::vector<PassPtr> passes)
+    : m_passes(std::move(passes))
+{
+}
+
+std::vector<Optimizer::PassPtr> Optimizer::defaultPasses()
+{
+    // the simplifying passes run first, so the later passes can find more
+    // equal subexpressions and longer paths
+    std::vector<PassPtr> passes;
+    passes.push_back(std::make_unique<PipeSimplifier>());
+    passes.push_back(std::make_unique<ParenthesisEliminator>());
+    passes.push_back(std::make_unique<DoubleNegationEliminator>());
+    passes.push_back(std::make_unique<ConstantFolder>());
+    // the kernels are compiled before the conditions of the filters might
+    // get wrapped into let expressions by the elimination of common
+    // subexpressions
+    passes.push_back(std::make_unique<FilterKernelCompiler>());
+    passes.push_back(std::make_unique<CommonSubexpressionEliminator>());
+    passes.push_back(std::make_unique<PathFuser>());
+    return passes;
+}
+
+void Optimizer::optimize(ast::ExpressionNode &expression)
+{
+    for (auto& pass: m_passes)
+    {
+        pass->run(expression);
+    }
+}
+
+const std::vector<Optimizer::PassPtr> &Optimizer::passes() const
+{
+    return m_passes;
+}
+
+void Optimizer::setEnabled(bool enabled)
+{
+    s_enabled = enabled;
+}
+
+bool Optimizer::isEnabled()
+{
+    return s_enabled;
+}
+}} // namespace jmespath::optimizer
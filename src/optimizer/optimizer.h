@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef OPTIMIZER_H
+#define OPTIMIZER_H
+#include "src/optimizer/abstractpass.h"
+#include <memory>
+#include <vector>
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The Optimizer class rewrites the AST of a parsed expression with a
+ * sequence of optimization passes, before the expression gets evaluated.
+ *
+ * The default passes simplify the expression first, then compile the
+ * kernels of the filters, share the repeated subexpressions and finally
+ * fuse the paths of the simplified expression.
+ * The optimizer can be disabled for debugging, in which case the expressions
+ * are evaluated as they were parsed.
+ */
+class Optimizer
+{
+public:
+    /**
+     * @brief The type of the pointers which own the passes.
+     */
+    using PassPtr = std::unique_ptr<AbstractPass>;
+    /**
+     * @brief Constructs an Optimizer object with the default passes.
+     */
+    Optimizer();
+    /**
+     * @brief Constructs an Optimizer object with the given @a passes.
+     * @param[in] passes The passes in the order they should be run.
+     */
+    Optimizer(std::vector<PassPtr> passes);
+    /**
+     * @brief Creates the default passes in the order they should be run.
+     * @return The default passes.
+     */
+    static std::vector<PassPtr> defaultPasses();
+    /**
+     * @brief Runs the passes of the optimizer on the given @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    void optimize(ast::ExpressionNode& expression);
+    /**
+     * @brief Returns the passes of the optimizer.
+     * @return The passes in the order they're run.
+     */
+    const std::vector<PassPtr>& passes() const;
+    /**
+     * @brief Returns the first pass of the optimizer with the type
+     * @a PassT.
+     * @tparam PassT The type of the pass.
+     * @return Returns a pointer to the pass or nullptr if the optimizer
+     * doesn't have such a pass.
+     */
+    template <typename PassT>
+    const PassT* findPass() const
+    {
+        for (const auto& pass: m_passes)
+        {
+            if (const auto* result = dynamic_cast<const PassT*>(pass.get()))
+            {
+                return result;
+            }
+        }
+        return nullptr;
+    }
+    /**
+     * @brief Enables or disables the optimization of the expressions which
+     * are parsed after the call.
+     * @param[in] enabled If false the expressions are not optimized.
+     * @note This function is thread safe.
+     */
+    static void setEnabled(bool enabled);
+    /**
+     * @brief Returns whether the expressions get optimized.
+     * @return Returns true if the optimizer is enabled, otherwise false.
+     * @note This function is thread safe.
+     */
+    static bool isEnabled();
+
+private:
+    /**
+     * @brief The passes in the order they're run.
+     */
+    std::vector<PassPtr> m_passes;
+};
+}} // namespace jmespath::optimizer
+#endif // OPTIMIZER_H
@@ -0,0 +1,91 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/parenthesiseliminator.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Checks whether the given @a node is a chain of identifiers and array
+ * items like `a.b[0].c`, which is not a projection.
+ * @param[in] node The node which should be checked.
+ * @return Returns true if the @a node is such a chain, otherwise false.
+ */
+bool isChain(const ast::ExpressionNode& node)
+{
+    if (match<ast::IdentifierNode>(node))
+    {
+        return true;
+    }
+    if (const auto* subexpressionNode = match<ast::SubexpressionNode>(node))
+    {
+        return match<ast::IdentifierNode>(subexpressionNode->rightExpression)
+                && isChain(subexpressionNode->leftExpression);
+    }
+    if (const auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        return boost::get<ast::ArrayItemNode>(
+                    &indexNode->bracketSpecifier.value)
+                && indexNode->rightExpression.isNull()
+                && isChain(indexNode->leftExpression);
+    }
+    return false;
+}
+} // anonymous namespace
+
+const char *ParenthesisEliminator::name() const
+{
+    return "parenthesis-elimination";
+}
+
+void ParenthesisEliminator::run(ast::ExpressionNode &expression)
+{
+    transformBottomUp(expression, [](ast::ExpressionNode& node) {
+        const auto* parenNode = match<ast::ParenExpressionNode>(node);
+        if (parenNode
+            && (isChain(parenNode->expression)
+                || matchesAny<ast::RawStringNode,
+                              ast::LiteralNode,
+                              ast::CurrentNode,
+                              ast::VariableRefNode,
+                              ast::FunctionExpressionNode,
+                              ast::MultiselectListNode,
+                              ast::MultiselectHashNode,
+                              ast::ParenExpressionNode,
+                              ast::PathNode>(parenNode->expression)))
+        {
+            // copy the child before replacing the node which owns it
+            ast::ExpressionNode child = parenNode->expression;
+            node = child;
+        }
+    });
+}
+}} // namespace jmespath::optimizer
@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef PARENTHESISELIMINATOR_H
+#define PARENTHESISELIMINATOR_H
+#include "src/optimizer/abstractpass.h"
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The ParenthesisEliminator class removes the parentheses around the
+ * expressions which are evaluated the same way without them.
+ *
+ * Parentheses around projections are kept, since they stop the projection,
+ * and so are the parentheses around operators, which would bind differently
+ * when the expression is formatted without them. Only the parentheses around
+ * chains of identifiers and array items like `a.b[0]`, literals, raw
+ * strings, the current node, variables, function calls, multiselect
+ * expressions, paths and other parenthesized expressions are removed.
+ */
+class ParenthesisEliminator : public AbstractPass
+{
+public:
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Removes the redundant parentheses of the given @a expression.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+};
+}} // namespace jmespath::optimizer
+#endif // PARENTHESISELIMINATOR_H
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/pathfuser.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+#include <cstdint>
+#include <limits>
+
+namespace jmespath { namespace optimizer {
+
+namespace {
+
+/**
+ * @brief Collects the steps of the chain of identifiers and array items
+ * represented by the given @a node.
+ * @param[in] node The node which should be checked.
+ * @param[out] segments The steps of the chain in the order of their
+ * evaluation.
+ * @return Returns true if the @a node represents such a chain, otherwise
+ * false.
+ */
+bool collectSegments(const ast::ExpressionNode& node,
+                     std::vector<ast::PathNode::SegmentType>& segments)
+{
+    // an empty node refers to the context on which the chain is evaluated
+    if (node.isNull())
+    {
+        return true;
+    }
+    if (const auto* identifierNode = match<ast::IdentifierNode>(node))
+    {
+        segments.push_back(identifierNode->identifier);
+        return true;
+    }
+    if (const auto* subexpressionNode = match<ast::SubexpressionNode>(node))
+    {
+        const auto* identifierNode = match<ast::IdentifierNode>(
+                    subexpressionNode->rightExpression);
+        if (!identifierNode
+            || !collectSegments(subexpressionNode->leftExpression, segments))
+        {
+            return false;
+        }
+        segments.push_back(identifierNode->identifier);
+        return true;
+    }
+    if (const auto* indexNode = match<ast::IndexExpressionNode>(node))
+    {
+        const auto* arrayItemNode = boost::get<ast::ArrayItemNode>(
+                    &indexNode->bracketSpecifier.value);
+        if (!arrayItemNode || !indexNode->rightExpression.isNull()
+            || !collectSegments(indexNode->leftExpression, segments))
+        {
+            return false;
+        }
+        // an array can't have more items than this limit, so clamping the
+        // index into this range doesn't change which item it selects
+        constexpr std::int64_t limit
+                = std::numeric_limits<std::int64_t>::max() / 4;
+        std::int64_t index = limit;
+        if (arrayItemNode->index < -limit)
+        {
+            index = -limit;
+        }
+        else if (arrayItemNode->index < limit)
+        {
+            index = arrayItemNode->index.convert_to<std::int64_t>();
+        }
+        segments.push_back(index);
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Replaces the chains of identifiers and array items in the AST
+ * rooted at the given @a node with path nodes.
+ * @param[in,out] node The root of the AST.
+ * @param[in,out] count The number of path nodes created.
+ */
+void fusePaths(ast::ExpressionNode& node, std::size_t& count)
+{
+    // replace the node if it's a chain of more than one step, otherwise
+    // look for chains in its children
+    std::vector<ast::PathNode::SegmentType> segments;
+    if (collectSegments(node, segments) && (segments.size() > 1))
+    {
+        node = ast::PathNode{segments};
+        ++count;
+        return;
+    }
+    forEachChild(node, [&count](ast::ExpressionNode& child) {
+        fusePaths(child, count);
+    });
+}
+} // anonymous namespace
+
+const char *PathFuser::name() const
+{
+    return "path-fusion";
+}
+
+void PathFuser::run(ast::ExpressionNode &expression)
+{
+    fuse(expression);
+}
+
+std::size_t PathFuser::fuse(ast::ExpressionNode &expression)
+{
+    std::size_t count = 0;
+    fusePaths(expression, count);
+    return count;
+}
+}} // namespace jmespath::optimizer
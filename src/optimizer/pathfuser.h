@@ -0,0 +1,72 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#ifndef PATHFUSER_H
+#define PATHFUSER_H
+#include "src/optimizer/abstractpass.h"
+#include <cstddef>
+
+namespace jmespath { namespace optimizer {
+
+/**
+ * @brief The PathFuser class rewrites an AST so that chains of identifiers
+ * and array items, like `spec.containers[0].image`, are represented by a
+ * single @ref ast::PathNode.
+ *
+ * The parser represents such a chain as nested subexpressions and index
+ * expressions, whose evaluation stores every intermediate value in the
+ * context of the interpreter. The steps of a path node are evaluated as a
+ * sequence of lookups on the context, and only the final value gets stored.
+ *
+ * Only the chains with at least two steps are fused, and the chains are
+ * fused everywhere in the AST, including projected expressions, filter
+ * conditions and the arguments of functions.
+ */
+class PathFuser : public AbstractPass
+{
+public:
+    /**
+     * @brief Returns the name of the pass.
+     * @return The name of the pass.
+     */
+    const char* name() const override;
+    /**
+     * @brief Fuses the chains of identifiers and array items in the given
+     * @a expression into path nodes.
+     * @param[in,out] expression The root of the AST.
+     */
+    void run(ast::ExpressionNode& expression) override;
+    /**
+     * @brief Fuses the chains of identifiers and array items in the given
+     * @a expression into path nodes.
+     * @param[in,out] expression The root of the AST.
+     * @return The number of path nodes created.
+     */
+    std::size_t fuse(ast::ExpressionNode& expression);
+};
+}} // namespace jmespath::optimizer
+#endif // PATHFUSER_H
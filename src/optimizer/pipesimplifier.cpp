@@ -0,0 +1,60 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "src/optimizer/pipesimplifier.h"
+#include "src/optimizer/nodepatterns.h"
+#include "src/ast/allnodes.h"
+
+namespace jmespath { namespace optimizer {
+
+const char *PipeSimplifier::name() const
+{
+    return "pipe-simplification";
+}
+
+void PipeSimplifier::run(ast::ExpressionNode &expression)
+{
+    transformBottomUp(expression, [](ast::ExpressionNode& node) {
+        const auto* pipeNode = match<ast::PipeExpressionNode>(node);
+        if (!pipeNode)
+        {
+            return;
+        }
+        // copy the remaining side before replacing the node which owns it
+        if (match<ast::CurrentNode>(pipeNode->rightExpression))
+        {
+            ast::ExpressionNode remainder = pipeNode->leftExpression;
+            node = remainder;
+        }
+        else if (match<ast::CurrentNode>(pipeNode->leftExpression))
+        {
+            ast::ExpressionNode remainder = pipeNode->rightExpression;
+            node = remainder;
+        }
+    });
+}
+}} // namespace jmespath::optimizer
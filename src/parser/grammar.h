@@ -34,6 +34,8 @@
 #include "src/parser/appendutf8action.h"
 #include "src/parser/appendescapesequenceaction.h"
 #include "src/parser/encodesurrogatepairaction.h"
+#include "src/parser/resolvefunctionaction.h"
+#include "src/parser/updateuniquekeysaction.h"
 #include "src/parser/nodeinsertpolicy.h"
 #include "src/parser/nodeinsertcondition.h"
 #include <boost/spirit/include/qi.hpp>
@@ -107,6 +109,11 @@ public:
         // lazy function for for combining surrogate pair characters into a
         // single codepoint
         phx::function<EncodeSurrogatePairAction> encodeSurrogatePair;
+        // lazy function for resolving the implementation of called functions
+        phx::function<ResolveFunctionAction> resolveFunction;
+        // lazy function for checking whether the keys of multiselect hashes
+        // are unique
+        phx::function<UpdateUniqueKeysAction> updateUniqueKeys;
 
         // optionally match an expression
         // this ensures that the parsing of empty expressions which contain
@@ -114,16 +121,19 @@ public:
         m_topLevelExpressionRule = -m_expressionRule[insertNode(_val, _1)];
 
         // match a standalone index expression or hash wildcard expression or
-        // not expression or function expression or identifier or multiselect
-        // list or multiselect hash or literal or a raw string or paren
-        // expression or current node expression, optionally followed by a
+        // not expression or let expression or variable reference or function
+        // expression or identifier or multiselect list or multiselect hash or
+        // literal or a raw string or paren expression or current node
+        // expression, optionally followed by a
         // subexpression an index expression a hash wildcard subexpression a
         // pipe expresion a comparator expression an or expression and an and
         // expression
         m_expressionRule = (m_indexExpressionRule(_val)[insertNode(_val, _1)]
                     | m_hashWildcardRule(_val)[insertNode(_val, _1)]
                     | m_notExpressionRule(_val)[insertNode(_val, _1)]
-                    | (m_functionExpressionRule
+                    | (m_letExpressionRule
+                      | m_variableRefRule
+                      | m_functionExpressionRule
                       | m_identifierRule
                       | m_multiselectListRule
                       | m_multiselectHashRule
@@ -238,9 +248,10 @@ public:
         // match a key-value pair enclosed in curly braces, the key-value pair
         // can optionally be followed by more key-value pairs separated with
         // commas
-        m_multiselectHashRule = lit('{')
+        m_multiselectHashRule %= lit('{')
                 >> m_keyValuePairRule % lit(',')
-                >> lit('}');
+                >> lit('}')
+                >> eps[updateUniqueKeys(_val)];
 
         // match an expression preceded by an exclamation mark
         m_notExpressionRule = lit('!') >> m_expressionRule[_r1 = _1];
@@ -273,10 +284,39 @@ public:
         // match
         m_currentNodeRule = eps >> lit('@');
 
+        // match the let keyword followed by variable bindings separated with
+        // commas, the in keyword and the expression in which the variables
+        // are visible, the expression extends as far as possible
+        m_letExpressionRule = m_letKeywordRule
+                >> m_variableBindingRule % lit(',')
+                >> m_inKeywordRule
+                >> m_expressionRule;
+
+        // match a variable reference and an expression separated with an
+        // equals sign
+        m_variableBindingRule = m_variableRefRule
+                >> lit('=')
+                >> m_expressionRule;
+
+        // match an unquoted string preceded by a dollar sign
+        m_variableRefRule = lexeme[ lit('$') >> m_unquotedStringRule ];
+
+        // match the let and in keywords only if they're not the beginning of
+        // a longer unquoted string, otherwise let is an identifier
+        m_letKeywordRule = lexeme[ lit("let") >> !m_unquotedStringCharRule ];
+        m_inKeywordRule = lexeme[ lit("in") >> !m_unquotedStringCharRule ];
+
+        // match a character which can continue an unquoted string
+        m_unquotedStringCharRule = char_(U'\x30', U'\x39')
+                | char_(U'\x41', U'\x5A')
+                | char_(U'\x5F')
+                | char_(U'\x61', U'\x7A');
+
         // match an unquoted string which is optionally followed by an argument
-        // list enclosed in parenthesis
-        m_functionExpressionRule = m_unquotedStringRule
-                >> lit('(') >> -m_functionArgumentListRule >> lit(')');
+        // list enclosed in parenthesis and resolve the called function
+        m_functionExpressionRule %= m_unquotedStringRule
+                >> lit('(') >> -m_functionArgumentListRule >> lit(')')
+                >> eps[resolveFunction(_val)];
 
         // match a sequence of function arguments separated with commas
         m_functionArgumentListRule = m_functionArgumentRule % lit(',');
@@ -477,6 +517,16 @@ private:
     qi::rule<Iterator, ast::RawStringNode(), Skipper> m_rawStringRule;
     qi::rule<Iterator, ast::LiteralNode(), Skipper> m_literalRule;
     qi::rule<Iterator, ast::CurrentNode()>  m_currentNodeRule;
+    qi::rule<Iterator,
+             ast::LetExpressionNode(),
+             Skipper> m_letExpressionRule;
+    qi::rule<Iterator,
+             ast::LetExpressionNode::BindingType(),
+             Skipper> m_variableBindingRule;
+    qi::rule<Iterator, ast::VariableRefNode(), Skipper> m_variableRefRule;
+    qi::rule<Iterator, Skipper>             m_letKeywordRule;
+    qi::rule<Iterator, Skipper>             m_inKeywordRule;
+    qi::rule<Iterator, UnicodeChar()>       m_unquotedStringCharRule;
     qi::rule<Iterator, UnicodeChar()>       m_literalCharRule;
     qi::rule<Iterator, UnicodeChar()>       m_literalEscapeRule;
     qi::rule<Iterator, UnicodeChar()>       m_rawStringCharRule;
@@ -0,0 +1,134 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/adaptivelogicorderer.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+#include "jmespath/functions.h"
+
+TEST_CASE("AdaptiveLogicOrderer")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    AdaptiveLogicOrderer orderer;
+    auto profile = [&](const String& text) {
+        ast::ExpressionNode expression = parser.parse(text);
+        orderer.run(expression);
+        std::vector<String> result;
+        for (const auto& profiledOperator: orderer.profiledOperators())
+        {
+            result.push_back(profiledOperator.expression);
+        }
+        return result;
+    };
+    using Texts = std::vector<String>;
+
+    SECTION("has a name")
+    {
+        REQUIRE(String{orderer.name()} == "adaptive-logic-ordering");
+    }
+
+    SECTION("is disabled by default")
+    {
+        REQUIRE_FALSE(AdaptiveLogicOrderer::isEnabled());
+    }
+
+    SECTION("profiles the operators of filter conditions")
+    {
+        REQUIRE(profile("a[?b && c]") == Texts{"b && c"});
+        REQUIRE(profile("a[?b || c == `1`]") == Texts{"b || c == `1`"});
+        REQUIRE(profile("a[?(b && c) || d]")
+                == (Texts{"(b && c) || d", "b && c"}));
+    }
+
+    SECTION("profiles the operators of not expressions")
+    {
+        REQUIRE(profile("!(a && b)") == Texts{"a && b"});
+    }
+
+    SECTION("attaches the profiles to the nodes")
+    {
+        ast::ExpressionNode expression = parser.parse("a[?b && c]");
+        orderer.run(expression);
+
+        const auto& indexNode = boost::get<ast::IndexExpressionNode>(
+                    expression.value);
+        const auto& filterNode = boost::get<ast::FilterExpressionNode>(
+                    indexNode.bracketSpecifier.value);
+        const auto& andNode = boost::get<ast::AndExpressionNode>(
+                    filterNode.expression.value);
+        REQUIRE(andNode.profile);
+        REQUIRE(andNode.profile == orderer.profiledOperators()[0].profile);
+    }
+
+    SECTION("doesn't profile operators whose result value is used")
+    {
+        REQUIRE(profile("a && b").empty());
+        REQUIRE(profile("a[?(b && c) == `true`]").empty());
+        REQUIRE(profile("[a || b]").empty());
+    }
+
+    SECTION("doesn't profile operators whose left operand can raise errors")
+    {
+        REQUIRE(profile("a[?length(b) > `1` && c]").empty());
+        REQUIRE(profile("a[?b[::0] && c]").empty());
+        REQUIRE(profile("a[?$b && c]").empty());
+    }
+
+    SECTION("profiles operators whose right operand calls built in functions")
+    {
+        REQUIRE(profile("a[?b && length(c) > `1`]")
+                == Texts{"b && length(c) > `1`"});
+    }
+
+    SECTION("profiles operators which refer to bound variables")
+    {
+        REQUIRE(profile("let $x = `1` in a[?b == $x && c]")
+                == Texts{"b == $x && c"});
+        REQUIRE(profile("let $x = length(a) in a[?b == $x && c]")
+                == Texts{"b == $x && c"});
+    }
+
+    SECTION("doesn't profile operators whose right operand calls custom "
+            "functions")
+    {
+        registerFunction("adaptive_logic_orderer_test_flag",
+                         {{ArgumentType::Any}},
+                         [](const FunctionArguments&) {
+            return Json(true);
+        });
+
+        REQUIRE(profile("a[?b && adaptive_logic_orderer_test_flag(c)]")
+                .empty());
+    }
+}
@@ -0,0 +1,112 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/commonsubexpressioneliminator.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("CommonSubexpressionEliminator")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+    using Report = std::vector<SharedSubexpression>;
+
+    Parser<Grammar> parser;
+    CommonSubexpressionEliminator eliminator;
+    ast::ExpressionNode expression;
+    auto eliminate = [&](const String& text) {
+        expression = parser.parse(text);
+        return eliminator.eliminate(expression);
+    };
+    auto format = [&]() {
+        return ExpressionFormatter{}.format(expression);
+    };
+
+    SECTION("shares the repeated subexpressions of the same context")
+    {
+        REQUIRE(eliminate("{a: x.y.a, b: x.y.b, c: x.y.c}")
+                == Report{{"x.y", 3}});
+        REQUIRE(format() == "let $0 = x.y in {a: $0.a, b: $0.b, c: $0.c}");
+        auto* letNode = boost::get<ast::LetExpressionNode>(&expression.value);
+        REQUIRE(letNode != nullptr);
+        REQUIRE(letNode->deferred);
+    }
+
+    SECTION("shares the largest subexpressions first")
+    {
+        REQUIRE(eliminate("[a.b.c, a.b.c, a.b.d]")
+                == (Report{{"a.b.c", 2}, {"a.b", 2}}));
+        REQUIRE(format() == "let $0 = $1.c, $1 = a.b in [$0, $0, $1.d]");
+    }
+
+    SECTION("shares the subexpressions of nested scopes in their own scope")
+    {
+        REQUIRE(eliminate("items[*].{x: a.b.c, y: a.b.d}")
+                == Report{{"a.b", 2}});
+        REQUIRE(format() == "items[*].let $0 = a.b in {x: $0.c, y: $0.d}");
+    }
+
+    SECTION("shares built in function calls")
+    {
+        REQUIRE(eliminate("[length(a.b), length(a.b)]")
+                == Report{{"length(a.b)", 2}});
+    }
+
+    SECTION("doesn't share subexpressions evaluated on different contexts")
+    {
+        REQUIRE(eliminate("{x: a.b, y: c[*].a.b, z: sort_by(d, &a.b)}")
+                .empty());
+        REQUIRE(eliminate("a.b | a.b").empty());
+    }
+
+    SECTION("doesn't share identifiers and constants")
+    {
+        REQUIRE(eliminate("[a, a, 'b', 'b', `1`, `1`, @, @]").empty());
+    }
+
+    SECTION("doesn't share subexpressions which refer to variables")
+    {
+        REQUIRE(eliminate("let $v = a in {x: $v.b, y: $v.b}").empty());
+    }
+
+    SECTION("doesn't share calls of unknown functions")
+    {
+        REQUIRE(eliminate("[unknown(a).b, unknown(a).b]").empty());
+    }
+
+    SECTION("leaves expressions without repetitions unchanged")
+    {
+        REQUIRE(eliminate("a.b.c[?d == `1`].e").empty());
+        REQUIRE(expression == parser.parse("a.b.c[?d == `1`].e"));
+    }
+}
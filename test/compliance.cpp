@@ -29,7 +29,13 @@
 #include "fakeit.hpp"
 #include "jmespath/jmespath.h"
 #include "src/interpreter/interpreter.h"
+#include "src/optimizer/optimizer.h"
+#include "src/optimizer/adaptivelogicorderer.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
 #include <fstream>
+#include <boost/type_index.hpp>
 
 using namespace jmespath;
 
@@ -88,6 +94,64 @@ protected:
         }
     }
 
+    void executeOptimizerTest(const std::string& featureName) const
+    {
+        Json testSuites = readTestSuites(featureName + ".json");
+        const std::size_t passCount
+                = optimizer::Optimizer::defaultPasses().size();
+        for (auto& testSuite: testSuites)
+        {
+            const Json& document = testSuite["given"];
+            const Json& testCases = testSuite["cases"];
+            for (const auto& testCase: testCases)
+            {
+                auto expression = testCase["expression"]
+                        .get_ref<const String&>();
+                // evaluate the expression with every pass on its own and
+                // with all the passes, which should all produce the same
+                // result as the unoptimized expression
+                String expectedResult = evaluate(expression, document, {});
+                for (std::size_t i = 0; i <= passCount; ++i)
+                {
+                    auto passes = optimizer::Optimizer::defaultPasses();
+                    String passName = "all passes";
+                    if (i < passCount)
+                    {
+                        passName = passes[i]->name();
+                        std::vector<optimizer::Optimizer::PassPtr> pass;
+                        pass.push_back(std::move(passes[i]));
+                        passes = std::move(pass);
+                    }
+                    String result = evaluate(expression, document,
+                                             std::move(passes));
+                    if (result != expectedResult)
+                    {
+                        FAIL("Expression: " + expression
+                             + "\nPass: " + passName
+                             + "\nExpected result: " + expectedResult
+                             + "\nResult: " + result);
+                    }
+                }
+                // evaluate the expression repeatedly with adaptively ordered
+                // logic operators, which sample every other evaluation and
+                // evaluate the rest in the chosen order
+                auto passes = optimizer::Optimizer::defaultPasses();
+                passes.push_back(
+                    std::make_unique<optimizer::AdaptiveLogicOrderer>(1, 2));
+                String result = evaluate(expression, document,
+                                         std::move(passes), 3);
+                if (result != expectedResult)
+                {
+                    FAIL("Expression: " + expression
+                         + "\nPass: adaptive-logic-ordering"
+                         + "\nExpected result: " + expectedResult
+                         + "\nResult: " + result);
+                }
+            }
+        }
+        SUCCEED();
+    }
+
     template <typename JsonT>
     void testResult(const std::string& expression,
                     JsonT&& document,
@@ -190,6 +254,52 @@ protected:
 private:
     static const std::string s_absoluteDirPath;
 
+    String evaluate(const String& expression,
+                    const Json& document,
+                    std::vector<optimizer::Optimizer::PassPtr> passes,
+                    std::size_t evaluationCount = 1) const
+    {
+        auto errorResult = [](const std::exception& exc) {
+            return "Exception: " + boost::typeindex::type_id_runtime(exc)
+                    .pretty_name();
+        };
+        parser::Parser<parser::Grammar> parser;
+        interpreter::Interpreter interpreter;
+        ast::ExpressionNode astRoot;
+        try
+        {
+            astRoot = parser.parse(expression);
+            optimizer::Optimizer{std::move(passes)}.optimize(astRoot);
+        }
+        catch (std::exception& exc)
+        {
+            return errorResult(exc);
+        }
+        // every evaluation of the expression should have the same result
+        String result;
+        for (std::size_t i = 0; i < evaluationCount; ++i)
+        {
+            String evaluationResult;
+            try
+            {
+                interpreter.setContext(document);
+                interpreter.visit(&astRoot);
+                evaluationResult = interpreter.currentContext().dump();
+            }
+            catch (std::exception& exc)
+            {
+                evaluationResult = errorResult(exc);
+            }
+            if (i > 0 && evaluationResult != result)
+            {
+                return "Inconsistent results: " + result + ", "
+                        + evaluationResult;
+            }
+            result = evaluationResult;
+        }
+        return result;
+    }
+
     Json readTestSuites(const std::string& fileName) const
     {
         std::ifstream jsonFile;
@@ -398,3 +508,16 @@ TEST_CASE_METHOD(ComplianceTestFixture, "Compliance/Benchmarks rvalue",
 {
     executeFeatureTest("benchmarks", true);
 }
+
+TEST_CASE_METHOD(ComplianceTestFixture, "Compliance/Optimizer passes",
+                 "[optimizer]")
+{
+    for (const auto& featureName: {"identifiers", "literal", "basic",
+                                   "boolean", "current", "escape", "filters",
+                                   "functions", "indices", "multiselect",
+                                   "pipe", "slice", "syntax", "unicode",
+                                   "wildcard", "benchmarks"})
+    {
+        executeOptimizerTest(featureName);
+    }
+}
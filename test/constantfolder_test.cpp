@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/constantfolder.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+#include "jmespath/functions.h"
+
+TEST_CASE("ConstantFolder")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    ConstantFolder folder;
+    auto fold = [&](const String& text) {
+        ast::ExpressionNode expression = parser.parse(text);
+        folder.run(expression);
+        return ExpressionFormatter{}.format(expression);
+    };
+
+    SECTION("has a name")
+    {
+        REQUIRE(String{folder.name()} == "constant-folding");
+    }
+
+    SECTION("folds operators with constant operands")
+    {
+        REQUIRE(fold("`1` < `2`") == "`true`");
+        REQUIRE(fold("'a' == 'b'") == "`false`");
+        REQUIRE(fold("!`[]`") == "`true`");
+        REQUIRE(fold("`0` || `null` || 'x'") == "`0`");
+        REQUIRE(fold("`true` && 'x'") == "'x'");
+        REQUIRE(fold("(`1` == `1`)") == "`true`");
+    }
+
+    SECTION("folds built in functions with constant arguments")
+    {
+        REQUIRE(fold("length('abc')") == "`3`");
+        REQUIRE(fold("join(', ', `[\"a\", \"b\"]`)") == "'a, b'");
+        REQUIRE(fold("sort(`[3, 1, 2]`)") == "`[1,2,3]`");
+        REQUIRE(fold("map(&`1`, `[1, 2]`)") == "`[1,1]`");
+        REQUIRE(fold("type(length('ab')) == 'number'") == "`true`");
+    }
+
+    SECTION("folds the constant parts of expressions")
+    {
+        REQUIRE(fold("a[?length('ab') == b]") == "a[?`2` == b]");
+        REQUIRE(fold("[a, `1` < `2`]") == "[a, `true`]");
+    }
+
+    SECTION("doesn't fold expressions which depend on the context")
+    {
+        REQUIRE(fold("a == `1`") == "a == `1`");
+        REQUIRE(fold("`[1]`") == "`[1]`");
+        REQUIRE(fold("[`1`, `2`]") == "[`1`, `2`]");
+        REQUIRE(fold("length(@)") == "length(@)");
+        REQUIRE(fold("max_by(`[{\"a\": 1}]`, &a)")
+                == "max_by(`[{\"a\": 1}]`, &a)");
+        REQUIRE(fold("let $a = `1` in $a == `1`")
+                == "let $a = `1` in $a == `1`");
+    }
+
+    SECTION("doesn't fold expressions which throw exceptions")
+    {
+        REQUIRE(fold("length(`1`)") == "length(`1`)");
+        REQUIRE(fold("abs('a') == `1`") == "abs('a') == `1`");
+    }
+
+    SECTION("doesn't fold custom functions")
+    {
+        registerFunction("constant_folder_test_answer",
+                         {{ArgumentType::Any}},
+                         [](const FunctionArguments&) {
+            return Json(42);
+        });
+
+        REQUIRE(fold("constant_folder_test_answer(`1`)")
+                == "constant_folder_test_answer(`1`)");
+    }
+}
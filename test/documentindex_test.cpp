@@ -0,0 +1,191 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include <jmespath/jmespath.h>
+#include <utility>
+
+TEST_CASE("DocumentIndex")
+{
+    using namespace jmespath;
+
+    Json document = R"({
+        "users": [
+            {"id": "u1", "age": 30, "profile": {"team": "a"}},
+            {"id": "u2", "age": 25, "profile": {"team": "b"}},
+            {"id": "u3", "age": 30.0, "profile": {"team": "a"}},
+            {"id": "u1", "age": 41},
+            {"name": "u4"}
+        ]
+    })"_json;
+    const Json& constDocument = document;
+    auto unindexed = [&](const String& expression) {
+        return search(expression, Json::parse(document.dump()));
+    };
+
+    SECTION("throws InvalidAgrument if the path doesn't select an array")
+    {
+        REQUIRE_THROWS_AS(DocumentIndex(document, "users[0]", "id"),
+                          InvalidAgrument);
+        REQUIRE_THROWS_AS(DocumentIndex(document, "missing", "id"),
+                          InvalidAgrument);
+        REQUIRE_THROWS_AS(DocumentIndex(document, "users[*].id", "@"),
+                          InvalidAgrument);
+    }
+
+    SECTION("throws InvalidAgrument if an expression is empty")
+    {
+        REQUIRE_THROWS_AS(DocumentIndex(document, "", "id"), InvalidAgrument);
+        REQUIRE_THROWS_AS(DocumentIndex(document, "users", ""),
+                          InvalidAgrument);
+    }
+
+    SECTION("throws InvalidAgrument if the key calls custom functions")
+    {
+        registerFunction("document_index_test_key",
+                         {{ArgumentType::Any}},
+                         [](const FunctionArguments& arguments) -> Json {
+            return arguments[0];
+        });
+
+        REQUIRE_THROWS_AS(DocumentIndex(document, "users",
+                                        "document_index_test_key(id)"),
+                          InvalidAgrument);
+        REQUIRE_NOTHROW(DocumentIndex(document, "users", "to_string(age)"));
+    }
+
+    SECTION("throws SyntaxError if an expression is invalid")
+    {
+        REQUIRE_THROWS_AS(DocumentIndex(document, "users[", "id"),
+                          SyntaxError);
+    }
+
+    SECTION("stores its expressions and the number of keys")
+    {
+        DocumentIndex index{document, "users", "id"};
+
+        REQUIRE(index.arrayPath() == "users");
+        REQUIRE(index.keyExpression() == "id");
+        REQUIRE(index.keyCount() == 4);
+        REQUIRE(index.isValid());
+    }
+
+    SECTION("filters give the same results as without the index")
+    {
+        DocumentIndex idIndex{document, "users", "id"};
+        DocumentIndex ageIndex{document, "users", "age"};
+        DocumentIndex teamIndex{document, "users", "profile.team"};
+        auto expression = GENERATE(as<String>{},
+            "users[?id == 'u1']",
+            "users[?'u1' == id]",
+            "users[?id == `\"u2\"`].age",
+            "users[?id == 'missing']",
+            "users[?id == `null`]",
+            "users[?age == `30`].id",
+            "users[?age == `30.0`] | length(@)",
+            "users[?profile.team == 'a'].id",
+            "users[?id == 'u1'] | [0].age",
+            "users[?id == 'u1'].age | [0]",
+            "users[?id != 'u1'].id");
+
+        REQUIRE(search(expression, constDocument) == unindexed(expression));
+        REQUIRE(search(expression, document) == unindexed(expression));
+        REQUIRE(search(expression, Json(document)) == unindexed(expression));
+    }
+
+    SECTION("is used for the copies of the document")
+    {
+        DocumentIndex index{document, "users", "id"};
+        Json copy = document;
+
+        REQUIRE(search("users[?id == 'u1'].age", copy) == "[30, 41]"_json);
+        REQUIRE(search("users[?id == 'u1'].age", std::move(copy))
+                == "[30, 41]"_json);
+        REQUIRE(index.isValid());
+    }
+
+    SECTION("becomes invalid when the array is modified")
+    {
+        DocumentIndex index{document, "users", "id"};
+
+        document["users"].push_back(Json{{"id", "u1"}, {"age", 50}});
+
+        REQUIRE_FALSE(index.isValid());
+        REQUIRE(search("users[?id == 'u1'].age", constDocument)
+                == "[30, 41, 50]"_json);
+    }
+
+    SECTION("searches don't invalidate the index")
+    {
+        DocumentIndex index{document, "users", "id"};
+
+        search("users[*].id", constDocument);
+        search("sort_by(users[?age], &age)[?id == 'u1']", document);
+        search("users[?age > `20`]", Json(document));
+
+        REQUIRE(index.isValid());
+    }
+
+    SECTION("is no longer used once it's destroyed")
+    {
+        {
+            DocumentIndex index{document, "users", "id"};
+        }
+
+        REQUIRE(search("users[?id == 'u2'].age", constDocument)
+                == "[25]"_json);
+    }
+
+    SECTION("can be moved")
+    {
+        DocumentIndex index{document, "users", "id"};
+
+        SECTION("by move construction")
+        {
+            DocumentIndex other{std::move(index)};
+
+            REQUIRE(other.isValid());
+            REQUIRE(other.keyCount() == 4);
+            REQUIRE_FALSE(index.isValid());
+            REQUIRE(index.keyCount() == 0);
+        }
+
+        SECTION("by move assignment")
+        {
+            DocumentIndex other{document, "users", "age"};
+
+            other = std::move(index);
+
+            REQUIRE(other.keyExpression() == "id");
+            REQUIRE(other.keyCount() == 4);
+            REQUIRE_FALSE(index.isValid());
+        }
+
+        REQUIRE(search("users[?id == 'u1'].age", constDocument)
+                == "[30, 41]"_json);
+    }
+}
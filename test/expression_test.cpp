@@ -26,8 +26,10 @@
 **
 ****************************************************************************/
 #include "fakeit.hpp"
-#include "jmespath/expression.h"
+#include "jmespath/jmespath.h"
 #include "src/ast/allnodes.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
 
 TEST_CASE("Expression")
 {
@@ -189,4 +191,66 @@ TEST_CASE("Expression")
 
         REQUIRE_FALSE(exp.astRoot() == nullptr);
     }
+
+    SECTION("reports the shared subexpressions")
+    {
+        Expression exp{"{a: x.y.a, b: x.y.b}"};
+        Expression copy{exp};
+        std::vector<SharedSubexpression> expectedReport{{"x.y", 2}};
+
+        REQUIRE(exp.sharedSubexpressions() == expectedReport);
+        REQUIRE(copy.sharedSubexpressions() == expectedReport);
+        REQUIRE(Expression{"a.b"}.sharedSubexpressions().empty());
+    }
+
+    SECTION("doesn't optimize expressions while the optimizer is disabled")
+    {
+        String expression{"{a: (x.y).a | @, b: x.y.b}"};
+        REQUIRE(isOptimizerEnabled());
+
+        setOptimizerEnabled(false);
+        REQUIRE_FALSE(isOptimizerEnabled());
+        Expression exp{expression};
+        setOptimizerEnabled(true);
+
+        REQUIRE(*exp.astRoot() == parser::Parser<parser::Grammar>{}.parse(
+                    expression));
+        REQUIRE(exp.sharedSubexpressions().empty());
+        REQUIRE(search(exp, "{\"x\": {\"y\": {\"a\": 1, \"b\": 2}}}"_json)
+                == "{\"a\": 1, \"b\": 2}"_json);
+    }
+
+    SECTION("doesn't order logic operators adaptively by default")
+    {
+        Expression exp{"a[?b && c]"};
+
+        REQUIRE_FALSE(isAdaptiveLogicOrderEnabled());
+        REQUIRE(exp.logicOperatorOrders().empty());
+    }
+
+    SECTION("reports the order of adaptively ordered logic operators")
+    {
+        String expression{"items[?a[?@ == 'x'] == b[?@ == 'y'] && flag]"};
+        setAdaptiveLogicOrderEnabled(true);
+        REQUIRE(isAdaptiveLogicOrderEnabled());
+        Expression exp{expression};
+        setAdaptiveLogicOrderEnabled(false);
+        Json item = {{"a", Json(50, "z")}, {"b", Json(50, "z")},
+                     {"flag", false}};
+        Json document = {{"items", Json(200, item)}};
+        document["items"][100]["flag"] = true;
+
+        REQUIRE(exp.logicOperatorOrders() == std::vector<LogicOperatorOrder>{
+                    {"a[?@ == 'x'] == b[?@ == 'y'] && flag", false, 0}});
+
+        auto result = search(exp, document);
+        auto orders = exp.logicOperatorOrders();
+
+        REQUIRE(result == search(expression, document));
+        REQUIRE(result.size() == 1);
+        REQUIRE(orders.size() == 1);
+        REQUIRE(orders[0].swapped);
+        REQUIRE(orders[0].samples >= 32);
+        REQUIRE(Expression{exp}.logicOperatorOrders() == orders);
+    }
 }
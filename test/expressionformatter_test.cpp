@@ -0,0 +1,115 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("ExpressionFormatter")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    ExpressionFormatter formatter;
+    auto format = [&](const String& expression) {
+        return formatter.format(parser.parse(expression));
+    };
+
+    SECTION("formats identifiers, quoting them only if necessary")
+    {
+        REQUIRE(format("foo") == "foo");
+        REQUIRE(format("\"foo\"") == "foo");
+        REQUIRE(format("\"foo bar\"") == "\"foo bar\"");
+        REQUIRE(format("\"1a\"") == "\"1a\"");
+        REQUIRE(format("\"a\\\"b\"") == "\"a\\\"b\"");
+    }
+
+    SECTION("formats raw strings and literals with their escapes")
+    {
+        REQUIRE(format("'a\\'b'") == "'a\\'b'");
+        REQUIRE(format("`\"a\\`b\"`") == "`\"a\\`b\"`");
+    }
+
+    SECTION("formats subexpressions and projections")
+    {
+        REQUIRE(format("a.b.c") == "a.b.c");
+        REQUIRE(format("a[*].b[0].c") == "a[*].b[0].c");
+        REQUIRE(format("*.a") == "*.a");
+        REQUIRE(format("a.*.b") == "a.*.b");
+        REQUIRE(format("a[].b[-1:2:-3]") == "a[].b[-1:2:-3]");
+        REQUIRE(format("a[?b == `1` && !c].d") == "a[?b == `1` && !c].d");
+        REQUIRE(format("a.{b: c, \"d e\": [f, @]}")
+                == "a.{b: c, \"d e\": [f, @]}");
+    }
+
+    SECTION("formats functions, pipes and parentheses")
+    {
+        REQUIRE(format("sort_by(a, &b)[0]|(c||d)")
+                == "sort_by(a, &b)[0] | (c || d)");
+    }
+
+    SECTION("formats let expressions")
+    {
+        REQUIRE(format("let $a = b, $c = d in $a.e")
+                == "let $a = b, $c = d in $a.e");
+    }
+
+    SECTION("formats path nodes as the chains they were fused from")
+    {
+        using Segments = std::vector<ast::PathNode::SegmentType>;
+        ast::ExpressionNode pathNode{ast::PathNode{
+                Segments{String{"a"}, std::int64_t{-1}, String{"b c"}}}};
+        ast::ExpressionNode projection{ast::IndexExpressionNode{
+                ast::ExpressionNode{ast::IdentifierNode{"x"}},
+                ast::BracketSpecifierNode{ast::ListWildcardNode{}},
+                pathNode}};
+
+        REQUIRE(formatter.format(pathNode) == "a[-1].\"b c\"");
+        REQUIRE(formatter.format(projection) == "x[*].a[-1].\"b c\"");
+    }
+
+    SECTION("formats text which parses to an equal AST")
+    {
+        std::vector<String> expressions {
+            "a[*][0].b | [0]",
+            "(a[*].b)[0]",
+            "a || b && c == d",
+            "!(a == b) || c < `2`",
+            "map(&a.b, c[:2])[?x].y",
+            "foo[?a.b.c == 'x'].{x: a.b.c, y: a.b.d}"};
+        for (const auto& expression: expressions)
+        {
+            auto ast = parser.parse(expression);
+            REQUIRE(parser.parse(formatter.format(ast)) == ast);
+        }
+    }
+}
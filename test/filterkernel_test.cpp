@@ -0,0 +1,151 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/filterkernel.h"
+#include <limits>
+
+TEST_CASE("FilterKernel")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using Comparator = FilterKernel::Comparator;
+    using Predicate = FilterKernel::Predicate;
+    using Mask = std::vector<std::uint8_t>;
+
+    FilterKernel::Workspace workspace;
+    auto select = [&workspace](std::vector<Predicate> predicates,
+                               const Json& array) {
+        FilterKernel kernel{std::move(predicates)};
+        REQUIRE(kernel.select(array, workspace));
+        return workspace.mask();
+    };
+    Json items = R"([
+        {"a": 1}, {"a": 2.5}, {"a": -3}, {"a": "2"}, {"a": null},
+        {"a": true}, {"a": [2]}, {"b": 2}, 7
+    ])"_json;
+
+    SECTION("supports comparisons with scalar constants")
+    {
+        REQUIRE(FilterKernel::isSupported({{}, Comparator::Equal, "a"}));
+        REQUIRE(FilterKernel::isSupported({{}, Comparator::NotEqual, {}}));
+        REQUIRE(FilterKernel::isSupported({{}, Comparator::Equal, false}));
+        REQUIRE(FilterKernel::isSupported({{}, Comparator::Less, -1}));
+        REQUIRE(FilterKernel::isSupported({{}, Comparator::Greater, 0.5}));
+    }
+
+    SECTION("doesn't support unsupported constants")
+    {
+        REQUIRE_FALSE(FilterKernel::isSupported(
+                          {{}, Comparator::Less, "a"}));
+        REQUIRE_FALSE(FilterKernel::isSupported(
+                          {{}, Comparator::Equal, Json::array()}));
+        REQUIRE_FALSE(FilterKernel::isSupported(
+                          {{}, Comparator::Equal,
+                           std::numeric_limits<std::uint64_t>::max()}));
+        REQUIRE_FALSE(FilterKernel::isSupported(
+                          {{}, Comparator::Unknown, 1}));
+    }
+
+    SECTION("compares numbers with integer constants")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::Greater, 1}}, items)
+                == Mask{0, 1, 0, 0, 0, 0, 0, 0, 0});
+        REQUIRE(select({{{String{"a"}}, Comparator::LessOrEqual, 1}}, items)
+                == Mask{1, 0, 1, 0, 0, 0, 0, 0, 0});
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, -3}}, items)
+                == Mask{0, 0, 1, 0, 0, 0, 0, 0, 0});
+    }
+
+    SECTION("compares numbers with floating point constants")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::Less, 2.5}}, items)
+                == Mask{1, 0, 1, 0, 0, 0, 0, 0, 0});
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, 1.0}}, items)
+                == Mask{1, 0, 0, 0, 0, 0, 0, 0, 0});
+    }
+
+    SECTION("selects the items which are not equal to the constant")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::NotEqual, 1}}, items)
+                == Mask{0, 1, 1, 1, 1, 1, 1, 1, 1});
+        REQUIRE(select({{{String{"a"}}, Comparator::NotEqual, "2"}}, items)
+                == Mask{1, 1, 1, 0, 1, 1, 1, 1, 1});
+    }
+
+    SECTION("compares strings, booleans and nulls")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, "2"}}, items)
+                == Mask{0, 0, 0, 1, 0, 0, 0, 0, 0});
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, true}}, items)
+                == Mask{0, 0, 0, 0, 0, 1, 0, 0, 0});
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, {}}}, items)
+                == Mask{0, 0, 0, 0, 1, 0, 0, 1, 1});
+    }
+
+    SECTION("compares the items themselves with an empty path")
+    {
+        REQUIRE(select({{{}, Comparator::Greater, 5}}, items)
+                == Mask{0, 0, 0, 0, 0, 0, 0, 0, 1});
+    }
+
+    SECTION("follows the keys and indices of the path")
+    {
+        Json nested = R"([
+            {"a": {"b": [1, 2]}}, {"a": {"b": [3]}}, {"a": {"b": 2}}
+        ])"_json;
+
+        REQUIRE(select({{{String{"a"}, String{"b"}, std::int64_t{-1}},
+                         Comparator::Equal, 2}}, nested)
+                == Mask{1, 0, 0});
+        REQUIRE(select({{{String{"a"}, String{"b"}, std::int64_t{0}},
+                         Comparator::GreaterOrEqual, 1}}, nested)
+                == Mask{1, 1, 0});
+    }
+
+    SECTION("selects the items which satisfy all predicates")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::Greater, -5},
+                        {{String{"a"}}, Comparator::Less, 2}}, items)
+                == Mask{1, 0, 1, 0, 0, 0, 0, 0, 0});
+    }
+
+    SECTION("doesn't select from arrays with out of range integers")
+    {
+        Json array = Json::array({Json::object()});
+        array[0]["a"] = std::numeric_limits<std::uint64_t>::max();
+        FilterKernel kernel{{{{String{"a"}}, Comparator::Equal, 1}}};
+
+        REQUIRE_FALSE(kernel.select(array, workspace));
+    }
+
+    SECTION("selects nothing from empty arrays")
+    {
+        REQUIRE(select({{{String{"a"}}, Comparator::Equal, 1}},
+                       Json::array()).empty());
+    }
+}
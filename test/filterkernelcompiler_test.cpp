@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/filterkernelcompiler.h"
+#include "src/interpreter/filterkernel.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("FilterKernelCompiler")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::FilterKernel;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+    using Comparator = FilterKernel::Comparator;
+    using Path = FilterKernel::PathType;
+
+    Parser<Grammar> parser;
+    FilterKernelCompiler compiler;
+    ast::ExpressionNode expression;
+    auto compile = [&](const String& text) {
+        expression = parser.parse(text);
+        return compiler.compile(expression);
+    };
+    auto kernel = [&]() {
+        auto* indexNode = boost::get<ast::IndexExpressionNode>(
+                    &expression.value);
+        REQUIRE(indexNode);
+        auto* filterNode = boost::get<ast::FilterExpressionNode>(
+                    &indexNode->bracketSpecifier.value);
+        REQUIRE(filterNode);
+        return filterNode->kernel;
+    };
+
+    SECTION("compiles comparisons of fields with constants")
+    {
+        REQUIRE(compile("items[?price > `10`]") == 1);
+        REQUIRE(kernel());
+        const auto& predicates = kernel()->predicates();
+        REQUIRE(predicates.size() == 1);
+        REQUIRE(predicates[0].path == Path{String{"price"}});
+        REQUIRE(predicates[0].comparator == Comparator::Greater);
+        REQUIRE(predicates[0].constant == Json(10));
+    }
+
+    SECTION("compiles conjunctions of comparisons")
+    {
+        REQUIRE(compile("[?(a.b[1] >= `1.5`) && c == 'x' && @ != `null`]")
+                == 1);
+        const auto& predicates = kernel()->predicates();
+        REQUIRE(predicates.size() == 3);
+        REQUIRE(predicates[0].path == Path{String{"a"}, String{"b"},
+                                           std::int64_t{1}});
+        REQUIRE(predicates[0].comparator == Comparator::GreaterOrEqual);
+        REQUIRE(predicates[1].constant == Json("x"));
+        REQUIRE(predicates[2].path.empty());
+        REQUIRE(predicates[2].comparator == Comparator::NotEqual);
+        REQUIRE(predicates[2].constant.is_null());
+    }
+
+    SECTION("mirrors comparisons with the constant on the left side")
+    {
+        REQUIRE(compile("[?`3` < a]") == 1);
+        const auto& predicates = kernel()->predicates();
+        REQUIRE(predicates[0].path == Path{String{"a"}});
+        REQUIRE(predicates[0].comparator == Comparator::Greater);
+    }
+
+    SECTION("compiles nested filters")
+    {
+        REQUIRE(compile("a[?b == `1`].c[?d == `2`]") == 2);
+        REQUIRE(compile("length(a[?b == `1`])") == 1);
+    }
+
+    SECTION("doesn't compile unsupported conditions")
+    {
+        REQUIRE(compile("[?a || b == `1`]") == 0);
+        REQUIRE_FALSE(kernel());
+        REQUIRE(compile("[?a == b]") == 0);
+        REQUIRE(compile("[?a < 'x']") == 0);
+        REQUIRE(compile("[?a == `[1]`]") == 0);
+        REQUIRE(compile("[?a == `1` && b]") == 0);
+        REQUIRE(compile("[?length(a) == `1`]") == 0);
+        REQUIRE(compile("[?a[*] == `1`]") == 0);
+    }
+}
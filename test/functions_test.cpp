@@ -0,0 +1,113 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include <jmespath/jmespath.h>
+
+TEST_CASE("registerFunction")
+{
+    using namespace jmespath;
+
+    SECTION("registers function callable from expressions")
+    {
+        registerFunction("test_add",
+                         {{ArgumentType::Number, ArgumentType::Number}},
+                         [](const FunctionArguments& arguments) -> Json {
+            return arguments[0].get<int>() + arguments[1].get<int>();
+        });
+
+        auto result = search("test_add(a, `2`)", R"({"a": 3})"_json);
+
+        REQUIRE(result == 5);
+    }
+
+    SECTION("registers variadic function")
+    {
+        registerFunction("test_concat", {{ArgumentType::String}, true},
+                         [](const FunctionArguments& arguments) -> Json {
+            String result;
+            for (std::size_t i = 0; i < arguments.size(); ++i)
+            {
+                result += arguments[i].get<String>();
+            }
+            return result;
+        });
+
+        auto result = search("[?test_concat(a, b, 'c') == 'abc'].a",
+                             R"([{"a": "a", "b": "b"},
+                                 {"a": "b", "b": "b"}])"_json);
+
+        REQUIRE(result == R"(["a"])"_json);
+    }
+
+    SECTION("registers function with arguments evaluated on demand")
+    {
+        registerFunction("test_first",
+                         {{ArgumentType::Any, ArgumentType::Number},
+                          false, true},
+                         [](const FunctionArguments& arguments) -> Json {
+            return arguments[0];
+        });
+
+        auto result = search("test_first(a, abs(a))", R"({"a": "b"})"_json);
+
+        REQUIRE(result == "b");
+    }
+
+    SECTION("throws on registering existing function")
+    {
+        auto function = [](const FunctionArguments&) -> Json { return {}; };
+        registerFunction("test_existing", {}, function);
+
+        REQUIRE_THROWS_AS(registerFunction("test_existing", {}, function),
+                          InvalidAgrument);
+        REQUIRE_THROWS_AS(registerFunction("abs", {}, function),
+                          InvalidAgrument);
+    }
+
+    SECTION("throws on invalid number of arguments")
+    {
+        registerFunction("test_arity", {{ArgumentType::Any}},
+                         [](const FunctionArguments&) -> Json { return {}; });
+
+        REQUIRE_THROWS_AS(Expression{"test_arity(a, b)"},
+                          InvalidFunctionArgumentArity);
+    }
+
+    SECTION("throws on invalid argument type")
+    {
+        registerFunction("test_type", {{ArgumentType::Number}},
+                         [](const FunctionArguments&) -> Json { return {}; });
+
+        REQUIRE_THROWS_AS(Expression{"test_type('a')"},
+                          InvalidFunctionArgumentType);
+        REQUIRE_THROWS_AS(Expression{"test_type(&a)"},
+                          InvalidFunctionArgumentType);
+        REQUIRE_THROWS_AS(search("test_type(a)", R"({"a": "b"})"_json),
+                          InvalidFunctionArgumentType);
+    }
+}
@@ -28,6 +28,7 @@
 #include "fakeit.hpp"
 #include "src/parser/grammar.h"
 #include "jmespath/types.h"
+#include "jmespath/exceptions.h"
 #include <limits>
 #include <boost/spirit/include/qi.hpp>
 #include <boost/optional/optional_io.hpp>
@@ -1165,5 +1166,129 @@ TEST_CASE("Grammar")
 
             REQUIRE(parseExpression(grammar, expression) == expectedResult);
         }
+
+        SECTION("function expression with resolved built in function")
+        {
+            auto result = parseExpression(grammar, "abs(id)");
+            const auto* node = boost::get<ast::FunctionExpressionNode>(
+                        &result.value);
+
+            REQUIRE(node != nullptr);
+            REQUIRE(node->functionId.is_initialized());
+        }
+
+        SECTION("function expression with unknown function")
+        {
+            auto result = parseExpression(grammar, "foo(id)");
+            const auto* node = boost::get<ast::FunctionExpressionNode>(
+                        &result.value);
+
+            REQUIRE(node != nullptr);
+            REQUIRE_FALSE(node->functionId.is_initialized());
+        }
+
+        SECTION("variable reference")
+        {
+            auto expectedResult = ast::VariableRefNode{"foo"};
+            String expression{"$foo"};
+
+            REQUIRE(parseExpression(grammar, expression) == expectedResult);
+        }
+
+        SECTION("variable reference with subexpression")
+        {
+            auto expectedResult = ast::SubexpressionNode{
+                    ast::ExpressionNode{
+                        ast::VariableRefNode{"foo"}},
+                    ast::ExpressionNode{
+                        ast::IdentifierNode{"bar"}}};
+            String expression{"$foo.bar"};
+
+            REQUIRE(parseExpression(grammar, expression) == expectedResult);
+        }
+
+        SECTION("let expression")
+        {
+            auto expectedResult = ast::LetExpressionNode{
+                    {{ast::VariableRefNode{"x"},
+                      ast::ExpressionNode{
+                          ast::IdentifierNode{"foo"}}},
+                     {ast::VariableRefNode{"y"},
+                      ast::ExpressionNode{
+                          ast::CurrentNode{}}}},
+                    ast::ExpressionNode{
+                        ast::MultiselectListNode{
+                            {ast::ExpressionNode{
+                                ast::VariableRefNode{"x"}},
+                            ast::ExpressionNode{
+                                ast::VariableRefNode{"y"}}}}}};
+            String expression{"let $x = foo, $y = @ in [$x, $y]"};
+
+            REQUIRE(parseExpression(grammar, expression) == expectedResult);
+        }
+
+        SECTION("let expression whose child expression extends as far as "
+                "possible")
+        {
+            auto expectedResult = ast::LetExpressionNode{
+                    {{ast::VariableRefNode{"x"},
+                      ast::ExpressionNode{
+                          ast::PipeExpressionNode{
+                              ast::ExpressionNode{
+                                  ast::IdentifierNode{"a"}},
+                              ast::ExpressionNode{
+                                  ast::IdentifierNode{"b"}}}}}},
+                    ast::ExpressionNode{
+                        ast::PipeExpressionNode{
+                            ast::ExpressionNode{
+                                ast::VariableRefNode{"x"}},
+                            ast::ExpressionNode{
+                                ast::IdentifierNode{"c"}}}}};
+            String expression{"let $x = a | b in $x | c"};
+
+            REQUIRE(parseExpression(grammar, expression) == expectedResult);
+        }
+
+        SECTION("nested let expressions")
+        {
+            auto expectedResult = ast::LetExpressionNode{
+                    {{ast::VariableRefNode{"x"},
+                      ast::ExpressionNode{
+                          ast::LetExpressionNode{
+                              {{ast::VariableRefNode{"y"},
+                                ast::ExpressionNode{
+                                    ast::IdentifierNode{"a"}}}},
+                              ast::ExpressionNode{
+                                  ast::VariableRefNode{"y"}}}}}},
+                    ast::ExpressionNode{
+                        ast::VariableRefNode{"x"}}};
+            String expression{"let $x = let $y = a in $y in $x"};
+
+            REQUIRE(parseExpression(grammar, expression) == expectedResult);
+        }
+
+        SECTION("let and in keywords as identifiers")
+        {
+            REQUIRE(parseExpression(grammar, "let")
+                    == ast::IdentifierNode{"let"});
+            REQUIRE(parseExpression(grammar, "letter")
+                    == ast::IdentifierNode{"letter"});
+            REQUIRE(parseExpression(grammar, "in")
+                    == ast::IdentifierNode{"in"});
+            REQUIRE(parseExpression(grammar, "let.in")
+                    == ast::SubexpressionNode{
+                           ast::ExpressionNode{
+                               ast::IdentifierNode{"let"}},
+                           ast::ExpressionNode{
+                               ast::IdentifierNode{"in"}}});
+        }
+    }
+
+    SECTION("throws on invalid number of built in function arguments")
+    {
+        REQUIRE_THROWS_AS(parseExpression(grammar, "abs(id1, id2)"),
+                          InvalidFunctionArgumentArity);
+        REQUIRE_THROWS_AS(parseExpression(grammar, "not_null()"),
+                          InvalidFunctionArgumentArity);
     }
 }
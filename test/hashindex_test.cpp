@@ -0,0 +1,176 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/hashindex.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("HashIndex")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+    using Positions = std::vector<std::size_t>;
+
+    Parser<Grammar> parser;
+    Json items = R"([
+        {"id": "a"}, {"id": 1}, {"id": "b"}, {"id": "a"},
+        {"id": 1.0}, {"name": "c"}, 2
+    ])"_json;
+    auto positions = [](HashIndex::PositionRange range) {
+        return Positions(range.begin(), range.end());
+    };
+
+    SECTION("throws InvalidAgrument if the value is not an array")
+    {
+        REQUIRE_THROWS_AS(HashIndex(Json{{"id", 1}}, parser.parse("id")),
+                          InvalidAgrument);
+    }
+
+    SECTION("finds the positions of the items with equal keys")
+    {
+        HashIndex index{items, parser.parse("id")};
+
+        REQUIRE(index.isValid());
+        REQUIRE(index.matches(items));
+        REQUIRE(index.key() == parser.parse("id"));
+        REQUIRE(positions(index.find("a")) == Positions{0, 3});
+        REQUIRE(positions(index.find("b")) == Positions{2});
+        REQUIRE(positions(index.find(1)) == Positions{1, 4});
+        REQUIRE(positions(index.find(1.0)) == Positions{1, 4});
+        REQUIRE(positions(index.find({})) == Positions{5, 6});
+        REQUIRE(positions(index.find("c")).empty());
+        REQUIRE(index.keyCount() == 4);
+    }
+
+    SECTION("matches the copies of the array")
+    {
+        HashIndex index{items, parser.parse("id")};
+        Json copy = items;
+        Json document{{"items", items}};
+
+        REQUIRE(index.matches(copy));
+        REQUIRE(index.matches(document["items"]));
+        REQUIRE(index.containerId() == copy.get_ref<const Json::array_t&>()
+                .buffer_id());
+    }
+
+    SECTION("doesn't match equal arrays in other containers")
+    {
+        HashIndex index{items, parser.parse("id")};
+        Json other = Json::parse(items.dump());
+
+        REQUIRE(other == items);
+        REQUIRE_FALSE(index.matches(other));
+        REQUIRE_FALSE(index.matches(Json{{"id", "a"}}));
+    }
+
+    SECTION("becomes invalid when the array is modified")
+    {
+        HashIndex index{items, parser.parse("id")};
+
+        SECTION("by erasing an item")
+        {
+            items.erase(0);
+        }
+
+        SECTION("by appending an item")
+        {
+            items.push_back(Json{{"id", "b"}});
+        }
+
+        SECTION("through a copy of the array")
+        {
+            Json copy = items;
+            copy.erase(0);
+        }
+
+        REQUIRE_FALSE(index.isValid());
+        REQUIRE_FALSE(index.matches(items));
+    }
+
+    SECTION("stays valid while the array is read")
+    {
+        HashIndex index{items, parser.parse("id")};
+        const Json& constItems = items;
+
+        REQUIRE(constItems[0]["id"] == "a");
+        REQUIRE(constItems.size() == 7);
+        REQUIRE(std::count(constItems.begin(), constItems.end(), items[3])
+                == 2);
+        REQUIRE(index.isValid());
+    }
+}
+
+TEST_CASE("HashIndexRegistry")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    Json items = R"([{"id": 1}, {"id": 2}])"_json;
+    auto index = std::make_shared<const HashIndex>(items, parser.parse("id"));
+
+    SECTION("finds the added indexes by their array and key")
+    {
+        HashIndexRegistry::add(index);
+
+        REQUIRE_FALSE(HashIndexRegistry::isEmpty());
+        REQUIRE(HashIndexRegistry::find(items, parser.parse("id")) == index);
+        REQUIRE(HashIndexRegistry::find(items, parser.parse("name"))
+                == nullptr);
+        REQUIRE(HashIndexRegistry::find(Json::parse(items.dump()),
+                                        parser.parse("id")) == nullptr);
+
+        HashIndexRegistry::remove(index.get());
+    }
+
+    SECTION("doesn't find the invalid indexes")
+    {
+        HashIndexRegistry::add(index);
+        items.push_back(Json{{"id", 3}});
+
+        REQUIRE(HashIndexRegistry::find(items, parser.parse("id")) == nullptr);
+
+        HashIndexRegistry::remove(index.get());
+    }
+
+    SECTION("doesn't find the removed indexes")
+    {
+        HashIndexRegistry::add(index);
+        HashIndexRegistry::remove(index.get());
+
+        REQUIRE(HashIndexRegistry::isEmpty());
+        REQUIRE(HashIndexRegistry::find(items, parser.parse("id")) == nullptr);
+    }
+}
@@ -31,6 +31,7 @@
 #include "jmespath/exceptions.h"
 #include <fstream>
 #include <chrono>
+#include <limits>
 #include <boost/range/algorithm.hpp>
 
 //namespace jmespath { namespace ast {
@@ -486,6 +487,71 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == Json{});
     }
 
+    SECTION("evaluates array item expression with index out of the native "
+            "range to null")
+    {
+        ast::ArrayItemNode node{-Index{std::numeric_limits<size_t>::max()}};
+        interpreter.setContext(Json{"zero", "one", "two", "three", "four"});
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == Json{});
+    }
+
+    SECTION("evaluates path node with lvalue ref")
+    {
+        ast::PathNode node{{String{"a"}, std::int64_t{1}, String{"b"}}};
+        Json value = "{\"a\": [{\"b\": 1}, {\"b\": 2}]}"_json;
+        interpreter.setContext(value);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContextValue().which() == 1);
+        REQUIRE(interpreter.currentContext() == 2);
+    }
+
+    SECTION("evaluates path node with rvalue")
+    {
+        ast::PathNode node{{String{"a"}, std::int64_t{1}, String{"b"}}};
+        interpreter.setContext("{\"a\": [{\"b\": 1}, {\"b\": 2}]}"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContextValue().which() == 0);
+        REQUIRE(interpreter.currentContext() == 2);
+    }
+
+    SECTION("evaluates path node with negative index")
+    {
+        ast::PathNode node{{std::int64_t{-2}, std::int64_t{0}}};
+        interpreter.setContext("[[1], [2], [3]]"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == 2);
+    }
+
+    SECTION("evaluates path node to null if any of the steps is missing")
+    {
+        Json value = "{\"a\": [{\"b\": 1}, {\"b\": 2}]}"_json;
+        std::vector<ast::PathNode> nodes{
+            {{String{"x"}, String{"b"}}},
+            {{String{"a"}, String{"b"}}},
+            {{String{"a"}, std::int64_t{2}, String{"b"}}},
+            {{String{"a"}, std::int64_t{-3}, String{"b"}}},
+            {{String{"a"}, std::int64_t{0}, String{"c"}}},
+            {{String{"a"}, std::int64_t{0}, String{"b"}, String{"c"}}}};
+
+        for (const auto& node: nodes)
+        {
+            interpreter.setContext(value);
+
+            interpreter.visit(&node);
+
+            REQUIRE(interpreter.currentContext() == Json{});
+        }
+    }
+
     SECTION("evaluates projection on lvalue ref")
     {
         Json context = {{{"id", 1}}, {{"id", 2}}, {{"id2", 3}}, {{"id", 4}}};
@@ -597,6 +663,22 @@ TEST_CASE("Interpreter")
         interpreter.visit(&sliceNode);
 
         REQUIRE(interpreter.currentContext() == expectedResult);
+        REQUIRE(context == "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9]"_json);
+    }
+
+    SECTION("evaluates flatten operator on slice of lvalue ref without "
+            "modifying the context")
+    {
+        Json context = "[[0, 1], [2, 3], [4, 5]]"_json;
+        interpreter.setContext(context);
+        ast::SliceExpressionNode sliceNode{Index{1}};
+        ast::FlattenOperatorNode flattenNode;
+
+        interpreter.visit(&sliceNode);
+        interpreter.visit(&flattenNode);
+
+        REQUIRE(interpreter.currentContext() == "[2, 3, 4, 5]"_json);
+        REQUIRE(context == "[[0, 1], [2, 3], [4, 5]]"_json);
     }
 
     SECTION("evaluates slice expression on rvalue")
@@ -670,6 +752,20 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == context);
     }
 
+    SECTION("evaluates slice expression with indices out of the native range")
+    {
+        Json context = "[0, 1, 2, 3, 4, 5, 6, 7, 8, 9]"_json;
+        interpreter.setContext(context);
+        Index maxIndex{std::numeric_limits<size_t>::max()};
+        ast::SliceExpressionNode sliceNode{Index{maxIndex},
+                                           Index{-maxIndex},
+                                           Index{-maxIndex}};
+
+        interpreter.visit(&sliceNode);
+
+        REQUIRE(interpreter.currentContext() == "[9]"_json);
+    }
+
     SECTION("evaluates list wildcard expression on non array to null")
     {
         Json context = "string";
@@ -884,6 +980,55 @@ TEST_CASE("Interpreter")
                 == "{\"id1\":\"value2\",\"id3\":\"value4\"}"_json);
     }
 
+    SECTION("evaluates multiselect hash with duplicate keys by keeping the "
+            "last value")
+    {
+        interpreter.setContext("{\"id2\":\"value2\", \"id4\":\"value4\"}"_json);
+        ast::MultiselectHashNode node{
+                {ast::IdentifierNode{"id1"},
+                 ast::ExpressionNode{
+                    ast::IdentifierNode{"id2"}}},
+                {ast::IdentifierNode{"id1"},
+                 ast::ExpressionNode{
+                    ast::IdentifierNode{"id4"}}}};
+
+        interpreter.visit(&node);
+
+        REQUIRE_FALSE(node.uniqueKeys);
+        REQUIRE(interpreter.currentContext()
+                == "{\"id1\":\"value4\"}"_json);
+    }
+
+    SECTION("evaluates multiselect expressions without modifying the context "
+            "of lvalue sub-results")
+    {
+        Json context = "{\"id1\": [1, 2], \"id2\": {\"a\": 3}}"_json;
+        Json contextCopy = context;
+        interpreter.setContext(context);
+        ast::MultiselectListNode listNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id2"}}};
+        ast::MultiselectHashNode hashNode{
+                {ast::IdentifierNode{"id1"},
+                 ast::ExpressionNode{
+                    ast::IdentifierNode{"id1"}}},
+                {ast::IdentifierNode{"id2"},
+                 ast::ExpressionNode{
+                    ast::IdentifierNode{"id2"}}}};
+
+        interpreter.visit(&listNode);
+        Json listResult = interpreter.currentContext();
+        interpreter.setContext(context);
+        interpreter.visit(&hashNode);
+        Json hashResult = interpreter.currentContext();
+
+        REQUIRE(listResult == "[[1, 2], {\"a\": 3}]"_json);
+        REQUIRE(hashResult == context);
+        REQUIRE(context == contextCopy);
+    }
+
     SECTION("evaluates child expression of not expression")
     {
         ast::NotExpressionNode node;
@@ -1560,6 +1705,123 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == expectedResult);
     }
 
+    SECTION("evaluates profiled logic operators to the boolean value of "
+            "their results while they're sampled")
+    {
+        ast::AndExpressionNode andNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id2"}}};
+        andNode.profile = std::make_shared<
+                interpreter::LogicOperatorProfile>(2, 1);
+        ast::OrExpressionNode orNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id2"}}};
+        orNode.profile = std::make_shared<
+                interpreter::LogicOperatorProfile>(2, 1);
+        Json context = "{\"id1\": \"value1\", \"id2\": []}"_json;
+        interpreter.setContext(context);
+
+        interpreter.visit(&andNode);
+
+        REQUIRE(interpreter.currentContext() == false);
+
+        interpreter.setContext(context);
+        interpreter.visit(&orNode);
+
+        REQUIRE(interpreter.currentContext() == true);
+        REQUIRE(andNode.profile->sampleCount() == 1);
+        REQUIRE(orNode.profile->sampleCount() == 1);
+    }
+
+    SECTION("evaluates swapped logic operators to the boolean value of "
+            "their results")
+    {
+        auto swappedProfile = []() {
+            auto profile = std::make_shared<
+                    interpreter::LogicOperatorProfile>(
+                        0, std::numeric_limits<std::size_t>::max());
+            profile->addSample(std::chrono::nanoseconds{1000}, true,
+                               std::chrono::nanoseconds{10}, true);
+            profile->beginEvaluation();
+            return profile;
+        };
+        ast::AndExpressionNode andNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id2"}}};
+        andNode.profile = swappedProfile();
+        ast::OrExpressionNode orNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id2"}}};
+        orNode.profile = swappedProfile();
+        std::vector<Json> contexts = {
+            "{\"id1\": \"value1\", \"id2\": \"value2\"}"_json,
+            "{\"id1\": \"value1\", \"id2\": false}"_json,
+            "{\"id1\": null, \"id2\": \"value2\"}"_json,
+            "{\"id1\": null, \"id2\": []}"_json
+        };
+        std::vector<Json> andResults;
+        std::vector<Json> orResults;
+        for (const auto& context: contexts)
+        {
+            interpreter.setContext(context);
+            interpreter.visit(&andNode);
+            andResults.push_back(interpreter.currentContext());
+            interpreter.setContext(context);
+            interpreter.visit(&orNode);
+            orResults.push_back(interpreter.currentContext());
+        }
+
+        REQUIRE(andNode.profile->isSwapped());
+        REQUIRE(andNode.profile->sampleCount() == 1);
+        REQUIRE(andResults == std::vector<Json>{true, false, false, false});
+        REQUIRE(orResults == std::vector<Json>{true, true, true, false});
+    }
+
+    SECTION("raises the errors of the right side expression of profiled "
+            "logic operators only if the left side expression doesn't short "
+            "circuit them")
+    {
+        auto swappedProfile = std::make_shared<
+                interpreter::LogicOperatorProfile>(
+                    0, std::numeric_limits<std::size_t>::max());
+        swappedProfile->addSample(std::chrono::nanoseconds{1000}, true,
+                                  std::chrono::nanoseconds{10}, true);
+        swappedProfile->beginEvaluation();
+        ast::AndExpressionNode andNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id1"}},
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::SliceExpressionNode{Index{0}, Index{1},
+                                                 Index{0}}}}}};
+        ast::OrExpressionNode orNode{andNode.leftExpression,
+                                     andNode.rightExpression};
+        for (auto profile: {std::make_shared<
+                            interpreter::LogicOperatorProfile>(1, 1),
+                            swappedProfile})
+        {
+            andNode.profile = profile;
+            interpreter.setContext("[]"_json);
+            interpreter.visit(&andNode);
+
+            REQUIRE(interpreter.currentContext() == false);
+
+            orNode.profile = profile;
+            interpreter.setContext("[]"_json);
+
+            REQUIRE_THROWS_AS(interpreter.visit(&orNode), InvalidValue);
+        }
+    }
+
     SECTION("evaluates child expression of paren expression")
     {
         ast::ParenExpressionNode node;
@@ -1609,6 +1871,179 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == expectedResult);
     }
 
+    SECTION("evaluates pipe expression with array item selection without "
+            "evaluating the projection after the selected item")
+    {
+        ast::PipeExpressionNode node{
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::ExpressionNode{},
+                    ast::BracketSpecifierNode{
+                        ast::ListWildcardNode{}},
+                    ast::ExpressionNode{
+                        ast::FunctionExpressionNode{
+                            "abs",
+                            {ast::ExpressionNode{
+                                ast::CurrentNode{}}}}}}},
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::ArrayItemNode{1}}}}};
+        interpreter.setContext("[-1, -2, \"string\"]"_json);
+        Json expectedResult = 2;
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == expectedResult);
+    }
+
+    SECTION("evaluates pipe expression with array item selection on filter "
+            "projection")
+    {
+        ast::ExpressionNode filterExpression{
+            ast::IndexExpressionNode{
+                ast::ExpressionNode{},
+                ast::BracketSpecifierNode{
+                    ast::FilterExpressionNode{
+                        ast::ExpressionNode{
+                            ast::ComparatorExpressionNode{
+                                ast::ExpressionNode{
+                                    ast::IdentifierNode{"id"}},
+                                ast::ComparatorExpressionNode::Comparator
+                                    ::GreaterOrEqual,
+                                ast::ExpressionNode{
+                                    ast::LiteralNode{"2"}}}}}},
+                ast::ExpressionNode{
+                    ast::IdentifierNode{"id"}}}};
+        ast::PipeExpressionNode node1{
+            filterExpression,
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::ArrayItemNode{1}}}}};
+        ast::PipeExpressionNode node2{
+            filterExpression,
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::ArrayItemNode{5}}}}};
+        ast::PipeExpressionNode node3{
+            filterExpression,
+            ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::ArrayItemNode{-1}}}}};
+        Json context = "[{\"id\": 1}, {\"id\": 2}, {\"id\": 3}, {\"id\": 4}]"_json;
+
+        interpreter.setContext(context);
+        interpreter.visit(&node1);
+        auto result1 = interpreter.currentContext();
+        interpreter.setContext(context);
+        interpreter.visit(&node2);
+        auto result2 = interpreter.currentContext();
+        interpreter.setContext(context);
+        interpreter.visit(&node3);
+        auto result3 = interpreter.currentContext();
+
+        REQUIRE(result1 == Json(3));
+        REQUIRE(result2 == Json{});
+        REQUIRE(result3 == Json(4));
+    }
+
+    SECTION("evaluates array item selection on paren expression without "
+            "evaluating the projection after the selected item")
+    {
+        ast::IndexExpressionNode node{
+            ast::ExpressionNode{
+                ast::ParenExpressionNode{
+                    ast::ExpressionNode{
+                        ast::IndexExpressionNode{
+                            ast::ExpressionNode{},
+                            ast::BracketSpecifierNode{
+                                ast::FlattenOperatorNode{}},
+                            ast::ExpressionNode{
+                                ast::FunctionExpressionNode{
+                                    "abs",
+                                    {ast::ExpressionNode{
+                                        ast::CurrentNode{}}}}}}}}},
+            ast::BracketSpecifierNode{
+                ast::ArrayItemNode{2}}};
+        interpreter.setContext("[[-1, -2], -3, [\"string\"]]"_json);
+        Json expectedResult = 3;
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == expectedResult);
+    }
+
+    SECTION("evaluates length function on projection without materializing "
+            "the projection")
+    {
+        ast::FunctionExpressionNode node{
+            "length",
+            {ast::ExpressionNode{
+                ast::HashWildcardNode{
+                    ast::ExpressionNode{},
+                    ast::ExpressionNode{
+                        ast::IdentifierNode{"id"}}}}}};
+        interpreter.setContext(
+            "{\"a\": {\"id\": 1}, \"b\": {}, \"c\": {\"id\": 2}}"_json);
+        Json expectedResult = 2;
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == expectedResult);
+    }
+
+    SECTION("length function throws on projection of non array")
+    {
+        ast::FunctionExpressionNode node{
+            "length",
+            {ast::ExpressionNode{
+                ast::IndexExpressionNode{
+                    ast::BracketSpecifierNode{
+                        ast::ListWildcardNode{}}}}}};
+        interpreter.setContext("{}"_json);
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("evaluates contains function on projection without evaluating "
+            "the projection after the searched item")
+    {
+        ast::ExpressionNode projection{
+            ast::IndexExpressionNode{
+                ast::ExpressionNode{},
+                ast::BracketSpecifierNode{
+                    ast::ListWildcardNode{}},
+                ast::ExpressionNode{
+                    ast::FunctionExpressionNode{
+                        "abs",
+                        {ast::ExpressionNode{
+                            ast::CurrentNode{}}}}}}};
+        ast::FunctionExpressionNode node1{
+            "contains",
+            {projection,
+            ast::ExpressionNode{
+                ast::LiteralNode{"2"}}}};
+        ast::FunctionExpressionNode node2{
+            "contains",
+            {projection,
+            ast::ExpressionNode{
+                ast::LiteralNode{"3"}}}};
+
+        interpreter.setContext("[-1, -2, \"string\"]"_json);
+        interpreter.visit(&node1);
+        auto result1 = interpreter.currentContext();
+        interpreter.setContext("[-1, -2]"_json);
+        interpreter.visit(&node2);
+        auto result2 = interpreter.currentContext();
+
+        REQUIRE(result1 == "true"_json);
+        REQUIRE(result2 == "false"_json);
+    }
+
     SECTION("evaluates current node expression")
     {
         ast::CurrentNode node;
@@ -1724,6 +2159,47 @@ TEST_CASE("Interpreter")
 
     }
 
+    SECTION("evaluates filter expression on arrays with the filter's kernel")
+    {
+        interpreter.setContext("[{\"id\": 1}, {\"id\": 2}, {\"id\": 3}]"_json);
+        ast::FilterExpressionNode node;
+        node.kernel = std::make_shared<interpreter::FilterKernel>(
+            std::vector<interpreter::FilterKernel::Predicate>{
+                {{String{"id"}},
+                 ast::ComparatorExpressionNode::Comparator::NotEqual,
+                 2}});
+        Json expectedResult = "[{\"id\": 1}, {\"id\": 3}]"_json;
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == expectedResult);
+    }
+
+    SECTION("evaluates filter expression with the filter's subexpression if "
+            "the kernel doesn't support the items")
+    {
+        Json context = "[{\"id\": 18446744073709551615}, {\"id\": 2}]"_json;
+        interpreter.setContext(context);
+        ast::FilterExpressionNode node{
+            ast::ExpressionNode{
+                ast::ComparatorExpressionNode{
+                    ast::ExpressionNode{
+                        ast::IdentifierNode{"id"}},
+                    ast::ComparatorExpressionNode::Comparator::Less,
+                    ast::ExpressionNode{
+                        ast::LiteralNode{"3"}}}}};
+        node.kernel = std::make_shared<interpreter::FilterKernel>(
+            std::vector<interpreter::FilterKernel::Predicate>{
+                {{String{"id"}},
+                 ast::ComparatorExpressionNode::Comparator::Less,
+                 3}});
+        Json expectedResult = "[{\"id\": 2}]"_json;
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == expectedResult);
+    }
+
     SECTION("evaluates filter expression on arrays to an array filtered with "
             "the filter's subexpression 2 with lvalue ref")
     {
@@ -1771,6 +2247,41 @@ TEST_CASE("Interpreter")
         REQUIRE_THROWS_AS(interpreter.visit(&node), UnknownFunction);
     }
 
+    SECTION("evaluates function expression resolved during parsing")
+    {
+        ast::FunctionExpressionNode node{
+            "abs",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"-3"}}}};
+        Interpreter::resolveFunction(node);
+
+        interpreter.visit(&node);
+
+        REQUIRE(node.functionId.is_initialized());
+        REQUIRE(interpreter.currentContext() == 3);
+    }
+
+    SECTION("evaluates functions with proven argument types")
+    {
+        ast::FunctionExpressionNode sortNode{
+            "sort",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[3, 1, 2]"}}}};
+        ast::FunctionExpressionNode minNode{
+            "min",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[\"b\", \"a\"]"}}}};
+        Interpreter::resolveFunction(sortNode);
+        Interpreter::resolveFunction(minNode);
+        REQUIRE(sortNode.argumentTypesProven);
+        REQUIRE(minNode.argumentTypesProven);
+
+        interpreter.visit(&sortNode);
+        REQUIRE(interpreter.currentContext() == "[1, 2, 3]"_json);
+        interpreter.visit(&minNode);
+        REQUIRE(interpreter.currentContext() == "a");
+    }
+
     SECTION("abs function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node1{
@@ -2694,21 +3205,60 @@ TEST_CASE("Interpreter")
                 == "{\"id1\": 1, \"id2\":2, \"id3\": 3}"_json);
     }
 
-    SECTION("min function throws on invalid number of arguments")
-    {
-        ast::FunctionExpressionNode node1{
-            "min",
-            {ast::ExpressionNode{},
-            ast::ExpressionNode{}}};
-        ast::FunctionExpressionNode node2{"min"};
-
-        REQUIRE_THROWS_AS(interpreter.visit(&node1),
-                          InvalidFunctionArgumentArity);
-        REQUIRE_THROWS_AS(interpreter.visit(&node2),
-                          InvalidFunctionArgumentArity);
-    }
-
-    SECTION("min function throws on inavlid argument type")
+    SECTION("evaluates merge function without modifying the lvalue "
+            "arguments")
+    {
+        ast::FunctionExpressionNode node{
+            "merge",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"foo"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"bar"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"foo"}}}};
+        auto context = "{\"foo\": {\"id1\": 0, \"id2\": 2},"
+                       "\"bar\": {\"id1\": 1, \"id3\": 3}}"_json;
+        auto contextCopy = context;
+        interpreter.setContext(context);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext()
+                == "{\"id1\": 0, \"id2\":2, \"id3\": 3}"_json);
+        REQUIRE(interpreter.currentContext().size() == 3);
+        REQUIRE(context == contextCopy);
+        REQUIRE(context["foo"].size() == 2);
+    }
+
+    SECTION("evaluates merge function on a single object")
+    {
+        ast::FunctionExpressionNode node{
+            "merge",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"foo"}}}};
+        auto context = "{\"foo\": {\"id1\": 0, \"id2\": 2}}"_json;
+        interpreter.setContext(context);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == context["foo"]);
+    }
+
+    SECTION("min function throws on invalid number of arguments")
+    {
+        ast::FunctionExpressionNode node1{
+            "min",
+            {ast::ExpressionNode{},
+            ast::ExpressionNode{}}};
+        ast::FunctionExpressionNode node2{"min"};
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node1),
+                          InvalidFunctionArgumentArity);
+        REQUIRE_THROWS_AS(interpreter.visit(&node2),
+                          InvalidFunctionArgumentArity);
+    }
+
+    SECTION("min function throws on inavlid argument type")
     {
         ast::FunctionExpressionNode node{
             "min",
@@ -2971,6 +3521,28 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == "null"_json);
     }
 
+    SECTION("not_null doesn't evaluate the arguments after the first not null "
+            "value")
+    {
+        ast::FunctionExpressionNode node{
+            "not_null",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"a"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"b"}},
+            ast::ExpressionNode{
+                ast::FunctionExpressionNode{
+                    "abs",
+                    {ast::ExpressionNode{
+                        ast::IdentifierNode{"c"}}}}}}};
+        auto context = "{\"a\": null, \"b\": {\"id\": 1}, \"c\": \"string\"}"_json;
+        interpreter.setContext(std::move(context));
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "{\"id\": 1}"_json);
+    }
+
     SECTION("reverse function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node0{"reverse"};
@@ -3020,6 +3592,25 @@ TEST_CASE("Interpreter")
         interpreter.visit(&node);
 
         REQUIRE(interpreter.currentContext() == "[3, 2, 1]"_json);
+        REQUIRE(context == "{\"foo\": [1, 2, 3]}"_json);
+    }
+
+    SECTION("sorts the reversed view of an array without modifying the array")
+    {
+        ast::FunctionExpressionNode reverseNode{
+            "reverse",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"foo"}}}};
+        ast::FunctionExpressionNode node{
+            "sort",
+            {ast::ExpressionNode{reverseNode}}};
+        auto context = "{\"foo\": [2, 3, 1]}"_json;
+        interpreter.setContext(context);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "[1, 2, 3]"_json);
+        REQUIRE(context == "{\"foo\": [2, 3, 1]}"_json);
     }
 
     SECTION("evaluates reverse function on strings with rvalue")
@@ -3260,6 +3851,386 @@ TEST_CASE("Interpreter")
                    "{\"id\": 5}]"_json);
     }
 
+    SECTION("sort_by function keeps the order of equal keys")
+    {
+        ast::FunctionExpressionNode node{
+            "sort_by",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[{\"id\": 2, \"n\": 1}, {\"id\": 1.5},"
+                                 "{\"id\": 2, \"n\": 2}, {\"id\": 1}]"}},
+            ast::ExpressionArgumentNode{
+                ast::ExpressionNode{
+                    ast::IdentifierNode{"id"}}}}};
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext()
+                == "[{\"id\": 1}, {\"id\": 1.5}, {\"id\": 2, \"n\": 1},"
+                   "{\"id\": 2, \"n\": 2}]"_json);
+    }
+
+    SECTION("top_k functions throw on invalid argument types")
+    {
+        auto array = ast::ExpressionNode{
+            ast::LiteralNode{"[3, 1, 2]"}};
+        auto mixedArray = ast::ExpressionNode{
+            ast::LiteralNode{"[3, \"a\", 2]"}};
+        auto object = ast::ExpressionNode{
+            ast::LiteralNode{"{\"id\": 1}"}};
+        auto count = ast::ExpressionNode{
+            ast::LiteralNode{"2"}};
+        auto stringCount = ast::ExpressionNode{
+            ast::LiteralNode{"\"2\""}};
+
+        for (const auto& name: {"top_k", "bottom_k"})
+        {
+            ast::FunctionExpressionNode objectNode{name, {object, count}};
+            ast::FunctionExpressionNode mixedNode{name, {mixedArray, count}};
+            ast::FunctionExpressionNode countNode{name, {array, stringCount}};
+
+            REQUIRE_THROWS_AS(interpreter.visit(&objectNode),
+                              InvalidFunctionArgumentType);
+            REQUIRE_THROWS_AS(interpreter.visit(&mixedNode),
+                              InvalidFunctionArgumentType);
+            REQUIRE_THROWS_AS(interpreter.visit(&countNode),
+                              InvalidFunctionArgumentType);
+        }
+    }
+
+    SECTION("top_k functions throw on invalid item count")
+    {
+        auto array = ast::ExpressionNode{
+            ast::LiteralNode{"[3, 1, 2]"}};
+
+        for (const auto& count: {"-1", "1.5"})
+        {
+            ast::FunctionExpressionNode node{
+                "top_k",
+                {array, ast::ExpressionNode{ast::LiteralNode{count}}}};
+
+            REQUIRE_THROWS_AS(interpreter.visit(&node), InvalidValue);
+        }
+    }
+
+    SECTION("evaluates top_k and bottom_k functions")
+    {
+        auto array = ast::ExpressionNode{
+            ast::LiteralNode{"[3, 1, 4, 1, 5, 9, 2, 6]"}};
+        auto count = ast::ExpressionNode{
+            ast::LiteralNode{"3"}};
+        auto largeCount = ast::ExpressionNode{
+            ast::LiteralNode{"10.0"}};
+        ast::FunctionExpressionNode topNode{"top_k", {array, count}};
+        ast::FunctionExpressionNode bottomNode{"bottom_k", {array, count}};
+        ast::FunctionExpressionNode allNode{"top_k", {array, largeCount}};
+
+        interpreter.visit(&topNode);
+        REQUIRE(interpreter.currentContext() == "[9, 6, 5]"_json);
+        interpreter.visit(&bottomNode);
+        REQUIRE(interpreter.currentContext() == "[1, 1, 2]"_json);
+        interpreter.visit(&allNode);
+        REQUIRE(interpreter.currentContext()
+                == "[9, 6, 5, 4, 3, 2, 1, 1]"_json);
+    }
+
+    SECTION("evaluates top_k_by and bottom_k_by functions with lvalue ref")
+    {
+        auto array = ast::ExpressionNode{
+            ast::IdentifierNode{"foo"}};
+        auto key = ast::ExpressionArgumentNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id"}}};
+        auto count = ast::ExpressionNode{
+            ast::LiteralNode{"2"}};
+        ast::FunctionExpressionNode topNode{"top_k_by", {array, key, count}};
+        ast::FunctionExpressionNode bottomNode{"bottom_k_by",
+                                               {array, key, count}};
+        auto context = "{\"foo\": [{\"id\": 3}, {\"id\": 5, \"n\": 1},"
+                       "{\"id\": 1}, {\"id\": 5, \"n\": 2}]}"_json;
+        interpreter.setContext(context);
+
+        interpreter.visit(&topNode);
+        REQUIRE(interpreter.currentContext()
+                == "[{\"id\": 5, \"n\": 1}, {\"id\": 5, \"n\": 2}]"_json);
+        interpreter.setContext(context);
+        interpreter.visit(&bottomNode);
+        REQUIRE(interpreter.currentContext()
+                == "[{\"id\": 1}, {\"id\": 3}]"_json);
+        REQUIRE(context["foo"].size() == 4);
+    }
+
+    SECTION("top_k_by function throws on invalid expression result type")
+    {
+        ast::FunctionExpressionNode node{
+            "top_k_by",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[{\"id\": 3}, {\"id\": null}]"}},
+            ast::ExpressionArgumentNode{
+                ast::ExpressionNode{
+                    ast::IdentifierNode{"id"}}},
+            ast::ExpressionNode{
+                ast::LiteralNode{"1"}}}};
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("regex functions throw on invalid argument types")
+    {
+        auto string = ast::ExpressionNode{
+            ast::RawStringNode{"abc"}};
+        auto number = ast::ExpressionNode{
+            ast::LiteralNode{"1"}};
+
+        for (const auto& name: {"matches", "regex_extract"})
+        {
+            ast::FunctionExpressionNode subjectNode{name, {number, string}};
+            ast::FunctionExpressionNode patternNode{name, {string, number}};
+
+            REQUIRE_THROWS_AS(interpreter.visit(&subjectNode),
+                              InvalidFunctionArgumentType);
+            REQUIRE_THROWS_AS(interpreter.visit(&patternNode),
+                              InvalidFunctionArgumentType);
+        }
+        ast::FunctionExpressionNode replaceNode{
+            "regex_replace", {string, string, number}};
+        REQUIRE_THROWS_AS(interpreter.visit(&replaceNode),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("regex functions throw on invalid pattern")
+    {
+        ast::FunctionExpressionNode node{
+            "matches",
+            {ast::ExpressionNode{
+                ast::RawStringNode{"abc"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"pattern"}}}};
+        interpreter.setContext("{\"pattern\": \"a(\"}"_json);
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node), InvalidValue);
+    }
+
+    SECTION("evaluates matches function")
+    {
+        auto subject = ast::ExpressionNode{
+            ast::IdentifierNode{"message"}};
+        ast::FunctionExpressionNode matchingNode{
+            "matches",
+            {subject, ast::ExpressionNode{
+                ast::RawStringNode{"[0-9]+ms$"}}}};
+        ast::FunctionExpressionNode otherNode{
+            "matches",
+            {subject, ast::ExpressionNode{
+                ast::RawStringNode{"^error"}}}};
+        auto context = "{\"message\": \"done in 12ms\"}"_json;
+
+        interpreter.setContext(context);
+        interpreter.visit(&matchingNode);
+        REQUIRE(interpreter.currentContext() == true);
+        interpreter.setContext(context);
+        interpreter.visit(&otherNode);
+        REQUIRE(interpreter.currentContext() == false);
+    }
+
+    SECTION("evaluates regex_extract function")
+    {
+        auto subject = ast::ExpressionNode{
+            ast::RawStringNode{"GET /items/42 200"}};
+        ast::FunctionExpressionNode matchNode{
+            "regex_extract",
+            {subject, ast::ExpressionNode{
+                ast::RawStringNode{"[0-9]+"}}}};
+        ast::FunctionExpressionNode groupNode{
+            "regex_extract",
+            {subject, ast::ExpressionNode{
+                ast::RawStringNode{"/items/([0-9]+)"}}}};
+        ast::FunctionExpressionNode missingNode{
+            "regex_extract",
+            {subject, ast::ExpressionNode{
+                ast::RawStringNode{"POST"}}}};
+
+        interpreter.visit(&matchNode);
+        REQUIRE(interpreter.currentContext() == "\"42\""_json);
+        interpreter.visit(&groupNode);
+        REQUIRE(interpreter.currentContext() == "\"42\""_json);
+        interpreter.visit(&missingNode);
+        REQUIRE(interpreter.currentContext() == Json{});
+    }
+
+    SECTION("evaluates regex_replace function")
+    {
+        ast::FunctionExpressionNode node{
+            "regex_replace",
+            {ast::ExpressionNode{
+                ast::RawStringNode{"a1b22c333"}},
+            ast::ExpressionNode{
+                ast::RawStringNode{"([0-9]+)"}},
+            ast::ExpressionNode{
+                ast::RawStringNode{"<$1>"}}}};
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "\"a<1>b<22>c<333>\""_json);
+    }
+
+    SECTION("predicate functions throw on non array argument")
+    {
+        auto condition = ast::ExpressionArgumentNode{
+            ast::ExpressionNode{
+                ast::CurrentNode{}}};
+        auto object = ast::ExpressionNode{
+            ast::LiteralNode{"{\"id\": 1}"}};
+
+        for (const auto& name: {"any", "all", "count_if", "find_first"})
+        {
+            ast::FunctionExpressionNode node{name, {object, condition}};
+
+            REQUIRE_THROWS_AS(interpreter.visit(&node),
+                              InvalidFunctionArgumentType);
+        }
+    }
+
+    SECTION("predicate functions stop at the first decisive item")
+    {
+        auto array = ast::ExpressionNode{
+            ast::LiteralNode{"[{}, {\"id\": 1}, \"a\"]"}};
+        auto condition = ast::ExpressionArgumentNode{
+            ast::ExpressionNode{
+                ast::FunctionExpressionNode{
+                    "keys",
+                    {ast::ExpressionNode{
+                        ast::CurrentNode{}}}}}};
+        ast::FunctionExpressionNode anyNode{"any", {array, condition}};
+        ast::FunctionExpressionNode allNode{"all", {array, condition}};
+        ast::FunctionExpressionNode findNode{"find_first", {array, condition}};
+        ast::FunctionExpressionNode countNode{"count_if", {array, condition}};
+
+        interpreter.visit(&anyNode);
+        REQUIRE(interpreter.currentContext() == true);
+        interpreter.visit(&allNode);
+        REQUIRE(interpreter.currentContext() == false);
+        interpreter.visit(&findNode);
+        REQUIRE(interpreter.currentContext() == "{\"id\": 1}"_json);
+        REQUIRE_THROWS_AS(interpreter.visit(&countNode),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("evaluates predicate functions with lvalue ref")
+    {
+        auto array = ast::ExpressionNode{
+            ast::IdentifierNode{"foo"}};
+        auto condition = ast::ExpressionArgumentNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"id"}}};
+        auto context = "{\"foo\": [{\"id\": false}, {\"id\": 1},"
+                       "{\"id\": 2}]}"_json;
+        interpreter.setContext(context);
+        ast::FunctionExpressionNode anyNode{"any", {array, condition}};
+        ast::FunctionExpressionNode allNode{"all", {array, condition}};
+        ast::FunctionExpressionNode findNode{"find_first", {array, condition}};
+        ast::FunctionExpressionNode countNode{"count_if", {array, condition}};
+
+        interpreter.visit(&anyNode);
+        REQUIRE(interpreter.currentContext() == true);
+        interpreter.setContext(context);
+        interpreter.visit(&allNode);
+        REQUIRE(interpreter.currentContext() == false);
+        interpreter.setContext(context);
+        interpreter.visit(&findNode);
+        REQUIRE(interpreter.currentContext() == "{\"id\": 1}"_json);
+        interpreter.setContext(context);
+        interpreter.visit(&countNode);
+        REQUIRE(interpreter.currentContext() == 2);
+    }
+
+    SECTION("unique function throws on non array argument")
+    {
+        ast::FunctionExpressionNode node{
+            "unique",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"{\"id\": 1}"}}}};
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("evaluates unique function by keeping the first occurrence of "
+            "the items")
+    {
+        ast::FunctionExpressionNode node{
+            "unique",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[1, \"a\", 1.0, {\"a\": 1, \"b\": 2},"
+                                 "{\"b\": 2, \"a\": 1}, \"a\", [1]]"}}}};
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext()
+                == "[1, \"a\", {\"a\": 1, \"b\": 2}, [1]]"_json);
+    }
+
+    SECTION("group_by function throws on non string keys")
+    {
+        ast::FunctionExpressionNode node{
+            "group_by",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[{\"id\": 1}]"}},
+            ast::ExpressionArgumentNode{
+                ast::ExpressionNode{
+                    ast::IdentifierNode{"id"}}}}};
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node),
+                          InvalidFunctionArgumentType);
+    }
+
+    SECTION("evaluates group_by function with lvalue ref")
+    {
+        ast::FunctionExpressionNode node{
+            "group_by",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"foo"}},
+            ast::ExpressionArgumentNode{
+                ast::ExpressionNode{
+                    ast::IdentifierNode{"type"}}}}};
+        auto context = "{\"foo\": [{\"id\": 1, \"type\": \"b\"}, {\"id\": 2},"
+                       "{\"id\": 3, \"type\": \"a\"},"
+                       "{\"id\": 4, \"type\": \"b\"}]}"_json;
+        auto contextCopy = context;
+        interpreter.setContext(context);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext()
+                == "{\"b\": [{\"id\": 1, \"type\": \"b\"},"
+                   "{\"id\": 4, \"type\": \"b\"}],"
+                   "\"a\": [{\"id\": 3, \"type\": \"a\"}]}"_json);
+        REQUIRE(interpreter.currentContext().begin().key() == "b");
+        REQUIRE(context == contextCopy);
+    }
+
+    SECTION("evaluates count_by and index_by functions with rvalue")
+    {
+        auto array = ast::ExpressionNode{
+            ast::LiteralNode{"[{\"id\": 1, \"type\": \"b\"}, {\"id\": 2},"
+                             "{\"id\": 3, \"type\": \"a\"},"
+                             "{\"id\": 4, \"type\": \"b\"}]"}};
+        auto key = ast::ExpressionArgumentNode{
+            ast::ExpressionNode{
+                ast::IdentifierNode{"type"}}};
+        ast::FunctionExpressionNode countNode{"count_by", {array, key}};
+        ast::FunctionExpressionNode indexNode{"index_by", {array, key}};
+
+        interpreter.visit(&countNode);
+        Json counts = interpreter.currentContext();
+        interpreter.visit(&indexNode);
+        Json index = interpreter.currentContext();
+
+        REQUIRE(counts == "{\"b\": 2, \"a\": 1}"_json);
+        REQUIRE(index == "{\"b\": {\"id\": 4, \"type\": \"b\"},"
+                         "\"a\": {\"id\": 3, \"type\": \"a\"}}"_json);
+    }
+
     SECTION("starts_with function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node0{"starts_with"};
@@ -3381,6 +4352,44 @@ TEST_CASE("Interpreter")
         REQUIRE(interpreter.currentContext() == "-4"_json);
     }
 
+    SECTION("evaluates sum function of integers exactly")
+    {
+        ast::FunctionExpressionNode node{
+            "sum",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[9007199254740993, 1, -2]"}}}};
+        ast::FunctionExpressionNode overflowNode{
+            "sum",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[9223372036854775807, 1]"}}}};
+
+        interpreter.visit(&node);
+        REQUIRE(interpreter.currentContext().is_number_integer());
+        REQUIRE(interpreter.currentContext().get<std::int64_t>()
+                == 9007199254740992);
+        interpreter.visit(&overflowNode);
+        REQUIRE(interpreter.currentContext().is_number_float());
+        REQUIRE(interpreter.currentContext() == Json(9223372036854775808.0));
+    }
+
+    SECTION("max and min functions select the first extreme item")
+    {
+        ast::FunctionExpressionNode maxNode{
+            "max",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[1, 3.0, -2.5, 3, 0.5]"}}}};
+        ast::FunctionExpressionNode minNode{
+            "min",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[4, -7, 2, -7, 9]"}}}};
+
+        interpreter.visit(&maxNode);
+        REQUIRE(interpreter.currentContext().is_number_float());
+        REQUIRE(interpreter.currentContext() == "3"_json);
+        interpreter.visit(&minNode);
+        REQUIRE(interpreter.currentContext() == "-7"_json);
+    }
+
     SECTION("to_array function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node1{
@@ -3556,6 +4565,34 @@ TEST_CASE("Interpreter")
         REQUIRE(result4 == "\"{\\\"id1\\\":1,\\\"id2\\\":2}\""_json);
     }
 
+    SECTION("evaluates to_string function on floating point numbers to the "
+            "shortest representation")
+    {
+        ast::FunctionExpressionNode node1{
+            "to_string",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"0.1"}}}};
+        ast::FunctionExpressionNode node2{
+            "to_string",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"-2.50"}}}};
+        ast::FunctionExpressionNode node3{
+            "to_string",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"1e100"}}}};
+
+        interpreter.visit(&node1);
+        auto result1 = interpreter.currentContext();
+        interpreter.visit(&node2);
+        auto result2 = interpreter.currentContext();
+        interpreter.visit(&node3);
+        auto result3 = interpreter.currentContext();
+
+        REQUIRE(result1 == "\"0.1\""_json);
+        REQUIRE(result2 == "\"-2.5\""_json);
+        REQUIRE(result3 == "\"1e+100\""_json);
+    }
+
     SECTION("to_number function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node1{
@@ -3671,6 +4708,64 @@ TEST_CASE("Interpreter")
         REQUIRE(result3 == "null"_json);
     }
 
+    SECTION("evaluates to_number function on integer strings to integers")
+    {
+        ast::FunctionExpressionNode node1{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\"42\""}}}};
+        ast::FunctionExpressionNode node2{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\"-7\""}}}};
+        ast::FunctionExpressionNode node3{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\"4e2\""}}}};
+
+        interpreter.visit(&node1);
+        auto result1 = interpreter.currentContext();
+        interpreter.visit(&node2);
+        auto result2 = interpreter.currentContext();
+        interpreter.visit(&node3);
+        auto result3 = interpreter.currentContext();
+
+        REQUIRE(result1.is_number_integer());
+        REQUIRE(result1 == 42);
+        REQUIRE(result2.is_number_integer());
+        REQUIRE(result2 == -7);
+        REQUIRE(result3.is_number_float());
+        REQUIRE(result3 == 400.0);
+    }
+
+    SECTION("evaluates to_number function on strings which are not JSON "
+            "numbers to null")
+    {
+        ast::FunctionExpressionNode node1{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\" 1\""}}}};
+        ast::FunctionExpressionNode node2{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\"12abc\""}}}};
+        ast::FunctionExpressionNode node3{
+            "to_number",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"\"1e400\""}}}};
+
+        interpreter.visit(&node1);
+        auto result1 = interpreter.currentContext();
+        interpreter.visit(&node2);
+        auto result2 = interpreter.currentContext();
+        interpreter.visit(&node3);
+        auto result3 = interpreter.currentContext();
+
+        REQUIRE(result1 == "null"_json);
+        REQUIRE(result2 == "null"_json);
+        REQUIRE(result3 == "null"_json);
+    }
+
     SECTION("type function throws on invalid number of arguments")
     {
         ast::FunctionExpressionNode node1{
@@ -3805,4 +4900,162 @@ TEST_CASE("Interpreter")
 
         REQUIRE(interpreter.currentContext() == "\"test\""_json);
     }
+
+    SECTION("throws on undefined variable")
+    {
+        ast::VariableRefNode node{"x"};
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node), UndefinedVariable);
+    }
+
+    SECTION("evaluates let expression by binding the results of the "
+            "expressions to the variables")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"x"},
+              ast::ExpressionNode{
+                  ast::IdentifierNode{"foo"}}},
+             {ast::VariableRefNode{"y"},
+              ast::ExpressionNode{
+                  ast::LiteralNode{"[1, 2]"}}}},
+            ast::ExpressionNode{
+                ast::MultiselectListNode{
+                    {ast::ExpressionNode{
+                        ast::VariableRefNode{"x"}},
+                     ast::ExpressionNode{
+                        ast::VariableRefNode{"y"}},
+                     ast::ExpressionNode{
+                        ast::IdentifierNode{"bar"}}}}}};
+        auto context = "{\"foo\": \"a\", \"bar\": \"b\"}"_json;
+        interpreter.setContext(context);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "[\"a\", [1, 2], \"b\"]"_json);
+    }
+
+    SECTION("evaluates let expression to a value which can refer to the "
+            "released bound values")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"x"},
+              ast::ExpressionNode{
+                  ast::LiteralNode{"{\"foo\": [1, 2]}"}}}},
+            ast::ExpressionNode{
+                ast::SubexpressionNode{
+                    ast::ExpressionNode{
+                        ast::VariableRefNode{"x"}},
+                    ast::ExpressionNode{
+                        ast::IdentifierNode{"foo"}}}}};
+        interpreter.setContext("{}"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "[1, 2]"_json);
+        REQUIRE(boost::get<Json>(&interpreter.currentContextValue()));
+    }
+
+    SECTION("evaluates let expression with variables which shadow the "
+            "variables of the enclosing let expressions")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"x"},
+              ast::ExpressionNode{
+                  ast::LiteralNode{"1"}}}},
+            ast::ExpressionNode{
+                ast::MultiselectListNode{
+                    {ast::ExpressionNode{
+                        ast::LetExpressionNode{
+                            {{ast::VariableRefNode{"x"},
+                              ast::ExpressionNode{
+                                  ast::LiteralNode{"2"}}}},
+                            ast::ExpressionNode{
+                                ast::VariableRefNode{"x"}}}},
+                     ast::ExpressionNode{
+                        ast::VariableRefNode{"x"}}}}}};
+        interpreter.setContext("{}"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "[2, 1]"_json);
+    }
+
+    SECTION("evaluates the bound expressions of let expression in the "
+            "enclosing scope")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"x"},
+              ast::ExpressionNode{
+                  ast::LiteralNode{"1"}}},
+             {ast::VariableRefNode{"y"},
+              ast::ExpressionNode{
+                  ast::VariableRefNode{"x"}}}},
+            ast::ExpressionNode{
+                ast::VariableRefNode{"y"}}};
+        interpreter.setContext("{}"_json);
+
+        REQUIRE_THROWS_AS(interpreter.visit(&node), UndefinedVariable);
+    }
+
+    SECTION("releases the variables of let expression when the evaluation "
+            "fails")
+    {
+        ast::LetExpressionNode failingNode{
+            {{ast::VariableRefNode{"x"},
+              ast::ExpressionNode{
+                  ast::LiteralNode{"1"}}}},
+            ast::ExpressionNode{
+                ast::VariableRefNode{"y"}}};
+        ast::VariableRefNode node{"x"};
+        interpreter.setContext("{}"_json);
+
+        REQUIRE_THROWS_AS(interpreter.visit(&failingNode), UndefinedVariable);
+        REQUIRE_THROWS_AS(interpreter.visit(&node), UndefinedVariable);
+    }
+
+    SECTION("evaluates the deferred bindings of let expression only when "
+            "they are referenced")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"0"},
+              ast::ExpressionNode{
+                  ast::VariableRefNode{"undefined"}}}},
+            ast::ExpressionNode{
+                ast::LiteralNode{"1"}}};
+        node.deferred = true;
+        ast::LetExpressionNode referringNode = node;
+        referringNode.expression = ast::VariableRefNode{"0"};
+        interpreter.setContext("{}"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "1"_json);
+        REQUIRE_THROWS_AS(interpreter.visit(&referringNode),
+                          UndefinedVariable);
+    }
+
+    SECTION("evaluates the deferred bindings of let expression on the "
+            "context of the let expression")
+    {
+        ast::LetExpressionNode node{
+            {{ast::VariableRefNode{"0"},
+              ast::ExpressionNode{
+                  ast::IdentifierNode{"a"}}}},
+            ast::ExpressionNode{
+                ast::MultiselectListNode{
+                    {ast::ExpressionNode{
+                        ast::SubexpressionNode{
+                            ast::ExpressionNode{
+                                ast::IdentifierNode{"c"}},
+                            ast::ExpressionNode{
+                                ast::VariableRefNode{"0"}}}},
+                     ast::ExpressionNode{
+                        ast::VariableRefNode{"0"}}}}}};
+        node.deferred = true;
+        interpreter.setContext("{\"a\": 1, \"c\": {\"a\": 2}}"_json);
+
+        interpreter.visit(&node);
+
+        REQUIRE(interpreter.currentContext() == "[1, 1]"_json);
+    }
 }
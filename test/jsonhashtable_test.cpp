@@ -0,0 +1,86 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/jsonhashtable.h"
+#include <string>
+
+TEST_CASE("JsonHashTable")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+
+    SECTION("equal values have the same hash")
+    {
+        REQUIRE(hashJson(Json(1)) == hashJson(Json(1.0)));
+        REQUIRE(hashJson(Json(0.0)) == hashJson(Json(-0.0)));
+        REQUIRE(hashJson(Json::parse("{\"a\": 1, \"b\": [2]}"))
+                == hashJson(Json::parse("{\"b\": [2.0], \"a\": 1}")));
+        REQUIRE(hashJson(Json("1")) != hashJson(Json(1)));
+    }
+
+    SECTION("inserts distinct values in the order of insertion")
+    {
+        JsonHashTable table;
+
+        auto first = table.insert(Json("a"));
+        auto second = table.insert(Json(1));
+        auto duplicate = table.insert(Json(1.0));
+
+        REQUIRE(first == std::make_pair(std::size_t{0}, true));
+        REQUIRE(second == std::make_pair(std::size_t{1}, true));
+        REQUIRE(duplicate == std::make_pair(std::size_t{1}, false));
+        REQUIRE(table.size() == 2);
+        REQUIRE(Json(table.values()) == Json::parse("[\"a\", 1]"));
+    }
+
+    SECTION("grows beyond its initial size")
+    {
+        JsonHashTable table{2};
+
+        for (int i = 0; i < 1000; ++i)
+        {
+            table.insert(Json(std::to_string(i % 500)));
+        }
+
+        REQUIRE(table.size() == 500);
+        REQUIRE(table.insert(Json("499")).first == 499);
+        REQUIRE(table.values().back() == Json("499"));
+    }
+
+    SECTION("finds the position of equal values")
+    {
+        JsonHashTable table;
+        table.insert(Json("a"));
+        table.insert(Json(1));
+
+        REQUIRE(table.find(Json(1.0)) == std::make_pair(std::size_t{1}, true));
+        REQUIRE(table.find(Json("a")).first == 0);
+        REQUIRE_FALSE(table.find(Json("b")).second);
+        REQUIRE(table.size() == 2);
+    }
+}
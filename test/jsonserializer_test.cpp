@@ -0,0 +1,83 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/jsonserializer.h"
+#include "jmespath/exceptions.h"
+
+TEST_CASE("JSON serializer")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+
+    auto serialize = [](const Json& value) {
+        String result;
+        appendJson(result, value);
+        return result;
+    };
+
+    SECTION("serializes values like Json::dump")
+    {
+        const auto values = Json::parse(
+            "[null, true, false, 0, -12, 3.25, \"\", \"abc\", [], {}, "
+            "[1, [2, [3]], {\"a\": null}], "
+            "{\"id\": 1, \"name\": \"item\", \"tags\": [\"x\", \"y\"], "
+            "\"nested\": {\"price\": 1.5}}]");
+
+        REQUIRE(serialize(values) == values.dump());
+        for (const auto& value: values)
+        {
+            REQUIRE(serialize(value) == value.dump());
+        }
+    }
+
+    SECTION("escapes strings like Json::dump")
+    {
+        const Json value("quote\" backslash\\ slash/ \b\f\n\r\t "
+                         "\x01\x1f\x7f \xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80");
+
+        REQUIRE(serialize(value) == value.dump());
+    }
+
+    SECTION("appends to the output")
+    {
+        String output{"result: "};
+
+        appendJson(output, Json::parse("{\"a\": [1, \"b\"]}"));
+
+        REQUIRE(output == "result: {\"a\":[1,\"b\"]}");
+    }
+
+    SECTION("throws on invalid UTF-8")
+    {
+        REQUIRE_THROWS_AS(serialize(Json("\xc3")), InvalidValue);
+        REQUIRE_THROWS_AS(serialize(Json("\xc0\xaf")), InvalidValue);
+        REQUIRE_THROWS_AS(serialize(Json("\xed\xa0\x80")), InvalidValue);
+        REQUIRE_THROWS_AS(serialize(Json("\xf4\x90\x80\x80")), InvalidValue);
+        REQUIRE_THROWS_AS(serialize(Json("a\x80")), InvalidValue);
+    }
+}
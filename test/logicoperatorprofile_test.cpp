@@ -0,0 +1,111 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/logicoperatorprofile.h"
+
+TEST_CASE("LogicOperatorProfile")
+{
+    using namespace jmespath::interpreter;
+    using std::chrono::nanoseconds;
+
+    SECTION("evaluates the operands in their written order by default")
+    {
+        LogicOperatorProfile profile;
+
+        REQUIRE_FALSE(profile.isSwapped());
+        REQUIRE(profile.sampleCount() == 0);
+    }
+
+    SECTION("samples the warm up evaluations and then every n-th")
+    {
+        LogicOperatorProfile profile{3, 4};
+        std::vector<bool> sampled;
+        for (int i = 0; i < 12; ++i)
+        {
+            sampled.push_back(profile.beginEvaluation());
+        }
+
+        REQUIRE(sampled == std::vector<bool>{true, true, true,
+                                             true, false, false, false,
+                                             true, false, false, false,
+                                             true});
+    }
+
+    SECTION("swaps the operands if the right one is cheaper")
+    {
+        LogicOperatorProfile profile{2, 1};
+        profile.addSample(nanoseconds{1000}, true, nanoseconds{10}, true);
+
+        REQUIRE_FALSE(profile.isSwapped());
+
+        profile.addSample(nanoseconds{1000}, true, nanoseconds{10}, true);
+
+        REQUIRE(profile.isSwapped());
+        REQUIRE(profile.sampleCount() == 2);
+    }
+
+    SECTION("swaps the operands if the right one short circuits more often")
+    {
+        LogicOperatorProfile profile{4, 1};
+        for (int i = 0; i < 4; ++i)
+        {
+            profile.addSample(nanoseconds{100}, false, nanoseconds{100},
+                              i != 0);
+        }
+
+        REQUIRE(profile.isSwapped());
+    }
+
+    SECTION("keeps the written order if it's cheaper")
+    {
+        LogicOperatorProfile profile{4, 1};
+        for (int i = 0; i < 4; ++i)
+        {
+            profile.addSample(nanoseconds{10}, true, nanoseconds{1000},
+                              false);
+        }
+
+        REQUIRE_FALSE(profile.isSwapped());
+    }
+
+    SECTION("doesn't change the order for similar costs")
+    {
+        LogicOperatorProfile profile{1, 1};
+        profile.addSample(nanoseconds{1000}, true, nanoseconds{10}, true);
+
+        REQUIRE(profile.isSwapped());
+
+        profile.addSample(nanoseconds{100}, true, nanoseconds{1200}, true);
+
+        REQUIRE(profile.isSwapped());
+
+        profile.addSample(nanoseconds{10}, true, nanoseconds{1000}, true);
+
+        REQUIRE_FALSE(profile.isSwapped());
+    }
+}
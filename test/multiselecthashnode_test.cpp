@@ -91,6 +91,26 @@ TEST_CASE("MultiselectHashNode")
         REQUIRE(node1 == node1);
     }
 
+    SECTION("checks whether the keys are unique")
+    {
+        MultiselectHashNode::KeyValuePairType pair1{
+            IdentifierNode{"id1"},
+            ExpressionNode{}};
+        MultiselectHashNode::KeyValuePairType pair2{
+            IdentifierNode{"id2"},
+            ExpressionNode{}};
+        MultiselectHashNode uniqueNode{pair1, pair2};
+        MultiselectHashNode duplicateNode{pair1, pair2, pair1};
+
+        REQUIRE(uniqueNode.uniqueKeys);
+        REQUIRE_FALSE(duplicateNode.uniqueKeys);
+
+        duplicateNode.expressions.pop_back();
+        duplicateNode.updateUniqueKeys();
+
+        REQUIRE(duplicateNode.uniqueKeys);
+    }
+
     SECTION("accepts visitor")
     {
         MultiselectHashNode node;
@@ -0,0 +1,105 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/nodepatterns.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("NodePatterns")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    ExpressionFormatter formatter;
+
+    SECTION("matches the type of the stored node")
+    {
+        ast::ExpressionNode expression = parser.parse("a.b");
+        const ast::ExpressionNode& constExpression = expression;
+
+        REQUIRE(match<ast::SubexpressionNode>(expression) != nullptr);
+        REQUIRE(match<ast::SubexpressionNode>(constExpression) != nullptr);
+        REQUIRE(match<ast::IdentifierNode>(expression) == nullptr);
+        REQUIRE(matchesAny<ast::IdentifierNode,
+                           ast::SubexpressionNode>(expression));
+        REQUIRE_FALSE(matchesAny<ast::IdentifierNode,
+                                 ast::CurrentNode>(expression));
+        REQUIRE_FALSE(matchesAny<>(expression));
+    }
+
+    SECTION("visits the children of nodes in the order of their evaluation")
+    {
+        std::vector<std::pair<String, std::vector<String>>> cases {
+            {"a.b", {"a", "b"}},
+            {"a[?b].c", {"a", "b", ".c"}},
+            {"a[0]", {"a"}},
+            {"!a", {"a"}},
+            {"(a)", {"a"}},
+            {"[a, b]", {"a", "b"}},
+            {"{x: a, y: b}", {"a", "b"}},
+            {"sort_by(a, &b)", {"a", "b"}},
+            {"let $x = a, $y = b in c", {"a", "b", "c"}},
+            {"a", {}},
+            {"`1`", {}}};
+        for (const auto& testCase: cases)
+        {
+            ast::ExpressionNode expression = parser.parse(testCase.first);
+            std::vector<String> children;
+
+            forEachChild(expression, [&](ast::ExpressionNode& child) {
+                children.push_back(formatter.format(child));
+            });
+
+            REQUIRE(children == testCase.second);
+        }
+    }
+
+    SECTION("transforms the children of nodes before the nodes")
+    {
+        ast::ExpressionNode expression = parser.parse("[a.b, !c]");
+        std::vector<String> nodes;
+
+        transformBottomUp(expression, [&](ast::ExpressionNode& node) {
+            nodes.push_back(formatter.format(node));
+            if (match<ast::IdentifierNode>(node))
+            {
+                node = ast::CurrentNode{};
+            }
+        });
+
+        REQUIRE(nodes == (std::vector<String>{
+                    "a", "b", "@.@", "c", "!@", "[@.@, !@]"}));
+        REQUIRE(formatter.format(expression) == "[@.@, !@]");
+    }
+}
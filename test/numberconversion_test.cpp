@@ -0,0 +1,142 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/numberconversion.h"
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+TEST_CASE("Number conversion")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+
+    SECTION("formats numbers like Json::dump")
+    {
+        const auto values = Json::parse(
+            "[0, 7, 42, 100, 12345, -1, -99, -100, 18446744073709551615, "
+            "-9223372036854775808, 0.0, -0.0, 1.0, 0.1, 2.5, -3.75, 1e100, "
+            "1.7976931348623157e308, 5e-324, 123456.789, 0.30000000000000004]");
+
+        for (const auto& value: values)
+        {
+            REQUIRE(formatNumber(value) == value.dump());
+        }
+    }
+
+    SECTION("formats non finite floating point numbers as null")
+    {
+        REQUIRE(formatNumber(std::numeric_limits<double>::infinity())
+                == "null");
+        REQUIRE(formatNumber(std::numeric_limits<double>::quiet_NaN())
+                == "null");
+    }
+
+    SECTION("appends numbers to the output")
+    {
+        String output{"["};
+
+        appendNumber(output, Json(12));
+        appendNumber(output, Json(0.5));
+
+        REQUIRE(output == "[120.5");
+    }
+
+    SECTION("parses integers as integers")
+    {
+        Json result;
+
+        REQUIRE(parseNumber("42", result));
+        REQUIRE(result.is_number_unsigned());
+        REQUIRE(result == 42);
+        REQUIRE(parseNumber("-42", result));
+        REQUIRE(result.is_number_integer());
+        REQUIRE(result == -42);
+        REQUIRE(parseNumber("18446744073709551615", result));
+        REQUIRE(result.get<std::uint64_t>()
+                == std::numeric_limits<std::uint64_t>::max());
+        REQUIRE(parseNumber("-9223372036854775808", result));
+        REQUIRE(result.get<std::int64_t>()
+                == std::numeric_limits<std::int64_t>::min());
+    }
+
+    SECTION("parses integers out of the 64 bit range as floating point")
+    {
+        Json result;
+
+        REQUIRE(parseNumber("18446744073709551616", result));
+        REQUIRE(result.is_number_float());
+        REQUIRE(result == 18446744073709551616.0);
+        REQUIRE(parseNumber("-9223372036854775809", result));
+        REQUIRE(result.is_number_float());
+        REQUIRE(result == -9223372036854775809.0);
+    }
+
+    SECTION("parses floating point numbers")
+    {
+        const std::vector<String> texts {
+            "0.0", "-0.0", "1.5", "-2.7", "0.1", "0.001", "1e3", "1E+3",
+            "2.5e-3", "123456.789", "0.30000000000000004",
+            "1.7976931348623157e308", "2.2250738585072014e-308",
+            "3.141592653589793238462643383279", "1e-22", "1e22", "9e23"
+        };
+
+        for (const auto& text: texts)
+        {
+            Json result;
+
+            REQUIRE(parseNumber(text, result));
+            REQUIRE(result.is_number_float());
+            REQUIRE(result.get<double>() == std::strtod(text.c_str(), nullptr));
+        }
+    }
+
+    SECTION("rejects invalid numbers")
+    {
+        const std::vector<String> texts {
+            "", "-", "abc", "1a", " 1", "1 ", "+1", "01", "1.", ".5", "1e",
+            "1e+", "0x10", "inf", "nan", "1..2", "--1"
+        };
+
+        for (const auto& text: texts)
+        {
+            Json result("unchanged");
+
+            REQUIRE_FALSE(parseNumber(text, result));
+            REQUIRE(result == "unchanged");
+        }
+    }
+
+    SECTION("rejects numbers out of the range of double")
+    {
+        Json result;
+
+        REQUIRE_FALSE(parseNumber("1e400", result));
+        REQUIRE_FALSE(parseNumber("-1e400", result));
+    }
+}
@@ -0,0 +1,104 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/numericarray.h"
+
+TEST_CASE("NumericArray")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using Type = NumericArray::Type;
+
+    SECTION("classifies the items of the array")
+    {
+        REQUIRE(NumericArray{Json::parse("[]")}.type() == Type::Integer);
+        REQUIRE(NumericArray{Json::parse("[1, -2]")}.type() == Type::Integer);
+        REQUIRE(NumericArray{Json::parse("[1.5, 2.0]")}.type() == Type::Float);
+        REQUIRE(NumericArray{Json::parse("[1, 2.0]")}.type() == Type::Mixed);
+        REQUIRE(NumericArray{Json::parse("[18446744073709551615]")}.type()
+                == Type::Mixed);
+        REQUIRE(NumericArray{Json::parse("[1, \"2\"]")}.type()
+                == Type::NotNumeric);
+        REQUIRE_FALSE(NumericArray{Json::parse("[null]")}.isNumeric());
+    }
+
+    SECTION("sums integers exactly")
+    {
+        NumericArray numbers{Json::parse(
+            "[9223372036854775807, -9223372036854775807, 9007199254740993]")};
+
+        REQUIRE(numbers.size() == 3);
+        REQUIRE(numbers.sum().is_number_integer());
+        REQUIRE(numbers.sum().get<std::int64_t>() == 9007199254740993);
+    }
+
+    SECTION("sums as floating point numbers on overflow")
+    {
+        NumericArray positive{Json::parse(
+            "[9223372036854775807, 9223372036854775807]")};
+        NumericArray negative{Json::parse(
+            "[-9223372036854775807, -9223372036854775807, -2]")};
+
+        REQUIRE(positive.sum().is_number_float());
+        REQUIRE(positive.sum().get<double>() == 18446744073709551614.0);
+        REQUIRE(negative.sum().is_number_float());
+        REQUIRE(negative.sum().get<double>() == -18446744073709551616.0);
+    }
+
+    SECTION("sums floating point numbers in the order of the items")
+    {
+        NumericArray numbers{Json::parse("[0.1, 0.2, 0.3, 1]")};
+
+        REQUIRE(numbers.sum().get<double>() == ((0.1 + 0.2) + 0.3) + 1);
+        REQUIRE(numbers.average() == (((0.1 + 0.2) + 0.3) + 1) / 4);
+    }
+
+    SECTION("finds the first smallest and largest items")
+    {
+        NumericArray integers{Json::parse("[3, 1, 4, 1, 5, 9, 2, 9]")};
+        NumericArray floats{Json::parse("[2.5, -0.5, 2.5, -0.5]")};
+
+        REQUIRE(integers.extremeIndices() == std::make_pair(std::size_t{1},
+                                                            std::size_t{5}));
+        REQUIRE(floats.extremeIndices() == std::make_pair(std::size_t{1},
+                                                          std::size_t{0}));
+    }
+
+    SECTION("sorts the items by their values")
+    {
+        auto integers = Json::parse("[3, -1, 4, 1, -5, 9]");
+        auto floats = Json::parse("[2.5, -0.5, 1e3, 0.25]");
+
+        NumericArray{integers}.sort(integers);
+        NumericArray{floats}.sort(floats);
+
+        REQUIRE(integers == Json::parse("[-5, -1, 1, 3, 4, 9]"));
+        REQUIRE(floats == Json::parse("[-0.5, 0.25, 2.5, 1e3]"));
+        REQUIRE(floats[3].is_number_float());
+    }
+}
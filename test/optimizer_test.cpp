@@ -0,0 +1,145 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/optimizer.h"
+#include "src/optimizer/commonsubexpressioneliminator.h"
+#include "src/optimizer/pathfuser.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+namespace {
+
+class RecordingPass : public jmespath::optimizer::AbstractPass
+{
+public:
+    RecordingPass(const char* name, std::vector<jmespath::String>& runs)
+        : m_name(name),
+          m_runs(runs)
+    {
+    }
+
+    const char* name() const override
+    {
+        return m_name;
+    }
+
+    void run(jmespath::ast::ExpressionNode&) override
+    {
+        m_runs.push_back(m_name);
+    }
+
+private:
+    const char* m_name;
+    std::vector<jmespath::String>& m_runs;
+};
+} // anonymous namespace
+
+TEST_CASE("Optimizer")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+
+    SECTION("runs the passes in their order")
+    {
+        std::vector<String> runs;
+        std::vector<Optimizer::PassPtr> passes;
+        passes.push_back(std::make_unique<RecordingPass>("first", runs));
+        passes.push_back(std::make_unique<RecordingPass>("second", runs));
+        Optimizer optimizer{std::move(passes)};
+        ast::ExpressionNode expression = parser.parse("a");
+
+        optimizer.optimize(expression);
+
+        REQUIRE(runs == (std::vector<String>{"first", "second"}));
+        REQUIRE(optimizer.passes().size() == 2);
+    }
+
+    SECTION("has default passes with unique names")
+    {
+        Optimizer optimizer;
+        std::vector<String> names;
+        for (const auto& pass: optimizer.passes())
+        {
+            names.push_back(pass->name());
+        }
+
+        REQUIRE(names == (std::vector<String>{
+                    "pipe-simplification",
+                    "parenthesis-elimination",
+                    "double-negation-elimination",
+                    "constant-folding",
+                    "filter-kernel-compilation",
+                    "common-subexpression-elimination",
+                    "path-fusion"}));
+    }
+
+    SECTION("finds passes by their type")
+    {
+        std::vector<Optimizer::PassPtr> passes;
+        passes.push_back(std::make_unique<PathFuser>());
+        Optimizer optimizer{std::move(passes)};
+
+        REQUIRE(optimizer.findPass<PathFuser>()
+                == optimizer.passes().front().get());
+        REQUIRE(optimizer.findPass<CommonSubexpressionEliminator>()
+                == nullptr);
+    }
+
+    SECTION("simplifies expressions before sharing their subexpressions")
+    {
+        Optimizer optimizer;
+        ast::ExpressionNode expression
+                = parser.parse("[(a.b).c | @, a.b.d, a[?!!(a.b)]]");
+
+        optimizer.optimize(expression);
+
+        REQUIRE(ExpressionFormatter{}.format(expression)
+                == "let $0 = a.b in [$0.c, $0.d, a[?a.b]]");
+        REQUIRE(optimizer.findPass<CommonSubexpressionEliminator>()
+                ->sharedSubexpressions()
+                == (std::vector<SharedSubexpression>{{"a.b", 2}}));
+    }
+
+    SECTION("can be disabled")
+    {
+        REQUIRE(Optimizer::isEnabled());
+
+        Optimizer::setEnabled(false);
+        REQUIRE_FALSE(Optimizer::isEnabled());
+
+        Optimizer::setEnabled(true);
+        REQUIRE(Optimizer::isEnabled());
+    }
+}
@@ -0,0 +1,78 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/parenthesiseliminator.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("ParenthesisEliminator")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    ParenthesisEliminator eliminator;
+    auto eliminate = [&](const String& text) {
+        ast::ExpressionNode expression = parser.parse(text);
+        eliminator.run(expression);
+        return ExpressionFormatter{}.format(expression);
+    };
+
+    SECTION("has a name")
+    {
+        REQUIRE(String{eliminator.name()} == "parenthesis-elimination");
+    }
+
+    SECTION("removes the parentheses around simple expressions")
+    {
+        REQUIRE(eliminate("(a)") == "a");
+        REQUIRE(eliminate("((a)).b") == "a.b");
+        REQUIRE(eliminate("(`1`) == ('a')") == "`1` == 'a'");
+        REQUIRE(eliminate("(@)") == "@");
+        REQUIRE(eliminate("(a.b[0]).c") == "a.b[0].c");
+        REQUIRE(eliminate("(a[0])[1]") == "a[0][1]");
+        REQUIRE(eliminate("([a, b]).c") == "[a, b].c");
+        REQUIRE(eliminate("length((a))") == "length(a)");
+        REQUIRE(eliminate("let $a = b in ($a)") == "let $a = b in $a");
+    }
+
+    SECTION("keeps the parentheses around projections and operators")
+    {
+        REQUIRE(eliminate("(a[*].b)[0]") == "(a[*].b)[0]");
+        REQUIRE(eliminate("((a[*].b))[0]") == "(a[*].b)[0]");
+        REQUIRE(eliminate("(a[*].b).c") == "(a[*].b).c");
+        REQUIRE(eliminate("(a[1:2]).c") == "(a[1:2]).c");
+        REQUIRE(eliminate("(a || b).c") == "(a || b).c");
+        REQUIRE(eliminate("!(a == b)") == "!(a == b)");
+    }
+}
@@ -0,0 +1,117 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/pathfuser.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("PathFuser")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+    using Segments = std::vector<ast::PathNode::SegmentType>;
+
+    Parser<Grammar> parser;
+    PathFuser fuser;
+    ast::ExpressionNode expression;
+    auto fuse = [&](const String& text) {
+        expression = parser.parse(text);
+        return fuser.fuse(expression);
+    };
+    auto format = [&]() {
+        return ExpressionFormatter{}.format(expression);
+    };
+
+    SECTION("fuses chains of identifiers and array items")
+    {
+        REQUIRE(fuse("spec.containers[0].image") == 1);
+        REQUIRE(expression == ast::ExpressionNode{
+                    ast::PathNode{Segments{String{"spec"},
+                                           String{"containers"},
+                                           std::int64_t{0},
+                                           String{"image"}}}});
+        REQUIRE(format() == "spec.containers[0].image");
+    }
+
+    SECTION("fuses chains starting with an array item")
+    {
+        REQUIRE(fuse("[-1][0]") == 1);
+        REQUIRE(expression == ast::ExpressionNode{
+                    ast::PathNode{Segments{std::int64_t{-1},
+                                           std::int64_t{0}}}});
+    }
+
+    SECTION("doesn't fuse single steps")
+    {
+        REQUIRE(fuse("a") == 0);
+        REQUIRE(fuse("[0]") == 0);
+        REQUIRE(boost::get<ast::IndexExpressionNode>(&expression.value));
+    }
+
+    SECTION("clamps the indices out of the native range")
+    {
+        const auto limit = std::numeric_limits<std::int64_t>::max() / 4;
+
+        REQUIRE(fuse("a[18446744073709551615][-18446744073709551615]") == 1);
+        const auto* pathNode = boost::get<ast::PathNode>(&expression.value);
+        REQUIRE(pathNode != nullptr);
+        REQUIRE(boost::get<std::int64_t>(pathNode->segments[1]) == limit);
+        REQUIRE(boost::get<std::int64_t>(pathNode->segments[2]) == -limit);
+    }
+
+    SECTION("fuses the chains in the children of other nodes")
+    {
+        REQUIRE(fuse("a.b[*].c.d") == 2);
+        REQUIRE(format() == "a.b[*].c.d");
+        const auto* indexNode = boost::get<ast::IndexExpressionNode>(
+                    &expression.value);
+        REQUIRE(indexNode != nullptr);
+        REQUIRE(boost::get<ast::PathNode>(&indexNode->leftExpression.value));
+        REQUIRE(boost::get<ast::PathNode>(
+                    &indexNode->rightExpression.value));
+
+        REQUIRE(fuse("{x: a.b, y: [c.d, !e.f]}") == 3);
+        REQUIRE(fuse("items[?a.b == c[0]] | sort_by(@, &x.y)") == 3);
+        REQUIRE(fuse("let $v = a.b in $v.c") == 1);
+    }
+
+    SECTION("doesn't fuse projections and other expressions")
+    {
+        REQUIRE(fuse("a[*].b") == 0);
+        REQUIRE(fuse("a[].b") == 0);
+        REQUIRE(fuse("a.*.b") == 0);
+        REQUIRE(fuse("a[1:2].b") == 0);
+        REQUIRE(fuse("(a).b") == 0);
+        REQUIRE(fuse("a.b(@)") == 0);
+    }
+}
@@ -0,0 +1,75 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/optimizer/pipesimplifier.h"
+#include "src/interpreter/expressionformatter.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("PipeSimplifier")
+{
+    using namespace jmespath;
+    using namespace jmespath::optimizer;
+    using jmespath::interpreter::ExpressionFormatter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+
+    Parser<Grammar> parser;
+    PipeSimplifier simplifier;
+    auto simplify = [&](const String& text) {
+        ast::ExpressionNode expression = parser.parse(text);
+        simplifier.run(expression);
+        return ExpressionFormatter{}.format(expression);
+    };
+
+    SECTION("has a name")
+    {
+        REQUIRE(String{simplifier.name()} == "pipe-simplification");
+    }
+
+    SECTION("removes the current node from either side of pipes")
+    {
+        REQUIRE(simplify("a | @") == "a");
+        REQUIRE(simplify("@ | a") == "a");
+        REQUIRE(simplify("@ | @ | a | @ | b") == "a | b");
+        REQUIRE(simplify("[a | @, {b: @ | c}]") == "[a, {b: c}]");
+    }
+
+    SECTION("keeps the projections stopped")
+    {
+        REQUIRE(simplify("a[*] | @ | [0]") == "a[*] | [0]");
+        REQUIRE(simplify("(a[*].b | @)[0]") == "(a[*].b)[0]");
+    }
+
+    SECTION("doesn't change pipes without current nodes")
+    {
+        REQUIRE(simplify("a | b") == "a | b");
+        REQUIRE(simplify("@") == "@");
+    }
+}
@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/regexcache.h"
+#include "jmespath/exceptions.h"
+
+TEST_CASE("RegexCache")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+
+    SECTION("compiles valid patterns")
+    {
+        RegexPtr regex = compileRegex("b+");
+
+        REQUIRE(std::regex_search("abbc", *regex));
+        REQUIRE_THROWS_AS(compileRegex("[a"), InvalidValue);
+    }
+
+    SECTION("returns the same expression for the same pattern")
+    {
+        RegexCache cache;
+
+        RegexPtr first = cache.get("a+");
+        RegexPtr second = cache.get("a+");
+
+        REQUIRE(first == second);
+        REQUIRE(cache.size() == 1);
+    }
+
+    SECTION("evicts the least recently used expression")
+    {
+        RegexCache cache{2};
+
+        RegexPtr a = cache.get("a");
+        RegexPtr b = cache.get("b");
+        cache.get("a");
+        cache.get("c");
+
+        REQUIRE(cache.size() == 2);
+        REQUIRE(cache.get("a") == a);
+        REQUIRE(cache.get("b") != b);
+    }
+
+    SECTION("doesn't store invalid patterns")
+    {
+        RegexCache cache;
+
+        REQUIRE_THROWS_AS(cache.get("(a"), InvalidValue);
+        REQUIRE(cache.size() == 0);
+    }
+}
@@ -0,0 +1,139 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/parser/resolvefunctionaction.h"
+#include "src/ast/allnodes.h"
+#include "jmespath/exceptions.h"
+
+TEST_CASE("ResolveFunctionAction")
+{
+    using namespace jmespath;
+    using namespace jmespath::parser;
+    using namespace fakeit;
+    namespace ast = jmespath::ast;
+
+    ResolveFunctionAction action;
+
+    SECTION("resolves built in functions")
+    {
+        ast::FunctionExpressionNode node1{
+            "abs",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}}}};
+        ast::FunctionExpressionNode node2{
+            "length",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}}}};
+
+        action(node1);
+        action(node2);
+
+        REQUIRE(node1.functionId.is_initialized());
+        REQUIRE(node2.functionId.is_initialized());
+        REQUIRE(*node1.functionId != *node2.functionId);
+    }
+
+    SECTION("proves the argument types of functions with comparable arrays")
+    {
+        ast::FunctionExpressionNode provenNode{
+            "sort",
+            {ast::ExpressionNode{
+                ast::LiteralNode{"[3, 1, 2]"}}}};
+        ast::FunctionExpressionNode uncheckedNode{
+            "sort",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}}}};
+
+        action(provenNode);
+        action(uncheckedNode);
+
+        REQUIRE(provenNode.argumentTypesProven);
+        REQUIRE_FALSE(uncheckedNode.argumentTypesProven);
+    }
+
+    SECTION("compiles constant pattern arguments")
+    {
+        ast::FunctionExpressionNode rawStringNode{
+            "matches",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}},
+            ast::ExpressionNode{
+                ast::RawStringNode{"^a+$"}}}};
+        ast::FunctionExpressionNode literalNode{
+            "regex_extract",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}},
+            ast::ExpressionNode{
+                ast::LiteralNode{"\"(a)b\""}}}};
+        ast::FunctionExpressionNode identifierNode{
+            "matches",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}},
+            ast::ExpressionNode{
+                ast::IdentifierNode{"pattern"}}}};
+
+        action(rawStringNode);
+        action(literalNode);
+        action(identifierNode);
+
+        REQUIRE(rawStringNode.pattern);
+        REQUIRE(std::regex_search("aaa", *rawStringNode.pattern));
+        REQUIRE(literalNode.pattern);
+        REQUIRE(literalNode.pattern->mark_count() == 1);
+        REQUIRE_FALSE(identifierNode.pattern);
+    }
+
+    SECTION("throws on invalid constant pattern arguments")
+    {
+        ast::FunctionExpressionNode node{
+            "matches",
+            {ast::ExpressionNode{
+                ast::IdentifierNode{"id"}},
+            ast::ExpressionNode{
+                ast::RawStringNode{"(a"}}}};
+
+        REQUIRE_THROWS_AS(action(node), InvalidValue);
+    }
+
+    SECTION("leaves unknown functions unresolved")
+    {
+        ast::FunctionExpressionNode node{"foo"};
+
+        action(node);
+
+        REQUIRE_FALSE(node.functionId.is_initialized());
+    }
+
+    SECTION("throws on invalid number of arguments")
+    {
+        ast::FunctionExpressionNode node{"abs"};
+
+        REQUIRE_THROWS_AS(action(node), InvalidFunctionArgumentArity);
+        REQUIRE_FALSE(node.functionId.is_initialized());
+    }
+}
@@ -83,4 +83,46 @@ TEST_CASE("Search function")
 
         REQUIRE(result == expectedResult);
     }
+
+    SECTION("evaluates expressions with shared subexpressions")
+    {
+        auto document = "{\"x\": {\"y\": {\"a\": 1, \"b\": [2]}}}"_json;
+
+        auto result = search("{a: x.y.a, b: x.y.b[0], c: x.y.c}", document);
+
+        REQUIRE(result == "{\"a\": 1, \"b\": 2, \"c\": null}"_json);
+    }
+
+    SECTION("doesn't evaluate shared subexpressions which are not reached")
+    {
+        auto result = search("{a: abs(@).x, b: abs(@).y}", Json{});
+
+        REQUIRE(result.is_null());
+    }
+}
+
+TEST_CASE("Dump function")
+{
+    using namespace jmespath;
+
+    SECTION("serializes search results like Json::dump")
+    {
+        auto document = "{\"foo\": [1, -2, 2.5, \"b\\\"ar\", null, true, "
+                        "{\"baz\": []}]}"_json;
+
+        auto result = search("foo", document);
+
+        REQUIRE(dump(result) == result.dump());
+    }
+
+    SECTION("appends to the output string")
+    {
+        String output{"["};
+
+        dump("1"_json, output);
+        output.push_back(',');
+        dump("\"a\""_json, output);
+
+        REQUIRE(output == "[1,\"a\"");
+    }
 }
@@ -0,0 +1,84 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include <jmespath/shared_map.h>
+#include <string>
+
+TEST_CASE("SharedContainer::unordered_map")
+{
+    using Map = SharedContainer::unordered_map<std::string, int>;
+    Map map{{"a", 1}, {"b", 2}};
+
+    SECTION("insert doesn't replace existing keys")
+    {
+        auto result = map.insert(std::make_pair(std::string{"a"}, 3));
+
+        REQUIRE_FALSE(result.second);
+        REQUIRE(result.first->second == 1);
+        REQUIRE(map.size() == 2);
+    }
+
+    SECTION("insert adds new keys")
+    {
+        auto result = map.insert(std::make_pair(std::string{"c"}, 3));
+
+        REQUIRE(result.second);
+        REQUIRE(map.size() == 3);
+        REQUIRE(map.at("c") == 3);
+    }
+
+    SECTION("copies share their items")
+    {
+        Map copy = map;
+        Map other{{"a", 1}, {"b", 2}};
+
+        REQUIRE(copy.same_items(map));
+        REQUIRE_FALSE(other.same_items(map));
+        REQUIRE(other == map);
+    }
+
+    SECTION("equality doesn't depend on the order of the keys")
+    {
+        Map reordered{{"b", 2}, {"a", 1}};
+        Map different{{"b", 1}, {"a", 2}};
+
+        REQUIRE(reordered == map);
+        REQUIRE(different != map);
+    }
+
+    SECTION("append adds the key-value pair to the end")
+    {
+        map.reserve(3);
+
+        map.append("c", 3);
+
+        REQUIRE(map.size() == 3);
+        REQUIRE(map.at("c") == 3);
+        REQUIRE(std::prev(map.end())->first == "c");
+    }
+}
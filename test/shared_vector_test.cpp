@@ -0,0 +1,165 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include <jmespath/shared_vector.h>
+
+TEST_CASE("SharedContainer::vector")
+{
+    using Vector = SharedContainer::vector<int>;
+    const Vector vector{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    SECTION("slice creates a view with the selected items")
+    {
+        Vector view = vector.slice(1, 3, 3);
+
+        REQUIRE(view.size() == 3);
+        REQUIRE(view == (Vector{1, 4, 7}));
+        REQUIRE(view[2] == 7);
+        REQUIRE(view.back() == 7);
+        REQUIRE(view.data() != vector.data());
+    }
+
+    SECTION("slice with negative step creates a reversed view")
+    {
+        Vector view = vector.slice(vector.size() - 1, -1, vector.size());
+
+        REQUIRE(view == (Vector{9, 8, 7, 6, 5, 4, 3, 2, 1, 0}));
+        REQUIRE(std::vector<int>(view.rbegin(), view.rend())
+                == std::vector<int>(vector.begin(), vector.end()));
+    }
+
+    SECTION("slice of a view selects the items of the view")
+    {
+        Vector view = vector.slice(9, -2, 5).slice(1, 2, 2);
+
+        REQUIRE(view == (Vector{7, 3}));
+    }
+
+    SECTION("empty slice creates an empty view")
+    {
+        Vector view = vector.slice(0, 1, 0);
+
+        REQUIRE(view.empty());
+        REQUIRE(view.begin() == view.end());
+    }
+
+    SECTION("modifying the structure of a view doesn't change the vector")
+    {
+        Vector view = vector.slice(vector.size() - 1, -1, 3);
+
+        view.push_back(100);
+        view.erase(view.begin());
+
+        REQUIRE(view == (Vector{8, 7, 100}));
+        REQUIRE(vector == (Vector{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}));
+    }
+
+    SECTION("assignment and swap preserve the view")
+    {
+        Vector view = vector.slice(2, 1, 2);
+        Vector other{42};
+
+        other = view;
+        REQUIRE(other == (Vector{2, 3}));
+        other.swap(view);
+        REQUIRE(view == (Vector{2, 3}));
+    }
+
+    SECTION("copies and views of the same items share their items")
+    {
+        Vector copy = vector;
+        Vector view1 = vector.slice(8, -2, 3);
+        Vector view2 = vector.slice(0, 1, 10).slice(8, -2, 3);
+        Vector view3 = vector.slice(9, -2, 3);
+        Vector other{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        REQUIRE(copy.same_items(vector));
+        REQUIRE(view1.same_items(view2));
+        REQUIRE_FALSE(view1.same_items(view3));
+        REQUIRE_FALSE(other.same_items(vector));
+        REQUIRE(other == vector);
+    }
+
+    SECTION("copies and views share the identifier of the buffer")
+    {
+        Vector copy = vector;
+        Vector view = vector.slice(1, 2, 3);
+        Vector other{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+        REQUIRE(copy.buffer_id() == vector.buffer_id());
+        REQUIRE(view.buffer_id() == vector.buffer_id());
+        REQUIRE(other.buffer_id() != vector.buffer_id());
+    }
+
+    SECTION("modifications are only counted after they're tracked")
+    {
+        Vector items{1, 2, 3};
+
+        items.push_back(4);
+        REQUIRE(items.modification_count() == 0);
+        items.track_modifications();
+        items.push_back(5);
+        REQUIRE(items.modification_count() == 1);
+    }
+
+    SECTION("accessing the items doesn't count as a modification")
+    {
+        Vector items{1, 2, 3};
+        items.track_modifications();
+
+        REQUIRE(items[0] == 1);
+        REQUIRE(*items.begin() == 1);
+        REQUIRE(items.modification_count() == 0);
+        items.resize(2);
+        items.insert(items.begin(), 0);
+        REQUIRE(items.modification_count() == 2);
+    }
+
+    SECTION("modifications through copies are counted for the shared buffer")
+    {
+        Vector items{1, 2, 3};
+        items.track_modifications();
+        Vector copy = items;
+
+        copy.erase(copy.begin());
+        copy.push_back(4);
+        REQUIRE(items.modification_count() == 2);
+        REQUIRE(items == (Vector{2, 3, 4}));
+    }
+
+    SECTION("materialized views don't modify the tracked buffer")
+    {
+        Vector items{1, 2, 3};
+        items.track_modifications();
+        Vector view = items.slice(0, 1, 2);
+
+        view.push_back(4);
+        REQUIRE(view.buffer_id() != items.buffer_id());
+        REQUIRE(items.modification_count() == 0);
+    }
+}
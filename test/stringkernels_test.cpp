@@ -0,0 +1,77 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/stringkernels.h"
+
+TEST_CASE("String kernels")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+
+    SECTION("counts the code points of UTF-8 strings")
+    {
+        REQUIRE(codePointCount("") == 0);
+        REQUIRE(codePointCount("abc") == 3);
+        REQUIRE(codePointCount("abcdefghijklmnopq") == 17);
+        REQUIRE(codePointCount("\xc3\xa9t\xc3\xa9") == 3);
+        // a two byte, a three byte and a four byte sequence crossing the
+        // boundaries of the words
+        REQUIRE(codePointCount("abcdefg\xc3\xa9" "abcde\xe2\x82\xac"
+                               "abcd\xf0\x9f\x98\x80" "x") == 20);
+    }
+
+    SECTION("finds substrings")
+    {
+        REQUIRE(containsString("abcdef", "cde"));
+        REQUIRE(containsString("abcdef", ""));
+        REQUIRE(containsString("", ""));
+        REQUIRE_FALSE(containsString("abcdef", "cdf"));
+        REQUIRE_FALSE(containsString("abc", "abcd"));
+    }
+
+    SECTION("checks prefixes and suffixes")
+    {
+        REQUIRE(startsWithString("abcdef", "abc"));
+        REQUIRE(startsWithString("abc", ""));
+        REQUIRE_FALSE(startsWithString("abc", "abcd"));
+        REQUIRE_FALSE(startsWithString("abc", "b"));
+        REQUIRE(endsWithString("abcdef", "def"));
+        REQUIRE(endsWithString("abc", ""));
+        REQUIRE_FALSE(endsWithString("abc", "zabc"));
+        REQUIRE_FALSE(endsWithString("abc", "b"));
+    }
+
+    SECTION("joins strings")
+    {
+        REQUIRE(joinStrings(Json::parse("[]"), ", ").empty());
+        REQUIRE(joinStrings(Json::parse("[\"a\"]"), ", ") == "a");
+        REQUIRE(joinStrings(Json::parse("[\"a\", \"\", \"bc\"]"), ", ")
+                == "a, , bc");
+        REQUIRE(joinStrings(Json::parse("[\"a\", \"b\"]"), "") == "ab");
+    }
+}
@@ -0,0 +1,136 @@
+/****************************************************************************
+**
+** Author: Róbert Márki <gsmiko@gmail.com>
+** Copyright (c) 2016 Róbert Márki
+**
+** This file is part of the jmespath.cpp project which is distributed under
+** the MIT License (MIT).
+**
+** Permission is hereby granted, free of charge, to any person obtaining a copy
+** of this software and associated documentation files (the "Software"), to
+** deal in the Software without restriction, including without limitation the
+** rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+** sell copies of the Software, and to permit persons to whom the Software is
+** furnished to do so, subject to the following conditions:
+**
+** The above copyright notice and this permission notice shall be included in
+** all copies or substantial portions of the Software.
+**
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+** FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+** DEALINGS IN THE SOFTWARE.
+**
+****************************************************************************/
+#include "fakeit.hpp"
+#include "src/interpreter/typeinferrer.h"
+#include "src/parser/parser.h"
+#include "src/parser/grammar.h"
+#include "src/ast/allnodes.h"
+
+TEST_CASE("TypeInferrer")
+{
+    using namespace jmespath;
+    using namespace jmespath::interpreter;
+    using jmespath::parser::Parser;
+    using jmespath::parser::Grammar;
+    using Type = InferredType;
+
+    Parser<Grammar> parser;
+    TypeInferrer inferrer;
+    auto infer = [&](const String& expression) {
+        return inferrer.infer(parser.parse(expression));
+    };
+
+    SECTION("infers the type of literals and raw strings")
+    {
+        REQUIRE(infer("'abc'").types == Type::String);
+        REQUIRE(infer("`true`").types == Type::Boolean);
+        REQUIRE(infer("`{\"a\": 1}`").types == Type::Object);
+        auto arrayType = infer("`[1, \"a\"]`");
+        REQUIRE(arrayType.types == Type::Array);
+        REQUIRE(arrayType.itemTypes == (Type::Number | Type::String));
+    }
+
+    SECTION("infers the type of comparisons and logic operators")
+    {
+        REQUIRE(infer("a == b").types == Type::Boolean);
+        REQUIRE(infer("a < b").types == (Type::Boolean | Type::Null));
+        REQUIRE(infer("!a").types == Type::Boolean);
+        REQUIRE(infer("`1` || 'a'").types == (Type::Number | Type::String));
+    }
+
+    SECTION("infers null for identifiers on non object values")
+    {
+        REQUIRE(infer("a").types == Type::Any);
+        REQUIRE(infer("'abc'.a").types == Type::Null);
+    }
+
+    SECTION("infers null for paths on values without their first step")
+    {
+        using Segments = std::vector<ast::PathNode::SegmentType>;
+        ast::ExpressionNode keyPath{ast::PathNode{
+                Segments{String{"a"}, std::int64_t{0}}}};
+        ast::ExpressionNode indexPath{ast::PathNode{
+                Segments{std::int64_t{0}, String{"a"}}}};
+        auto inferOn = [&](const String& context,
+                           const ast::ExpressionNode& path) {
+            return inferrer.infer(ast::ExpressionNode{
+                    ast::PipeExpressionNode{parser.parse(context),
+                                            path}}).types;
+        };
+
+        REQUIRE(inferrer.infer(keyPath).types == Type::Any);
+        REQUIRE(inferOn("'abc'", keyPath) == Type::Null);
+        REQUIRE(inferOn("`[1]`", indexPath) == Type::Any);
+        REQUIRE(inferOn("`{}`", indexPath) == Type::Null);
+    }
+
+    SECTION("infers the type of projections")
+    {
+        auto projectionType = infer("a[*].to_string(@)");
+        REQUIRE(projectionType.types == (Type::Array | Type::Null));
+        REQUIRE(projectionType.itemTypes == Type::String);
+        auto filterType = infer("`[1, 2]`[?@ > `1`]");
+        REQUIRE(filterType.types == Type::Array);
+        REQUIRE(filterType.itemTypes == Type::Number);
+    }
+
+    SECTION("infers the result type of built in functions")
+    {
+        REQUIRE(infer("length(a)").types == Type::Number);
+        auto keysType = infer("keys(@)");
+        REQUIRE(keysType.types == Type::Array);
+        REQUIRE(keysType.itemTypes == Type::String);
+        auto mapType = infer("map(&length(name), items)");
+        REQUIRE(mapType.types == Type::Array);
+        REQUIRE(mapType.itemTypes == Type::Number);
+        REQUIRE(infer("max(map(&length(name), items))").types
+                == (Type::Number | Type::Null));
+        REQUIRE(infer("not_null(a, 'b')").types == Type::Any);
+        REQUIRE(infer("group_by(items, &type)").types == Type::Object);
+        REQUIRE(infer("any(items, &active)").types == Type::Boolean);
+        REQUIRE(infer("count_if(items, &active)").types == Type::Number);
+        REQUIRE(infer("matches(name, 'a+')").types == Type::Boolean);
+        REQUIRE(infer("regex_extract(name, 'a+')").types
+                == (Type::String | Type::Null));
+        auto uniqueType = infer("unique(keys(@))");
+        REQUIRE(uniqueType.types == Type::Array);
+        REQUIRE(uniqueType.itemTypes == Type::String);
+        auto topType = infer("top_k(keys(@), `2`)");
+        REQUIRE(topType.types == Type::Array);
+        REQUIRE(topType.itemTypes == Type::String);
+    }
+
+    SECTION("proves comparable arrays")
+    {
+        REQUIRE(infer("sort(keys(@))").isComparableArray());
+        REQUIRE(infer("`[]`").isComparableArray());
+        REQUIRE_FALSE(infer("`[1, \"a\"]`").isComparableArray());
+        REQUIRE_FALSE(infer("values(@)").isComparableArray());
+        REQUIRE_FALSE(infer("a[*].b").isComparableArray());
+    }
+}